@@ -0,0 +1,119 @@
+/* bench_dictionary.c
+ *
+ * Microbenchmark for dictionary membership checks.
+ * Compares the original per-guess scan of textFiles/words.txt with the
+ * in-memory hash table from dictionary.c and prints lookups per second,
+ * then what it costs to map and index the file compared with using the
+ * built-in word list.
+ *
+ * Run from the WorDex directory:  make bench_dictionary && ./bench_dictionary
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include "../headerFiles/dictionary.h"
+#include "../headerFiles/data_dir.h"
+
+#define SCAN_LOOKUPS  2000       // file scans are slow, keep this small
+#define HASH_LOOKUPS  20000000   // hash probes are fast, run many
+#define FILE_LOADS    200        // loadDictionary calls to average
+
+/* now_seconds: monotonic wall clock in seconds */
+static double now_seconds(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec / 1e9;
+}
+
+/* scan_contains:
+ *   The pre-index validateGuess lookup: reopen the file and compare every
+ *   lowercased line against the guess.
+ */
+static int scan_contains(const char *guess) {
+    FILE *file = fopen(dataPath(DICTIONARY_FILE), "r");
+    char line[6];
+    int found = 0;
+
+    if (file == NULL) {
+        return 0;
+    }
+
+    while (fgets(line, sizeof(line), file) != NULL) {
+        int i;
+
+        line[strcspn(line, "\n")] = '\0';
+        for (i = 0; line[i] != '\0'; i++) {
+            line[i] = (char) tolower((unsigned char) line[i]);
+        }
+        if (strcmp(line, guess) == 0) {
+            found = 1;
+            break;
+        }
+    }
+
+    fclose(file);
+    return found;
+}
+
+int main(void) {
+    const Dictionary *dict = getDictionary();
+    char word[6];
+    double start, scanRate, hashRate, loadSeconds;
+    Dictionary loaded;
+    long hits = 0;
+    long i;
+
+    if (dict == NULL || dict->count == 0) {
+        fprintf(stderr, "Error: could not load %s (run from the WorDex directory)\n", dataPath(DICTIONARY_FILE));
+        return 1;
+    }
+
+    // Half of the probes are real words, half are misses (worst case for a scan)
+    start = now_seconds();
+    for (i = 0; i < SCAN_LOOKUPS; i++) {
+        dictionaryWordAt(dict, (int) ((i * 7919) % dict->count), word);
+        if (i % 2 == 1) {
+            word[0] = 'q';
+            word[1] = 'x';
+        }
+        hits += scan_contains(word);
+    }
+    scanRate = SCAN_LOOKUPS / (now_seconds() - start);
+
+    start = now_seconds();
+    for (i = 0; i < HASH_LOOKUPS; i++) {
+        uint32_t packed = dictionaryPackedAt(dict, (int) ((i * 7919) % dict->count));
+
+        if (i % 2 == 1) {
+            packed = (packed & ~(uint32_t) 0x3ff) | (17u | (24u << LETTER_BITS));
+        }
+        hits += dictionaryContains(dict, packed);
+    }
+    hashRate = HASH_LOOKUPS / (now_seconds() - start);
+
+    start = now_seconds();
+    for (i = 0; i < FILE_LOADS; i++) {
+        if (loadDictionary(dataPath(DICTIONARY_FILE), &loaded) != 0) {
+            fprintf(stderr, "Error: could not load %s (run from the WorDex directory)\n", dataPath(DICTIONARY_FILE));
+            return 1;
+        }
+        freeDictionary(&loaded);
+    }
+    loadSeconds = (now_seconds() - start) / FILE_LOADS;
+
+    printf("words indexed:      %d\n", dict->count);
+    printf("file scan:          %12.0f lookups/sec\n", scanRate);
+    printf("hashed dictionary:  %12.0f lookups/sec\n", hashRate);
+    printf("speedup:            %12.1fx\n", hashRate / scanRate);
+    printf("file map + index:   %12.1f us per start (built-in list: none)\n", loadSeconds * 1e6);
+    printf("(hits: %ld)\n", hits);
+
+    return 0;
+}
@@ -0,0 +1,175 @@
+/* bench_engine.c
+ *
+ * Throughput of libwordex with many games in one process.
+ * Plays N games on each of 1..T threads, every thread with its own games
+ * and random state, guessing a random word that still fits the feedback,
+ * and saves every result through one context whose data directory is a
+ * scratch copy under /tmp (set with WxConfig, no chdir). Prints games/sec
+ * per thread count, then checks the leaderboard counted every game.
+ *
+ * Run from the WorDex directory:
+ *   make bench_engine && ./bench_engine [games per thread] [max threads]
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "../headerFiles/libwordex.h"
+#include "../headerFiles/random.h"
+
+#define BENCH_USER "bench"
+
+/* Worker: one thread's share of a run */
+typedef struct {
+    WxContext *ctx;
+    int        games;
+    uint64_t   rng;
+    long       wins;
+    int        failed;
+} Worker;
+
+/* now_seconds: monotonic wall clock in seconds */
+static double now_seconds(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec / 1e9;
+}
+
+/* play_games: the thread body; each game is new_game, guesses until over, save */
+static void *play_games(void *arg) {
+    Worker *w = arg;
+    const Dictionary *dict = getDictionary();
+    int *candidates = malloc(sizeof(int) * (size_t) dict->count);
+    int g;
+
+    if (candidates == NULL) {
+        w->failed = 1;
+        return NULL;
+    }
+
+    for (g = 0; g < w->games && !w->failed; g++) {
+        GameState game;
+        uint8_t pattern;
+
+        wxNewGame(w->ctx, &w->rng, &game);
+        while (!gameStateOver(&game)) {
+            int count = filterCandidates(dict, &game, candidates);
+            char guess[6];
+
+            dictionaryWordAt(dict, candidates[nextRandom(&w->rng) % (uint64_t) count], guess);
+            if (wxGuess(&game, guess, &pattern) != WX_OK) {
+                w->failed = 1;
+                break;
+            }
+        }
+        w->wins = w->wins + game.won;
+        if (wxSaveGame(w->ctx, BENCH_USER, &game, NULL, NULL) != WX_OK) {
+            w->failed = 1;
+        }
+    }
+
+    free(candidates);
+    return NULL;
+}
+
+/* make_scratch: an empty data directory under /tmp */
+static int make_scratch(char *dir) {
+    char path[512];
+    const char *files[] = {"history.txt", "stats.txt", "userprofiles.txt"};
+    size_t i;
+
+    strcpy(dir, "/tmp/wordex-engine-XXXXXX");
+    if (mkdtemp(dir) == NULL) {
+        return 1;
+    }
+    for (i = 0; i < sizeof(files) / sizeof(files[0]); i++) {
+        FILE *fp;
+
+        snprintf(path, sizeof(path), "%s/%s", dir, files[i]);
+        fp = fopen(path, "w");
+        if (fp == NULL) {
+            return 1;
+        }
+        fclose(fp);
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    int games = (argc > 1) ? atoi(argv[1]) : 2000;
+    int maxThreads = (argc > 2) ? atoi(argv[2]) : 4;
+    struct LeaderboardEntry *entries;
+    char scratch[64];
+    WxConfig config = {NULL, NULL};
+    WxContext *ctx;
+    long total = 0;
+    int threads;
+
+    if (games < 1 || maxThreads < 1) {
+        fprintf(stderr, "Usage: ./bench_engine [games per thread] [max threads]\n");
+        return 1;
+    }
+    if (make_scratch(scratch) != 0) {
+        fprintf(stderr, "Error: could not create a scratch data directory\n");
+        return 1;
+    }
+
+    config.dataDir = scratch;
+    ctx = wxOpen(&config);
+    if (ctx == NULL) {
+        fprintf(stderr, "Error: could not open the engine on %s\n", scratch);
+        return 1;
+    }
+
+    printf("libwordex: %d games per thread, data in %s\n\n", games, scratch);
+    printf("%8s %10s %12s %8s\n", "threads", "games", "games/sec", "wins");
+
+    for (threads = 1; threads <= maxThreads; threads = threads * 2) {
+        pthread_t ids[64];
+        Worker workers[64];
+        double start, elapsed;
+        long wins = 0;
+        int i, failed = 0;
+
+        if (threads > 64) {
+            break;
+        }
+        start = now_seconds();
+        for (i = 0; i < threads; i++) {
+            memset(&workers[i], 0, sizeof(Worker));
+            workers[i].ctx = ctx;
+            workers[i].games = games;
+            workers[i].rng = wxSeed();
+            pthread_create(&ids[i], NULL, play_games, &workers[i]);
+        }
+        for (i = 0; i < threads; i++) {
+            pthread_join(ids[i], NULL);
+            wins = wins + workers[i].wins;
+            failed = failed | workers[i].failed;
+        }
+        elapsed = now_seconds() - start;
+
+        if (failed) {
+            fprintf(stderr, "Error: a game could not be played or saved\n");
+            return 1;
+        }
+        total = total + (long) threads * games;
+        printf("%8d %10ld %12.0f %7.1f%%\n", threads, (long) threads * games,
+               (double) threads * games / elapsed, 100.0 * (double) wins / ((double) threads * games));
+    }
+
+    if (wxLeaderboard(ctx, 1, &entries) != 1 || entries[0].gamesPlayed != total) {
+        fprintf(stderr, "Error: the leaderboard does not count all %ld games\n", total);
+        return 1;
+    }
+    printf("\nLeaderboard counts all %ld games for %s\n", total, BENCH_USER);
+    free(entries);
+    wxClose(ctx);
+    return 0;
+}
@@ -0,0 +1,368 @@
+/* bench_parse.c
+ *
+ * Records/sec of the shared record tokenizer against the scanf readers
+ * it replaced.
+ * Writes a synthetic history.txt of N games (10M by default) and a
+ * stats.txt of N/10 padded records under /tmp, then parses each file
+ * every way and checks they agree:
+ *   - fscanf straight from the FILE
+ *   - getline + sscanf, as the history, leaderboard and statistics
+ *     modules used to
+ *   - the tokenizer over 1 MiB read() blocks
+ *   - the tokenizer over an mmap of the whole file
+ *
+ * Run from the WorDex directory:
+ *   make bench_parse && ./bench_parse [games]
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "../headerFiles/record_parser.h"
+#include "../headerFiles/statistics.h"
+#include "../headerFiles/dictionary.h"
+#include "../headerFiles/random.h"
+
+#define BENCH_PLAYERS 5000
+#define READ_BLOCK    (1 << 20)
+
+/* Tally: what a pass saw, to check every reader agrees */
+typedef struct {
+    long     records;
+    uint64_t checksum;
+} Tally;
+
+/* Reader: one way of parsing a whole file */
+typedef struct {
+    const char *name;
+    int (*run)(const char *path, Tally *tally);
+} Reader;
+
+/* now_seconds: monotonic wall clock in seconds */
+static double now_seconds(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec / 1e9;
+}
+
+/* count_game / count_stats: fold one parsed record into a tally */
+static void count_game(Tally *t, const struct GameResult *r) {
+    t->records++;
+    t->checksum = t->checksum * 31 + (uint64_t) r->guesses * 7 + (uint64_t) r->won +
+                  (unsigned char) r->username[strlen(r->username) - 1] + (unsigned char) r->word[4] +
+                  (unsigned char) r->timestamp[15];
+}
+
+static void count_stats(Tally *t, const Stats *s) {
+    t->records++;
+    t->checksum = t->checksum * 31 + (uint64_t) s->wins + (uint64_t) s->maxStreak +
+                  (uint64_t) s->lastPlayed + (uint64_t) s->winsByGuess[5] +
+                  (unsigned char) s->username[strlen(s->username) - 1];
+}
+
+/* parse_stats_line: the 14 stats fields with the tokenizer, as statistics.c reads them */
+static int parse_stats_line(const char *text, size_t length, Stats *s) {
+    RecordCursor cursor;
+    int i;
+
+    recordCursorInit(&cursor, text, length);
+    if (!recordNextString(&cursor, s->username, MAX_USERNAME) ||
+        !recordNextInt(&cursor, &s->wins) || !recordNextInt(&cursor, &s->losses) ||
+        !recordNextInt(&cursor, &s->gamesPlayed) || !recordNextInt(&cursor, &s->currentStreak) ||
+        !recordNextInt(&cursor, &s->maxStreak) || !recordNextInt(&cursor, &s->totalGuesses) ||
+        !recordNextLong(&cursor, &s->lastPlayed)) {
+        return 0;
+    }
+    for (i = 0; i < 6; i++) {
+        if (!recordNextInt(&cursor, &s->winsByGuess[i])) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* Line handlers for the tokenizer readers: a history game or a stats record */
+static void game_line(const char *text, size_t length, Tally *t) {
+    struct GameResult r;
+
+    if (recordParseGame(text, length, &r)) {
+        count_game(t, &r);
+    }
+}
+
+static void stats_line(const char *text, size_t length, Tally *t) {
+    Stats s;
+
+    if (parse_stats_line(text, length, &s)) {
+        count_stats(t, &s);
+    }
+}
+
+/* each_line: calls 'line' for every '\n'-terminated line in [text, text + length); returns the bytes used */
+static size_t each_line(const char *text, size_t length, Tally *t,
+                        void (*line)(const char *, size_t, Tally *)) {
+    const char *p = text;
+    const char *end = text + length;
+    const char *newline;
+
+    while (p < end && (newline = memchr(p, '\n', (size_t) (end - p))) != NULL) {
+        line(p, (size_t) (newline - p), t);
+        p = newline + 1;
+    }
+    return (size_t) (p - text);
+}
+
+/* read_blocks: the tokenizer over READ_BLOCK reads, carrying the unfinished line */
+static int read_blocks(const char *path, Tally *t, void (*line)(const char *, size_t, Tally *)) {
+    char *buffer = malloc(READ_BLOCK);
+    size_t held = 0;
+    ssize_t got;
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0 || buffer == NULL) {
+        free(buffer);
+        return 1;
+    }
+    while ((got = read(fd, buffer + held, READ_BLOCK - held)) > 0) {
+        size_t used;
+
+        held = held + (size_t) got;
+        used = each_line(buffer, held, t, line);
+        memmove(buffer, buffer + used, held - used);
+        held = held - used;
+    }
+    if (held > 0) {
+        line(buffer, held, t);
+    }
+    close(fd);
+    free(buffer);
+    return got < 0;
+}
+
+/* map_file: the tokenizer over a read-only mapping of the whole file */
+static int map_file(const char *path, Tally *t, void (*line)(const char *, size_t, Tally *)) {
+    struct stat st;
+    const char *map;
+    size_t used;
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0) {
+        return 1;
+    }
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        return 1;
+    }
+    map = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return 1;
+    }
+    madvise((void *) map, (size_t) st.st_size, MADV_SEQUENTIAL);
+
+    used = each_line(map, (size_t) st.st_size, t, line);
+    if (used < (size_t) st.st_size) {
+        line(map + used, (size_t) st.st_size - used, t);
+    }
+    munmap((void *) map, (size_t) st.st_size);
+    return 0;
+}
+
+/* The history readers */
+static int games_fscanf(const char *path, Tally *t) {
+    FILE *fp = fopen(path, "r");
+    struct GameResult r;
+
+    if (fp == NULL) {
+        return 1;
+    }
+    while (fscanf(fp, "%31s %5s %d %d %19s", r.username, r.word, &r.guesses, &r.won, r.timestamp) == 5) {
+        count_game(t, &r);
+    }
+    fclose(fp);
+    return 0;
+}
+
+static int games_sscanf(const char *path, Tally *t) {
+    FILE *fp = fopen(path, "r");
+    char *line = NULL;
+    size_t size = 0;
+    struct GameResult r;
+
+    if (fp == NULL) {
+        return 1;
+    }
+    while (getline(&line, &size, fp) > 0) {
+        if (sscanf(line, "%31s %5s %d %d %19s", r.username, r.word, &r.guesses, &r.won, r.timestamp) == 5) {
+            count_game(t, &r);
+        }
+    }
+    free(line);
+    fclose(fp);
+    return 0;
+}
+
+static int games_read(const char *path, Tally *t) {
+    return read_blocks(path, t, game_line);
+}
+
+static int games_mmap(const char *path, Tally *t) {
+    return map_file(path, t, game_line);
+}
+
+/* The stats readers */
+static int stats_fscanf(const char *path, Tally *t) {
+    FILE *fp = fopen(path, "r");
+    Stats s;
+
+    if (fp == NULL) {
+        return 1;
+    }
+    while (fscanf(fp, "%49s %d %d %d %d %d %d %ld %d %d %d %d %d %d", s.username, &s.wins, &s.losses,
+                  &s.gamesPlayed, &s.currentStreak, &s.maxStreak, &s.totalGuesses, &s.lastPlayed,
+                  &s.winsByGuess[0], &s.winsByGuess[1], &s.winsByGuess[2], &s.winsByGuess[3],
+                  &s.winsByGuess[4], &s.winsByGuess[5]) == 14) {
+        count_stats(t, &s);
+    }
+    fclose(fp);
+    return 0;
+}
+
+static int stats_sscanf(const char *path, Tally *t) {
+    FILE *fp = fopen(path, "r");
+    char *line = NULL;
+    size_t size = 0;
+    Stats s;
+
+    if (fp == NULL) {
+        return 1;
+    }
+    while (getline(&line, &size, fp) > 0) {
+        if (sscanf(line, "%49s %d %d %d %d %d %d %ld %d %d %d %d %d %d", s.username, &s.wins, &s.losses,
+                   &s.gamesPlayed, &s.currentStreak, &s.maxStreak, &s.totalGuesses, &s.lastPlayed,
+                   &s.winsByGuess[0], &s.winsByGuess[1], &s.winsByGuess[2], &s.winsByGuess[3],
+                   &s.winsByGuess[4], &s.winsByGuess[5]) == 14) {
+            count_stats(t, &s);
+        }
+    }
+    free(line);
+    fclose(fp);
+    return 0;
+}
+
+static int stats_read(const char *path, Tally *t) {
+    return read_blocks(path, t, stats_line);
+}
+
+static int stats_mmap(const char *path, Tally *t) {
+    return map_file(path, t, stats_line);
+}
+
+/* write_files: N random history lines and N/10 padded stats records; returns 0 or 1 */
+static int write_files(const char *historyPath, const char *statsPath, long games) {
+    const Dictionary *dict = getDictionary();
+    uint64_t rng = 0x2545F4914F6CDD1Dull;
+    FILE *history = fopen(historyPath, "w");
+    FILE *stats = fopen(statsPath, "w");
+    long g;
+
+    if (history == NULL || stats == NULL || dict == NULL || dict->count == 0) {
+        return 1;
+    }
+    for (g = 0; g < games; g++) {
+        uint64_t r = nextRandom(&rng);
+        char word[6];
+
+        dictionaryWordAt(dict, (int) ((r >> 8) % (uint64_t) dict->count), word);
+        fprintf(history, "player%d %s %d %d 2026-%02d-%02d_%02d:%02d\n",
+                (int) ((r >> 24) % BENCH_PLAYERS), word, (int) (r % 6) + 1, ((r >> 40) % 4) != 0,
+                (int) ((r >> 44) % 12) + 1, (int) ((r >> 48) % 28) + 1,
+                (int) ((r >> 53) % 24), (int) ((r >> 58) % 60));
+    }
+    for (g = 0; g < games / 10; g++) {
+        uint64_t r = nextRandom(&rng);
+        char name[32];
+
+        snprintf(name, sizeof(name), "player%ld", g);
+        fprintf(stats, "%-49s %10d %10d %10d %10d %10d %10d %20ld %10d %10d %10d %10d %10d %10d\n",
+                name, (int) (r % 500), (int) ((r >> 9) % 200), (int) ((r >> 17) % 700),
+                (int) ((r >> 27) % 9), (int) ((r >> 31) % 30), (int) ((r >> 36) % 3000),
+                1760000000L + (long) ((r >> 20) % 10000000), (int) ((r >> 50) % 9),
+                (int) ((r >> 40) % 50), (int) ((r >> 44) % 90), (int) ((r >> 30) % 99),
+                (int) ((r >> 33) % 70), (int) ((r >> 38) % 40));
+    }
+    return (fclose(history) != 0) | (fclose(stats) != 0);
+}
+
+/* run_readers: times every reader on one file and checks they agree; returns 0 or 1 */
+static int run_readers(const char *title, const char *path, const Reader *readers, int count) {
+    Tally first;
+    int i;
+
+    printf("%s\n%-22s %12s %14s\n", title, "reader", "records", "records/sec");
+    for (i = 0; i < count; i++) {
+        Tally tally = {0, 0};
+        double start = now_seconds();
+        double elapsed;
+
+        if (readers[i].run(path, &tally) != 0) {
+            fprintf(stderr, "Error: %s could not read %s\n", readers[i].name, path);
+            return 1;
+        }
+        elapsed = now_seconds() - start;
+        if (i == 0) {
+            first = tally;
+        } else if (tally.records != first.records || tally.checksum != first.checksum) {
+            fprintf(stderr, "Error: %s read %ld records differently\n", readers[i].name, tally.records);
+            return 1;
+        }
+        printf("%-22s %12ld %14.0f\n", readers[i].name, tally.records, (double) tally.records / elapsed);
+    }
+    printf("\n");
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    long games = (argc > 1) ? atol(argv[1]) : 10000000;
+    const Reader gameReaders[] = {
+        {"fscanf", games_fscanf}, {"getline + sscanf", games_sscanf},
+        {"tokenizer, read()", games_read}, {"tokenizer, mmap", games_mmap}
+    };
+    const Reader statsReaders[] = {
+        {"fscanf", stats_fscanf}, {"getline + sscanf", stats_sscanf},
+        {"tokenizer, read()", stats_read}, {"tokenizer, mmap", stats_mmap}
+    };
+    char historyPath[] = "/tmp/wordex-parse-XXXXXX";
+    char statsPath[64];
+    int fd, failed;
+
+    if (games < 10) {
+        fprintf(stderr, "Usage: ./bench_parse [games, at least 10]\n");
+        return 1;
+    }
+    fd = mkstemp(historyPath);
+    snprintf(statsPath, sizeof(statsPath), "%s.stats", historyPath);
+    if (fd < 0 || write_files(historyPath, statsPath, games) != 0) {
+        fprintf(stderr, "Error: could not write the test files under /tmp\n");
+        return 1;
+    }
+    close(fd);
+
+    failed = run_readers("history.txt lines", historyPath, gameReaders, 4) ||
+             run_readers("stats.txt records", statsPath, statsReaders, 4);
+    unlink(historyPath);
+    unlink(statsPath);
+    if (!failed) {
+        printf("Every reader parsed the same records\n");
+    }
+    return failed;
+}
@@ -0,0 +1,231 @@
+/* bench_render.c
+ *
+ * Benchmark for drawing the game board.
+ * Plays the same scripted games three ways into a pseudo-terminal and
+ * prints frames per second and bytes written per turn for each:
+ *   - legacy:  the original board, system("clear") and a printf per piece
+ *   - full:    the frame renderer sending whole frames (RENDER_PLAIN)
+ *   - diff:    the frame renderer sending only changed cells (RENDER_ANSI)
+ *
+ * The pseudo-terminal is 120x50, so the diff renderer keeps its frame in
+ * place, and its output is drained after every frame, like a terminal
+ * would. Bytes are counted on the terminal side.
+ *
+ * Run from the WorDex directory:  make bench_render && ./bench_render [GAMES]
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#define _XOPEN_SOURCE 600   // posix_openpt
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include "../headerFiles/render.h"
+#include "../headerFiles/data_dir.h"
+#include "../headerFiles/random.h"
+
+#define DEFAULT_GAMES  200
+#define LEGACY_GAMES   20     // every legacy frame forks a shell; keep this small
+
+/* now_seconds: monotonic wall clock in seconds */
+static double now_seconds(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec / 1e9;
+}
+
+/* drain: reads everything the terminal has received; returns the byte count */
+static long drain(int master) {
+    char buffer[65536];
+    long total = 0;
+    ssize_t got;
+
+    while ((got = read(master, buffer, sizeof(buffer))) > 0) {
+        total = total + got;
+    }
+    return total;
+}
+
+/*
+ * legacy_interface:
+ *   The board as interface() drew it before the frame renderer.
+ */
+
+static void legacy_interface(const GameState *game) {
+    char letters[] = "qwertyuiopasdfghjklzxcvbnm";
+
+    if (system("clear") != 0) {
+        // clear failing only leaves the old frame on screen
+    }
+
+    printf("\n╔═══════════════════════════════════════════════╗\n");
+    printf("║                    WORDEX                     ║\n");
+    printf("╠═══════════════════════════════════════════════╣\n");
+
+    for (int row = 0; row < 6; row++) {
+        printf("║       ");
+
+        if (row < game->guessCount) {
+            for (int col = 0; col < 5; col++) {
+                char currentLetter = game->guessWords[row][col];
+                int digit = patternDigit(game->patterns[row], col);
+
+                if (digit == DIGIT_GREEN) {
+                    printf("\033[32m%c\033[0m       ", toupper(currentLetter));
+                } else if (digit == DIGIT_YELLOW) {
+                    printf("\033[33m%c\033[0m       ", toupper(currentLetter));
+                } else {
+                    printf("\033[90m%c\033[0m       ", toupper(currentLetter));
+                }
+            }
+        } else {
+            printf("_       _       _       _       _       ");
+        }
+
+        printf("║\n");
+    }
+
+    printf("╚═══════════════════════════════════════════════╝\n\n");
+
+    printf("\n╔═══════════════════════════════════════════════╗\n");
+    printf("║              KEYBOARD STATUS                  ║\n");
+    printf("╠═══════════════════════════════════════════════╣\n");
+
+    for (int i = 0; i < 26; i++) {
+        uint32_t bit = letterBit(letters[i]);
+
+        if (letters[i] == 'q') {
+            printf("║    ");
+        } else if (letters[i] == 'a') {
+            printf("║      ");
+        } else if (letters[i] == 'z') {
+            printf("║         ");
+        }
+
+        if (game->keysGreen & bit) {
+            printf(" \033[32m%c\033[0m  ", toupper(letters[i]));
+        } else if (game->keysYellow & bit) {
+            printf(" \033[33m%c\033[0m  ", toupper(letters[i]));
+        } else if (game->keysGray & bit) {
+            printf(" \033[90m%c\033[0m  ", toupper(letters[i]));
+        } else {
+            printf(" %c  ", toupper(letters[i]));
+        }
+
+        if (letters[i] == 'p') {
+            printf("   ║\n");
+        } else if (letters[i] == 'l') {
+            printf("     ║\n");
+        } else if (letters[i] == 'm') {
+            printf("          ║\n");
+        }
+    }
+
+    printf("╚═══════════════════════════════════════════════╝\n\n");
+    fflush(stdout);
+}
+
+/*
+ * run_mode:
+ *   Plays 'games' scripted games, drawing an empty board and then one
+ *   frame per guess. mode < 0 is the legacy board.
+ */
+
+static void run_mode(const char *name, int mode, int games, int master, FILE *report) {
+    const Dictionary *dict = getDictionary();
+    Renderer *r = malloc(sizeof(Renderer));
+    uint64_t rng = 0x9E3779B97F4A7C15ull;
+    long frames = 0, bytes = 0;
+    double start, seconds;
+    int g;
+
+    if (r == NULL) {
+        return;
+    }
+    if (mode >= 0) {
+        rendererInit(r, STDOUT_FILENO, mode);
+    }
+
+    start = now_seconds();
+    for (g = 0; g < games; g++) {
+        GameState game;
+        char word[6];
+
+        dictionaryWordAt(dict, (int) (nextRandom(&rng) % (uint64_t) dict->count), word);
+        gameStateInit(&game, word);
+
+        if (mode < 0) {
+            legacy_interface(&game);
+        } else {
+            rendererInvalidate(r);
+            rendererDraw(r, &game);
+        }
+        bytes += drain(master);
+        frames++;
+
+        while (!gameStateOver(&game)) {
+            dictionaryWordAt(dict, (int) (nextRandom(&rng) % (uint64_t) dict->count), word);
+            gameStateSubmit(&game, word);
+            if (mode < 0) {
+                legacy_interface(&game);
+            } else {
+                rendererDraw(r, &game);
+            }
+            bytes += drain(master);
+            frames++;
+        }
+    }
+    seconds = now_seconds() - start;
+
+    fprintf(report, "%-8s %8d games %8ld frames %12.0f frames/sec %10.0f bytes/turn\n",
+            name, games, frames, frames / seconds, (double) bytes / frames);
+    free(r);
+}
+
+int main(int argc, char *argv[]) {
+    struct winsize size;
+    FILE *report;
+    int games = DEFAULT_GAMES;
+    int master, slave;
+
+    if (argc > 1 && (sscanf(argv[1], "%d", &games) != 1 || games < 1)) {
+        fprintf(stderr, "Usage: %s [GAMES]\n", argv[0]);
+        return 1;
+    }
+    if (getDictionary() == NULL || getDictionary()->count == 0) {
+        fprintf(stderr, "Error: could not load %s (run from the WorDex directory)\n", dataPath(DICTIONARY_FILE));
+        return 1;
+    }
+
+    master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0 ||
+        (slave = open(ptsname(master), O_RDWR | O_NOCTTY)) < 0) {
+        fprintf(stderr, "Error: cannot open a pseudo-terminal\n");
+        return 1;
+    }
+    fcntl(master, F_SETFL, O_NONBLOCK);
+    memset(&size, 0, sizeof(size));
+    size.ws_row = 50;
+    size.ws_col = 120;
+    ioctl(slave, TIOCSWINSZ, &size);
+
+    // The report goes to the real stdout; the boards go to the terminal
+    report = fdopen(dup(STDOUT_FILENO), "w");
+    fflush(stdout);
+    dup2(slave, STDOUT_FILENO);
+    setenv("TERM", "xterm", 0);
+
+    run_mode("legacy", -1, games < LEGACY_GAMES ? games : LEGACY_GAMES, master, report);
+    run_mode("full", RENDER_PLAIN, games, master, report);
+    run_mode("diff", RENDER_ANSI, games, master, report);
+
+    fclose(report);
+    return 0;
+}
@@ -0,0 +1,226 @@
+/* bench_scan.c
+ *
+ * Throughput of the parallel history scanner.
+ * Writes a synthetic history.txt of N games (random players, words from
+ * the built-in list) to /tmp, then builds per-word analytics from it
+ * (games, wins and guesses for every answer) with historyScanText on 1, 2,
+ * 4, ... threads. Prints lines/sec and MB/sec per thread count and checks
+ * every run agrees with the single-threaded one.
+ *
+ * Run from the WorDex directory:
+ *   make bench_scan && ./bench_scan [games] [max threads]
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "../headerFiles/history_scan.h"
+#include "../headerFiles/dictionary.h"
+#include "../headerFiles/random.h"
+
+#define BENCH_PLAYERS 5000
+
+/* Slots in a word table; more than twice the words in the built-in list */
+#define WORD_SLOTS    (1 << 14)
+
+/* WordStats: one answer's totals */
+typedef struct {
+    uint32_t packed;      // packWord of the answer, 0 for an empty slot
+    long     games;
+    long     wins;
+    long     guesses;
+} WordStats;
+
+/* WordTable: per-word analytics, open addressing on the packed word */
+typedef struct {
+    WordStats slots[WORD_SLOTS];
+    int       count;
+} WordTable;
+
+/* now_seconds: monotonic wall clock in seconds */
+static double now_seconds(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec / 1e9;
+}
+
+/* word_slot: the slot for 'packed', claiming an empty one; NULL when the table is half full */
+static WordStats *word_slot(WordTable *t, uint32_t packed) {
+    uint32_t i = (packed * 2654435761u) & (WORD_SLOTS - 1);
+
+    while (t->slots[i].packed != 0 && t->slots[i].packed != packed) {
+        i = (i + 1) & (WORD_SLOTS - 1);
+    }
+    if (t->slots[i].packed == 0) {
+        if ((t->count + 1) * 2 > WORD_SLOTS) {
+            return NULL;
+        }
+        t->slots[i].packed = packed;
+        t->count++;
+    }
+    return &t->slots[i];
+}
+
+/* words_create / words_add / words_merge / words_destroy: the scanner's aggregate */
+static void *words_create(void *arg) {
+    (void) arg;
+    return calloc(1, sizeof(WordTable));
+}
+
+static int words_add(void *aggregate, const struct GameResult *r, void *arg) {
+    uint32_t packed = packWord(r->word);
+    WordStats *w;
+
+    (void) arg;
+    if (packed == 0) {
+        return 0;    // not a 5-letter word
+    }
+    w = word_slot(aggregate, packed);
+    if (w == NULL) {
+        return 1;
+    }
+    w->games++;
+    w->wins += r->won;
+    w->guesses += r->guesses;
+    return 0;
+}
+
+static int words_merge(void *into, void *later, void *arg) {
+    const WordTable *from = later;
+    int i;
+
+    (void) arg;
+    for (i = 0; i < WORD_SLOTS; i++) {
+        if (from->slots[i].packed != 0) {
+            WordStats *w = word_slot(into, from->slots[i].packed);
+
+            if (w == NULL) {
+                return 1;
+            }
+            w->games += from->slots[i].games;
+            w->wins += from->slots[i].wins;
+            w->guesses += from->slots[i].guesses;
+        }
+    }
+    return 0;
+}
+
+static void words_destroy(void *aggregate, void *arg) {
+    (void) arg;
+    free(aggregate);
+}
+
+/* summarize: games counted, a checksum of every word's totals and the hardest word (lowest win rate) */
+static void summarize(const WordTable *t, long *games, uint64_t *checksum, char *hardest) {
+    const WordStats *worst = NULL;
+    int i;
+
+    *games = 0;
+    *checksum = 0;
+    for (i = 0; i < WORD_SLOTS; i++) {
+        const WordStats *w = &t->slots[i];
+
+        if (w->packed == 0) {
+            continue;
+        }
+        *games += w->games;
+        *checksum += (uint64_t) w->packed * 0x9E3779B97F4A7C15ull ^
+                     ((uint64_t) w->games << 40 | (uint64_t) w->wins << 20 | (uint64_t) w->guesses);
+        if (worst == NULL || w->wins * worst->games < worst->wins * w->games) {
+            worst = w;
+        }
+    }
+
+    strcpy(hardest, "-");
+    if (worst != NULL) {
+        unpackWord(worst->packed, hardest);
+    }
+}
+
+/* write_history: N random games as history.txt lines; returns 0 or 1 */
+static int write_history(const char *path, long games) {
+    const Dictionary *dict = getDictionary();
+    uint64_t rng = 0x2545F4914F6CDD1Dull;
+    FILE *fp = fopen(path, "w");
+    long g;
+
+    if (fp == NULL || dict == NULL || dict->count == 0) {
+        return 1;
+    }
+    for (g = 0; g < games; g++) {
+        uint64_t r = nextRandom(&rng);
+        char word[6];
+        int guesses = (int) (r % 6) + 1;
+
+        dictionaryWordAt(dict, (int) ((r >> 8) % (uint64_t) dict->count), word);
+        fprintf(fp, "player%d %s %d %d 2026-%02d-%02d_%02d:%02d\n",
+                (int) ((r >> 24) % BENCH_PLAYERS), word, guesses, ((r >> 40) % 4) != 0,
+                (int) ((r >> 44) % 12) + 1, (int) ((r >> 48) % 28) + 1,
+                (int) ((r >> 53) % 24), (int) ((r >> 58) % 60));
+    }
+    return fclose(fp) != 0;
+}
+
+int main(int argc, char *argv[]) {
+    long games = (argc > 1) ? atol(argv[1]) : 2000000;
+    int maxThreads = (argc > 2) ? atoi(argv[2]) : historyScanThreads();
+    HistoryScanOps ops = {words_create, words_add, words_merge, words_destroy, NULL};
+    char path[] = "/tmp/wordex-scan-XXXXXX";
+    uint64_t expected = 0;
+    double megabytes;
+    off_t size;
+    int threads, fd;
+
+    if (games < 1 || maxThreads < 1) {
+        fprintf(stderr, "Usage: ./bench_scan [games] [max threads]\n");
+        return 1;
+    }
+    fd = mkstemp(path);
+    if (fd < 0 || write_history(path, games) != 0) {
+        fprintf(stderr, "Error: could not write a history under /tmp\n");
+        return 1;
+    }
+    size = lseek(fd, 0, SEEK_END);
+    megabytes = (double) size / (1024.0 * 1024.0);
+
+    printf("history scan: %ld games, %.1f MB in %s, %d CPUs online\n\n", games, megabytes, path,
+           historyScanThreads());
+    printf("%8s %14s %10s %8s\n", "threads", "lines/sec", "MB/sec", "hardest");
+
+    for (threads = 1; threads <= maxThreads && threads <= HISTORY_SCAN_MAX_THREADS; threads = threads * 2) {
+        void *result;
+        uint64_t end, checksum;
+        long counted;
+        char hardest[6];
+        double start, elapsed;
+
+        start = now_seconds();
+        if (historyScanText(fd, 0, threads, &ops, &result, &end) != 0) {
+            fprintf(stderr, "Error: the scan failed on %d threads\n", threads);
+            return 1;
+        }
+        elapsed = now_seconds() - start;
+
+        summarize(result, &counted, &checksum, hardest);
+        words_destroy(result, NULL);
+        if (counted != games || end != (uint64_t) size || (threads > 1 && checksum != expected)) {
+            fprintf(stderr, "Error: %d threads counted %ld of %ld games differently\n", threads, counted, games);
+            return 1;
+        }
+        expected = checksum;
+
+        printf("%8d %14.0f %10.1f %8s\n", threads, (double) games / elapsed, megabytes / elapsed, hardest);
+    }
+
+    printf("\nEvery thread count gave the same per-word totals\n");
+    close(fd);
+    unlink(path);
+    return 0;
+}
@@ -0,0 +1,524 @@
+/* bench_suite.c
+ *
+ * Microbenchmark suite for the Wordex hot paths.
+ *
+ * Every case is run with warm-up rounds followed by timed repetitions. Each
+ * repetition times a batch of operations; the per-operation times of all
+ * repetitions are summarised as mean / min / p50 / p90 / p99 / max and
+ * written as JSON so runs can be compared across commits.
+ *
+ * The suite works in a scratch directory (a copy of textFiles/ under /tmp,
+ * removed afterwards) so it never touches the real history, stats or user
+ * files.
+ *
+ * Usage:
+ *   ./bench_suite [--out results.json] [--label name] [--quick] [--filter text]
+ *
+ *   --quick    skip the 1M-line / 1M-user cases
+ *   --filter   only run cases whose name contains 'text'
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#define _GNU_SOURCE     // nftw, mkdtemp
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <ftw.h>
+#include "../headerFiles/account_store.h"
+#include "../headerFiles/authentication.h"
+#include "../headerFiles/dictionary.h"
+#include "../headerFiles/feedback.h"
+#include "../headerFiles/game_logic.h"
+#include "../headerFiles/history.h"
+#include "../headerFiles/kdf.h"
+#include "../headerFiles/leaderboard.h"
+#include "../headerFiles/statistics.h"
+#include "../headerFiles/data_dir.h"
+
+#define MAX_RESULTS  64
+#define MAX_REPS     1000
+
+/* BenchResult:
+ *   Summary of one case, in nanoseconds per operation.
+ */
+struct BenchResult {
+    char   name[64];
+    int    reps;
+    long   batch;
+    double mean, min, p50, p90, p99, max;
+};
+
+/* BenchCase:
+ *   A case runs 'op' batch times per repetition. 'setup' (optional) runs
+ *   once before the warm-up, outside the timings.
+ */
+struct BenchCase {
+    const char *name;
+    int         warmup;
+    int         reps;
+    long        batch;
+    int         large;                 // skipped by --quick
+    void      (*setup)(long size);
+    long        size;                  // argument for setup
+    void      (*op)(long i);
+};
+
+static struct BenchResult results[MAX_RESULTS];
+static int resultCount = 0;
+
+/* Shared inputs for the cases */
+static const Dictionary *dict;
+static uint32_t *packedWords;
+static uint8_t *patternOut;
+static GameState renderState;
+static volatile long sink;            // keeps results observable
+static int nullFd = -1;
+static int savedStdout = -1;
+
+/* now_ns: monotonic clock in nanoseconds */
+static double now_ns(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec * 1e9 + (double) ts.tv_nsec;
+}
+
+/* compare_doubles: qsort comparator */
+static int compare_doubles(const void *a, const void *b) {
+    double x = *(const double *) a;
+    double y = *(const double *) b;
+
+    return (x > y) - (x < y);
+}
+
+/* percentile: nearest-rank percentile of a sorted array */
+static double percentile(const double *sorted, int n, double pct) {
+    int rank = (int) (pct / 100.0 * n + 0.5);
+
+    if (rank < 1) {
+        rank = 1;
+    }
+    if (rank > n) {
+        rank = n;
+    }
+    return sorted[rank - 1];
+}
+
+/* stdout_to_null / stdout_restore: hide rendering output while timing it */
+static void stdout_to_null(void) {
+    fflush(stdout);
+    savedStdout = dup(STDOUT_FILENO);
+    dup2(nullFd, STDOUT_FILENO);
+}
+
+static void stdout_restore(void) {
+    fflush(stdout);
+    dup2(savedStdout, STDOUT_FILENO);
+    close(savedStdout);
+}
+
+/* ---------------------------------------------------------------------
+ * Case setup helpers
+ * ------------------------------------------------------------------- */
+
+/* write_history: synthetic history.txt with 'lines' games over lines/10 players */
+static void write_history(long lines) {
+    FILE *fp = fopen(dataPath("history.txt"), "w");
+    long players = lines / 10 > 0 ? lines / 10 : 1;
+    long i;
+    char word[6];
+
+    for (i = 0; i < lines; i++) {
+        dictionaryWordAt(dict, (int) (i % dict->count), word);
+        fprintf(fp, "player%ld %s %ld %ld 2025-12-01_12:00\n",
+                (i * 7919) % players, word, 1 + i % 6, (i % 3 != 0) ? 1L : 0L);
+    }
+    fclose(fp);
+}
+
+/* write_stats: synthetic stats.txt with 'users' players */
+static void write_stats(long users) {
+    FILE *fp = fopen(dataPath("stats.txt"), "w");
+    long i;
+
+    for (i = 0; i < users; i++) {
+        fprintf(fp, "player%ld 3 1 4 1 2 12 1764547911 0 1 1 1 0 0\n", i);
+    }
+    fclose(fp);
+}
+
+/* write_accounts: synthetic userprofiles.txt with 'users' accounts, no index yet */
+static void write_accounts(long users) {
+    FILE *fp = fopen(dataPath(ACCOUNTS_FILE), "w");
+    long i;
+
+    for (i = 0; i < users; i++) {
+        fprintf(fp, "username: player%ld\npassword: %064lx\n\n", i, i);
+    }
+    fclose(fp);
+    remove(dataPath(ACCOUNTS_INDEX_FILE));
+}
+
+/* setup_render: a game four guesses in, so every row type is drawn */
+static void setup_render(long size) {
+    (void) size;
+    gameStateInit(&renderState, "banes");
+    gameStateSubmit(&renderState, "cares");
+    gameStateSubmit(&renderState, "tones");
+    gameStateSubmit(&renderState, "lanes");
+    gameStateSubmit(&renderState, "bakes");
+}
+
+/* ---------------------------------------------------------------------
+ * Operations
+ * ------------------------------------------------------------------- */
+
+static void op_lookup(long i) {
+    sink += dictionaryContains(dict, packedWords[(i * 7919) % dict->count]);
+}
+
+static void op_lookup_miss(long i) {
+    sink += dictionaryContains(dict, packedWords[(i * 7919) % dict->count] ^ 0x3e0);
+}
+
+static void op_select(long i) {
+    char word[6];
+    int count;
+
+    (void) i;
+    setRandomWordAndCount(word, &count);
+    sink += word[0];
+}
+
+static void op_score(long i) {
+    sink += scoreGuess(packedWords[i % dict->count], packedWords[(i * 7919) % dict->count]);
+}
+
+static void op_score_batch(long i) {
+    scoreBatch(packedWords[i % dict->count], packedWords, (size_t) dict->count, patternOut);
+    sink += patternOut[i % dict->count];
+}
+
+static void op_render(long i) {
+    (void) i;
+    stdout_to_null();
+    interface(&renderState);
+    stdout_restore();
+}
+
+static void op_log_game(long i) {
+    logGame("benchuser", "banes", 1 + (int) (i % 6), (int) (i & 1));
+}
+
+/* The cold cases drop the leaderboard snapshot so every view rescans */
+static void op_leaderboard(long i) {
+    (void) i;
+    remove(dataPath("leaderboard.snap"));
+    stdout_to_null();
+    GetLeaderboard();
+    stdout_restore();
+}
+
+static void op_leaderboard_top(long i) {
+    (void) i;
+    remove(dataPath("leaderboard.snap"));
+    stdout_to_null();
+    GetLeaderboardTop(10);
+    stdout_restore();
+}
+
+static void op_leaderboard_after_game(long i) {
+    logGame("benchuser", "banes", 1 + (int) (i % 6), (int) (i & 1));
+    stdout_to_null();
+    GetLeaderboardTop(10);
+    stdout_restore();
+}
+
+static void op_history_all(long i) {
+    (void) i;
+    stdout_to_null();
+    CheckHistory();
+    stdout_restore();
+}
+
+static void op_history_page(long i) {
+    (void) i;
+    stdout_to_null();
+    CheckHistoryPage(0, 20);
+    stdout_restore();
+}
+
+static void op_update_stats(long i) {
+    updateStats("player5000", (int) (i & 1), 4, 1764547911L);
+}
+
+/* One result log apply batch: 512 games by 512 different players */
+static void op_update_stats_batch(long i) {
+    static char names[512][16];
+    StatsUpdate updates[512];
+    int k;
+
+    for (k = 0; k < 512; k++) {
+        snprintf(names[k], sizeof(names[k]), "player%ld", (i * 512 + k) % 10000);
+        updates[k].username   = names[k];
+        updates[k].won        = k & 1;
+        updates[k].guessCount = 4;
+        updates[k].timePlayed = 1764547911L;
+    }
+    updateStatsBatch(updates, 512);
+}
+
+/* A login's worth of account work: open the store, look the user up */
+static void op_account_lookup(long i) {
+    AccountStore accounts;
+    char hash[ACCOUNT_HASH_MAX];
+    char name[32];
+
+    snprintf(name, sizeof(name), "player%ld", (i * 7919) % 1000000);
+    if (accountStoreOpen(&accounts) == 0) {
+        sink += accountStoreFind(&accounts, name, hash);
+        accountStoreClose(&accounts);
+    }
+}
+
+static void op_hash_password(long i) {
+    char hashed[KDF_HASH_MAX];
+
+    (void) i;
+    hashPassword("Amy@1234", hashed);
+    sink += hashed[0];
+}
+
+/* The suite; add new hot paths here */
+static const struct BenchCase cases[] = {
+    {"dictionary_lookup_hit",     10,  200, 100000, 0, NULL,          0,       op_lookup},
+    {"dictionary_lookup_miss",    10,  200, 100000, 0, NULL,          0,       op_lookup_miss},
+    {"answer_selection",          10,  200,  10000, 0, NULL,          0,       op_select},
+    {"score_guess",               10,  200, 100000, 0, NULL,          0,       op_score},
+    {"score_batch_all_answers",   10,  200,    100, 0, NULL,          0,       op_score_batch},
+    {"interface_render_devnull",   3,   50,     10, 0, setup_render,  0,       op_render},
+    {"log_game_append",           10,  100,    100, 0, NULL,          0,       op_log_game},
+    {"leaderboard_10k_lines",      2,   20,      1, 0, write_history, 10000,   op_leaderboard},
+    {"leaderboard_1m_lines",       1,    5,      1, 1, write_history, 1000000, op_leaderboard},
+    {"leaderboard_top10_1m_lines", 1,    5,      1, 1, write_history, 1000000, op_leaderboard_top},
+    {"leaderboard_1m_lines_plus_1", 1,   5,      1, 1, write_history, 1000000, op_leaderboard_after_game},
+    {"history_all_10k_lines",      2,   20,      1, 0, write_history, 10000,   op_history_all},
+    {"history_first_page_1m_lines", 2,  50,     10, 1, write_history, 1000000, op_history_page},
+    {"update_stats_10k_users",     2,   20,      1, 0, write_stats,   10000,   op_update_stats},
+    {"update_stats_1m_users",      1,    5,      1, 1, write_stats,   1000000, op_update_stats},
+    {"stats_batch512_10k_users",  2,   20,      1, 0, write_stats,   10000,   op_update_stats_batch},
+    {"account_lookup_1m_users",    1,   20,    100, 1, write_accounts, 1000000, op_account_lookup},
+    {"hash_password",              1,   10,      1, 0, NULL,          0,       op_hash_password},
+};
+
+/*
+ * run_case:
+ *   Warm-up, timed repetitions, then the summary is stored in results[].
+ */
+
+static void run_case(const struct BenchCase *bc) {
+    static double samples[MAX_REPS];
+    struct BenchResult *r = &results[resultCount];
+    double total = 0.0;
+    long i;
+    int rep;
+
+    if (bc->setup != NULL) {
+        bc->setup(bc->size);
+    }
+
+    for (rep = 0; rep < bc->warmup; rep++) {
+        for (i = 0; i < bc->batch; i++) {
+            bc->op(i);
+        }
+    }
+
+    for (rep = 0; rep < bc->reps && rep < MAX_REPS; rep++) {
+        double start = now_ns();
+
+        for (i = 0; i < bc->batch; i++) {
+            bc->op(i + rep * bc->batch);
+        }
+        samples[rep] = (now_ns() - start) / (double) bc->batch;
+        total += samples[rep];
+    }
+
+    qsort(samples, (size_t) rep, sizeof(double), compare_doubles);
+
+    snprintf(r->name, sizeof(r->name), "%s", bc->name);
+    r->reps = rep;
+    r->batch = bc->batch;
+    r->mean = total / rep;
+    r->min = samples[0];
+    r->p50 = percentile(samples, rep, 50.0);
+    r->p90 = percentile(samples, rep, 90.0);
+    r->p99 = percentile(samples, rep, 99.0);
+    r->max = samples[rep - 1];
+    resultCount = resultCount + 1;
+
+    printf("%-28s %12.1f %12.1f %12.1f %12.1f %12.1f  (%d x %ld)\n",
+           r->name, r->mean, r->p50, r->p90, r->p99, r->max, r->reps, r->batch);
+    fflush(stdout);
+}
+
+/*
+ * write_json:
+ *   Machine-readable results: one object per case, times in ns/op.
+ */
+
+static int write_json(const char *path, const char *label) {
+    FILE *fp = fopen(path, "w");
+    int i;
+
+    if (fp == NULL) {
+        return 1;
+    }
+
+    fprintf(fp, "{\n  \"label\": \"%s\",\n  \"timestamp\": %ld,\n  \"unit\": \"ns/op\",\n  \"results\": [\n",
+            label, (long) time(NULL));
+    for (i = 0; i < resultCount; i++) {
+        const struct BenchResult *r = &results[i];
+
+        fprintf(fp, "    {\"name\": \"%s\", \"reps\": %d, \"batch\": %ld, "
+                    "\"mean\": %.3f, \"min\": %.3f, \"p50\": %.3f, \"p90\": %.3f, "
+                    "\"p99\": %.3f, \"max\": %.3f}%s\n",
+                r->name, r->reps, r->batch, r->mean, r->min, r->p50, r->p90,
+                r->p99, r->max, (i + 1 < resultCount) ? "," : "");
+    }
+    fprintf(fp, "  ]\n}\n");
+    fclose(fp);
+    return 0;
+}
+
+/*
+ * make_scratch:
+ *   Creates /tmp/wordex-bench-XXXXXX/textFiles with a copy of the word list
+ *   and empty data files, then changes into it.
+ */
+
+static int make_scratch(char *dir, const char *wordsPath) {
+    char path[512];
+    char buffer[65536];
+    FILE *in, *out;
+    size_t n;
+
+    strcpy(dir, "/tmp/wordex-bench-XXXXXX");
+    if (mkdtemp(dir) == NULL) {
+        return 1;
+    }
+
+    snprintf(path, sizeof(path), "%s/textFiles", dir);
+    mkdir(path, 0755);
+
+    snprintf(path, sizeof(path), "%s/textFiles/words.txt", dir);
+    in = fopen(wordsPath, "r");
+    out = fopen(path, "w");
+    if (in == NULL || out == NULL) {
+        return 1;
+    }
+    while ((n = fread(buffer, 1, sizeof(buffer), in)) > 0) {
+        fwrite(buffer, 1, n, out);
+    }
+    fclose(in);
+    fclose(out);
+
+    if (chdir(dir) != 0) {
+        return 1;
+    }
+
+    fclose(fopen(dataPath("history.txt"), "w"));
+    fclose(fopen(dataPath("stats.txt"), "w"));
+    fclose(fopen(dataPath("userprofiles.txt"), "w"));
+    return 0;
+}
+
+/* remove_entry / remove_scratch: delete the scratch directory afterwards */
+static int remove_entry(const char *path, const struct stat *st, int flag, struct FTW *ftw) {
+    (void) st;
+    (void) flag;
+    (void) ftw;
+    return remove(path);
+}
+
+static void remove_scratch(const char *dir) {
+    nftw(dir, remove_entry, 16, FTW_DEPTH | FTW_PHYS);
+}
+
+int main(int argc, char *argv[]) {
+    const char *outPath = "bench_results.json";
+    const char *label = "local";
+    const char *filter = NULL;
+    char absOut[1024];
+    char scratch[64];
+    char cwd[512];
+    int quick = 0;
+    int i;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            outPath = argv[++i];
+        } else if (strcmp(argv[i], "--label") == 0 && i + 1 < argc) {
+            label = argv[++i];
+        } else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (strcmp(argv[i], "--quick") == 0) {
+            quick = 1;
+        } else {
+            fprintf(stderr, "Usage: %s [--out file] [--label name] [--quick] [--filter text]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    // Resolve the output path before leaving the working directory
+    if (outPath[0] == '/' || getcwd(cwd, sizeof(cwd)) == NULL) {
+        snprintf(absOut, sizeof(absOut), "%s", outPath);
+    } else {
+        snprintf(absOut, sizeof(absOut), "%s/%s", cwd, outPath);
+    }
+
+    if (make_scratch(scratch, dataPath(DICTIONARY_FILE)) != 0) {
+        fprintf(stderr, "Error: could not set up a scratch copy of %s (run from the WorDex directory)\n", dataPath(DICTIONARY_FILE));
+        return 1;
+    }
+
+    dict = getDictionary();
+    nullFd = open("/dev/null", O_WRONLY);
+    if (dict == NULL || dict->count == 0 || nullFd < 0) {
+        fprintf(stderr, "Error: could not load the word list\n");
+        return 1;
+    }
+
+    packedWords = malloc(sizeof(uint32_t) * dict->count);
+    patternOut = malloc((size_t) dict->count);
+    for (i = 0; i < dict->count; i++) {
+        packedWords[i] = dictionaryPackedAt(dict, i);
+    }
+
+    printf("Wordex benchmarks (%s), times in ns/op\n\n", label);
+    printf("%-28s %12s %12s %12s %12s %12s\n", "case", "mean", "p50", "p90", "p99", "max");
+
+    for (i = 0; i < (int) (sizeof(cases) / sizeof(cases[0])); i++) {
+        if (quick && cases[i].large) {
+            continue;
+        }
+        if (filter != NULL && strstr(cases[i].name, filter) == NULL) {
+            continue;
+        }
+        run_case(&cases[i]);
+    }
+
+    remove_scratch(scratch);
+
+    if (write_json(absOut, label) != 0) {
+        fprintf(stderr, "Error: could not write %s\n", absOut);
+        return 1;
+    }
+    printf("\nResults written to %s\n", absOut);
+    return 0;
+}
@@ -0,0 +1,699 @@
+/* account_store.c
+ *
+ * Indexed account storage for the Wordex game.
+ *
+ * FUNCTIONALITY:
+ *  - accountStoreOpen / accountStoreClose: opens userprofiles.txt and maps
+ *    its username index, textFiles/userprofiles.idx
+ *  - accountStoreFind: username -> stored password hash through the index,
+ *    one pread of the account's record
+ *  - accountStoreAdd / accountStoreUpdate: append the account record with a
+ *    single write and point the index at it; an update then overwrites
+ *    the old record's hash in place, so no outdated (or unsalted) hash is
+ *    left in the file
+ *  - rebuildAccountIndex: rebuilds the index from the text file
+ *
+ * userprofiles.txt keeps its text format ("username: X", "password: H",
+ * blank line) and stays the source of truth. The index is an open-addressing
+ * hash table of (username hash, byte offset of the account's record). Its
+ * header remembers the size, inode and modification time of the text file
+ * it describes; if the text file was changed behind its back (or the index
+ * is missing) it is rebuilt with one pass over the file. Writers hold an
+ * flock on userprofiles.txt.
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "../headerFiles/account_store.h"
+#include "../headerFiles/profile.h"
+#include "../headerFiles/data_dir.h"
+#include "../headerFiles/name_hash.h"
+
+#define ACCOUNTS_INDEX_MAGIC   "WXACIDX"
+#define ACCOUNTS_INDEX_VERSION 1
+#define ACCOUNTS_INDEX_SLOTS   1024       // initial slot count, a power of two
+
+/* Longest username stored in userprofiles.txt */
+#define ACCOUNT_NAME_MAX       64
+
+/* Bytes read to get a whole account record */
+#define ACCOUNT_RECORD_MAX     (32 + ACCOUNT_NAME_MAX + ACCOUNT_HASH_MAX)
+
+/* What a superseded record's hash is overwritten with, byte for byte */
+#define ACCOUNT_SCRUB_CHAR     '*'
+
+/* AccountIndexHeader:
+ *   The state of userprofiles.txt the index was built for.
+ */
+struct AccountIndexHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t slotCount;
+    uint64_t count;
+    uint64_t fileDevice;
+    uint64_t fileInode;
+    uint64_t fileSize;
+    int64_t  fileMtimeSec;
+    int64_t  fileMtimeNsec;
+};
+
+/* AccountSlot:
+ *   One account; offset is the record's byte offset + 1, 0 = empty slot.
+ */
+struct AccountSlot {
+    uint32_t hash;
+    uint32_t reserved;
+    uint64_t offset;
+};
+
+/*
+ * read_field:
+ *   Copies the rest of a "prefix value" line into 'out' (at most size - 1
+ *   bytes), returning a pointer just past the line, or NULL if the line
+ *   does not start with 'prefix' or is cut short.
+ */
+
+static const char *read_field(const char *p, const char *end, const char *prefix,
+                              char *out, size_t size) {
+    size_t length = strlen(prefix);
+    size_t n = 0;
+
+    if ((size_t) (end - p) < length || memcmp(p, prefix, length) != 0) {
+        return NULL;
+    }
+    p = p + length;
+
+    while (p < end && *p != '\n') {
+        if (n + 1 >= size) {
+            return NULL;
+        }
+        out[n] = *p;
+        n = n + 1;
+        p = p + 1;
+    }
+    out[n] = '\0';
+    return (p < end) ? p + 1 : p;
+}
+
+/*
+ * read_record:
+ *   Reads the account record at 'offset'.
+ *
+ * RETURNS:
+ *   0 and fills 'name' (and 'hash' if not NULL) on success, 1 otherwise.
+ */
+
+static int read_record(int fd, uint64_t offset, char *name, char *hash) {
+    char buffer[ACCOUNT_RECORD_MAX];
+    char storedHash[ACCOUNT_HASH_MAX];
+    const char *p;
+    ssize_t got;
+
+    got = pread(fd, buffer, sizeof(buffer), (off_t) offset);
+    if (got <= 0) {
+        return 1;
+    }
+
+    p = read_field(buffer, buffer + got, "username: ", name, ACCOUNT_NAME_MAX);
+    if (p == NULL) {
+        return 1;
+    }
+    if (hash != NULL) {
+        if (read_field(p, buffer + got, "password: ", storedHash, sizeof(storedHash)) == NULL) {
+            return 1;
+        }
+        strcpy(hash, storedHash);
+    }
+    return 0;
+}
+
+/*
+ * scrub_record:
+ *   Overwrites the password hash of the record at 'offset' with
+ *   ACCOUNT_SCRUB_CHAR, keeping its length, and syncs it. Used on records
+ *   a newer one for the same name supersedes. Caller holds the lock.
+ *
+ * RETURNS:
+ *   0 on success (or if the hash is already scrubbed), 1 on failure.
+ */
+
+static int scrub_record(AccountStore *store, uint64_t offset) {
+    static const char prefix[] = "password: ";
+    char buffer[ACCOUNT_RECORD_MAX];
+    char name[ACCOUNT_NAME_MAX];
+    struct stat held, named;
+    const char *p;
+    const char *end;
+    char *hash;
+    size_t length;
+    ssize_t got;
+    int fd, failed;
+
+    got = pread(store->fd, buffer, sizeof(buffer), (off_t) offset);
+    if (got <= 0) {
+        return 1;
+    }
+    end = buffer + got;
+    p = read_field(buffer, end, "username: ", name, sizeof(name));
+    if (p == NULL || (size_t) (end - p) < sizeof(prefix) - 1 || memcmp(p, prefix, sizeof(prefix) - 1) != 0) {
+        return 1;
+    }
+    hash = buffer + (p - buffer) + sizeof(prefix) - 1;
+    length = 0;
+    while (hash + length < end && hash[length] != '\n') {
+        length++;
+    }
+    if (length == 0 || hash[0] == ACCOUNT_SCRUB_CHAR) {
+        return 0;
+    }
+    memset(hash, ACCOUNT_SCRUB_CHAR, length);
+
+    // store->fd appends wherever pwrite points, so write through a second descriptor
+    fd = open(dataPath(ACCOUNTS_FILE), O_WRONLY);
+    if (fd < 0) {
+        return 1;
+    }
+    failed = (fstat(fd, &named) != 0 || fstat(store->fd, &held) != 0 ||
+              held.st_dev != named.st_dev || held.st_ino != named.st_ino ||
+              pwrite(fd, hash, length, (off_t) (offset + (uint64_t) (hash - buffer))) != (ssize_t) length ||
+              fdatasync(fd) != 0);
+    close(fd);
+    return failed;
+}
+
+/*
+ * note_file:
+ *   Records the accounts file's current size, inode and mtime in the index.
+ */
+
+static void note_file(AccountStore *store) {
+    struct stat st;
+
+    if (fstat(store->fd, &st) == 0) {
+        store->header->fileDevice    = (uint64_t) st.st_dev;
+        store->header->fileInode     = (uint64_t) st.st_ino;
+        store->header->fileSize      = (uint64_t) st.st_size;
+        store->header->fileMtimeSec  = (int64_t) st.st_mtim.tv_sec;
+        store->header->fileMtimeNsec = (int64_t) st.st_mtim.tv_nsec;
+    }
+}
+
+/*
+ * index_matches:
+ *   1 if the mapped index describes the accounts file as it is now.
+ */
+
+static int index_matches(const AccountStore *store) {
+    struct stat st;
+
+    if (store->header == NULL || fstat(store->fd, &st) != 0) {
+        return 0;
+    }
+    return store->header->fileDevice == (uint64_t) st.st_dev &&
+           store->header->fileInode == (uint64_t) st.st_ino &&
+           store->header->fileSize == (uint64_t) st.st_size &&
+           store->header->fileMtimeSec == (int64_t) st.st_mtim.tv_sec &&
+           store->header->fileMtimeNsec == (int64_t) st.st_mtim.tv_nsec;
+}
+
+/*
+ * index_unmap:
+ *   Drops the index mapping and closes the index file.
+ */
+
+static void index_unmap(AccountStore *store) {
+    if (store->header != NULL) {
+        munmap(store->header, store->mapSize);
+    }
+    if (store->indexFd >= 0) {
+        close(store->indexFd);
+    }
+    store->header  = NULL;
+    store->slots   = NULL;
+    store->indexFd = -1;
+}
+
+/*
+ * index_map:
+ *   Maps userprofiles.idx read/write.
+ *
+ * RETURNS:
+ *   0 on success, 1 if it is missing or not a valid index.
+ */
+
+static int index_map(AccountStore *store) {
+    struct stat st;
+    void *map;
+
+    index_unmap(store);
+
+    store->indexFd = open(dataPath(ACCOUNTS_INDEX_FILE), O_RDWR);
+    if (store->indexFd < 0) {
+        return 1;
+    }
+    if (fstat(store->indexFd, &st) != 0 || (size_t) st.st_size < sizeof(AccountIndexHeader)) {
+        index_unmap(store);
+        return 1;
+    }
+
+    map = mmap(NULL, (size_t) st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, store->indexFd, 0);
+    if (map == MAP_FAILED) {
+        index_unmap(store);
+        return 1;
+    }
+    store->header  = map;
+    store->slots   = (AccountSlot *) ((char *) map + sizeof(AccountIndexHeader));
+    store->mapSize = (size_t) st.st_size;
+
+    if (memcmp(store->header->magic, ACCOUNTS_INDEX_MAGIC, 8) != 0 ||
+        store->header->version != ACCOUNTS_INDEX_VERSION ||
+        store->mapSize != sizeof(AccountIndexHeader) + store->header->slotCount * sizeof(AccountSlot)) {
+        index_unmap(store);
+        return 1;
+    }
+    return 0;
+}
+
+/*
+ * slot_insert:
+ *   Puts an account in the first free slot of its probe sequence.
+ */
+
+static void slot_insert(AccountSlot *slots, uint64_t slotCount, uint32_t hash, uint64_t offset) {
+    uint64_t i = hash & (slotCount - 1);
+
+    while (slots[i].offset != 0) {
+        i = (i + 1) & (slotCount - 1);
+    }
+    slots[i].hash = hash;
+    slots[i].offset = offset + 1;
+}
+
+/*
+ * index_write:
+ *   Writes 'slots' as the new userprofiles.idx (temporary file, then
+ *   rename) and maps it.
+ *
+ * RETURNS:
+ *   0 on success, 1 on failure.
+ */
+
+static int index_write(AccountStore *store, const AccountSlot *slots, uint64_t slotCount,
+                       uint64_t count) {
+    AccountIndexHeader header;
+    FILE *fp;
+    int failed;
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, ACCOUNTS_INDEX_MAGIC, 8);
+    header.version   = ACCOUNTS_INDEX_VERSION;
+    header.slotCount = slotCount;
+    header.count     = count;
+
+    fp = fopen(dataPath(ACCOUNTS_INDEX_FILE ".tmp"), "wb");
+    if (fp == NULL) {
+        return 1;
+    }
+    failed = (fwrite(&header, sizeof(header), 1, fp) != 1 ||
+              fwrite(slots, sizeof(AccountSlot), slotCount, fp) != slotCount);
+    failed = (fclose(fp) != 0 || failed);
+
+    if (failed || rename(dataPath(ACCOUNTS_INDEX_FILE ".tmp"), dataPath(ACCOUNTS_INDEX_FILE)) != 0 ||
+        index_map(store) != 0) {
+        remove(dataPath(ACCOUNTS_INDEX_FILE ".tmp"));
+        return 1;
+    }
+    note_file(store);
+    return 0;
+}
+
+/*
+ * index_rebuild:
+ *   One pass over userprofiles.txt, indexing every "username: " line. If a
+ *   name appears twice the later record wins: accountStoreUpdate appends
+ *   a new record rather than rewriting the old one. The earlier record's
+ *   hash is scrubbed, in case an older version left it there. Caller
+ *   holds the lock.
+ *
+ * RETURNS:
+ *   0 on success, 1 on failure.
+ */
+
+static int index_rebuild(AccountStore *store) {
+    FILE *fp;
+    AccountSlot *slots = NULL;
+    uint64_t slotCount = ACCOUNTS_INDEX_SLOTS;
+    uint64_t count = 0;
+    uint64_t offset = 0;
+    char *line = NULL;
+    size_t lineSize = 0;
+    ssize_t length;
+    int failed = 0;
+
+    fp = fdopen(dup(store->fd), "r");
+    if (fp == NULL) {
+        return 1;
+    }
+    rewind(fp);
+
+    slots = calloc(slotCount, sizeof(AccountSlot));
+    failed = (slots == NULL);
+
+    while (!failed && (length = getline(&line, &lineSize, fp)) > 0) {
+        uint64_t at = offset;
+        char name[ACCOUNT_NAME_MAX];
+
+        offset = offset + (uint64_t) length;
+        if (read_field(line, line + length, "username: ", name, sizeof(name)) == NULL) {
+            continue;
+        }
+
+        // Grow first, so the table stays at most half full
+        if ((count + 1) * 2 > slotCount) {
+            AccountSlot *grown = calloc(slotCount * 2, sizeof(AccountSlot));
+            uint64_t i;
+
+            if (grown == NULL) {
+                failed = 1;
+                break;
+            }
+            for (i = 0; i < slotCount; i++) {
+                if (slots[i].offset != 0) {
+                    slot_insert(grown, slotCount * 2, slots[i].hash, slots[i].offset - 1);
+                }
+            }
+            free(slots);
+            slots = grown;
+            slotCount = slotCount * 2;
+        }
+
+        {
+            uint32_t hash = hashUsername(name);
+            uint64_t i = hash & (slotCount - 1);
+            int duplicate = 0;
+
+            while (slots[i].offset != 0) {
+                char other[ACCOUNT_NAME_MAX];
+
+                if (slots[i].hash == hash &&
+                    read_record(store->fd, slots[i].offset - 1, other, NULL) == 0 &&
+                    strcmp(other, name) == 0) {
+                    scrub_record(store, slots[i].offset - 1);
+                    slots[i].offset = at + 1;
+                    duplicate = 1;
+                    break;
+                }
+                i = (i + 1) & (slotCount - 1);
+            }
+            if (!duplicate) {
+                slot_insert(slots, slotCount, hash, at);
+                count = count + 1;
+            }
+        }
+    }
+
+    free(line);
+    fclose(fp);
+
+    if (!failed) {
+        failed = index_write(store, slots, slotCount, count);
+    }
+    free(slots);
+    return failed;
+}
+
+/*
+ * refresh_index:
+ *   Makes the mapped index match the file: remaps it from disk (another
+ *   process may have added accounts) and rebuilds it only if that is not
+ *   enough. Caller holds the file lock.
+ *
+ * RETURNS:
+ *   0 on success, 1 on failure.
+ */
+
+static int refresh_index(AccountStore *store) {
+    if (index_matches(store)) {
+        return 0;
+    }
+    if (index_map(store) == 0 && index_matches(store)) {
+        return 0;
+    }
+    return index_rebuild(store);
+}
+
+/*
+ * accountStoreOpen:
+ *   Opens userprofiles.txt and brings its index up to date.
+ *
+ * RETURNS:
+ *   0 on success, 1 on failure.
+ */
+
+int accountStoreOpen(AccountStore *store) {
+    int failed;
+
+    store->header  = NULL;
+    store->slots   = NULL;
+    store->indexFd = -1;
+    store->mapSize = 0;
+
+    store->fd = open(dataPath(ACCOUNTS_FILE), O_RDWR | O_APPEND | O_CREAT, 0644);
+    if (store->fd < 0) {
+        return 1;
+    }
+
+    flock(store->fd, LOCK_EX);
+    failed = refresh_index(store);
+    flock(store->fd, LOCK_UN);
+
+    if (failed) {
+        accountStoreClose(store);
+        return 1;
+    }
+    return 0;
+}
+
+/*
+ * find_slot:
+ *   Probes the index for 'username'.
+ *
+ * RETURNS:
+ *   The slot index (and the hash if wanted) if found, -1 otherwise.
+ */
+
+static long find_slot(const AccountStore *store, const char *username, char *hash) {
+    uint32_t h = hashUsername(username);
+    uint64_t mask = store->header->slotCount - 1;
+    uint64_t i = h & mask;
+
+    while (store->slots[i].offset != 0) {
+        char name[ACCOUNT_NAME_MAX];
+        char storedHash[ACCOUNT_HASH_MAX];
+
+        if (store->slots[i].hash == h &&
+            read_record(store->fd, store->slots[i].offset - 1, name, storedHash) == 0 &&
+            strcmp(name, username) == 0) {
+            if (hash != NULL) {
+                strcpy(hash, storedHash);
+            }
+            return (long) i;
+        }
+        i = (i + 1) & mask;
+    }
+    return -1;
+}
+
+/*
+ * accountStoreFind:
+ *   Index lookup. On a miss, checks whether another process has added
+ *   accounts since the index was mapped and looks again if so.
+ *
+ * RETURNS:
+ *   0 if the account exists, 1 if it does not.
+ */
+
+int accountStoreFind(AccountStore *store, const char *username, char *hash) {
+    PROFILE_SCOPE(PROFILE_ACCOUNT_FIND);
+    int missing;
+
+    if (store->header == NULL) {
+        return 1;
+    }
+    if (find_slot(store, username, hash) >= 0) {
+        return 0;
+    }
+    if (index_matches(store)) {
+        return 1;
+    }
+
+    flock(store->fd, LOCK_EX);
+    missing = (refresh_index(store) != 0 || find_slot(store, username, hash) < 0);
+    flock(store->fd, LOCK_UN);
+    return missing;
+}
+
+/*
+ * append_record:
+ *   Appends "username: X\npassword: H\n\n" with one write and points the
+ *   index at it: a new slot for a new account ('replace' 0), or the
+ *   account's existing slot ('replace' 1). The index doubles (from its own
+ *   slots, no file scan) when half full. A replaced record's hash is
+ *   scrubbed once the new one is written.
+ *
+ * RETURNS:
+ *   0 on success, 1 if the account exists (or, replacing, does not) or on
+ *   failure.
+ */
+
+static int append_record(AccountStore *store, const char *username, const char *hash,
+                         int replace) {
+    char record[ACCOUNT_RECORD_MAX];
+    char last = '\n';
+    struct stat st;
+    long slot;
+    int length;
+    int failed = 0;
+
+    if (strlen(username) >= ACCOUNT_NAME_MAX || strlen(hash) >= ACCOUNT_HASH_MAX) {
+        return 1;
+    }
+
+    flock(store->fd, LOCK_EX);
+
+    if (refresh_index(store) != 0 || fstat(store->fd, &st) != 0) {
+        flock(store->fd, LOCK_UN);
+        return 1;
+    }
+    slot = find_slot(store, username, NULL);
+    if ((slot >= 0) != replace) {
+        flock(store->fd, LOCK_UN);
+        return 1;
+    }
+
+    // Start on a fresh line even if the file was left without a final newline
+    if (st.st_size > 0 && pread(store->fd, &last, 1, st.st_size - 1) != 1) {
+        last = '\n';
+    }
+    length = snprintf(record, sizeof(record), "%susername: %s\npassword: %s\n\n",
+                      last == '\n' ? "" : "\n", username, hash);
+
+    if (!replace && (store->header->count + 1) * 2 > store->header->slotCount) {
+        uint64_t slotCount = store->header->slotCount * 2;
+        AccountSlot *grown = calloc(slotCount, sizeof(AccountSlot));
+        uint64_t i;
+
+        failed = (grown == NULL);
+        for (i = 0; !failed && i < store->header->slotCount; i++) {
+            if (store->slots[i].offset != 0) {
+                slot_insert(grown, slotCount, store->slots[i].hash, store->slots[i].offset - 1);
+            }
+        }
+        if (!failed) {
+            failed = index_write(store, grown, slotCount, store->header->count);
+        }
+        free(grown);
+    }
+
+    if (!failed) {
+        failed = (write(store->fd, record, (size_t) length) != length);
+    }
+    if (!failed) {
+        uint64_t offset = (uint64_t) st.st_size + (last == '\n' ? 0 : 1);
+
+        if (replace) {
+            failed = scrub_record(store, store->slots[slot].offset - 1);
+            store->slots[slot].offset = offset + 1;
+        } else {
+            slot_insert(store->slots, store->header->slotCount, hashUsername(username), offset);
+            store->header->count = store->header->count + 1;
+        }
+        note_file(store);
+    }
+
+    flock(store->fd, LOCK_UN);
+    return failed;
+}
+
+/*
+ * accountStoreAdd:
+ *   Registers a new account.
+ *
+ * RETURNS:
+ *   0 on success, 1 if the account exists or on failure.
+ */
+
+int accountStoreAdd(AccountStore *store, const char *username, const char *hash) {
+    return append_record(store, username, hash, 0);
+}
+
+/*
+ * accountStoreUpdate:
+ *   Replaces an account's password hash. The old record stays in the file,
+ *   its hash overwritten, and is superseded: the index, and any rebuild,
+ *   use the newest record.
+ *
+ * RETURNS:
+ *   0 on success, 1 if the account does not exist or on failure.
+ */
+
+int accountStoreUpdate(AccountStore *store, const char *username, const char *hash) {
+    return append_record(store, username, hash, 1);
+}
+
+/*
+ * accountStoreClose:
+ *   Unmaps the index and closes both files.
+ */
+
+void accountStoreClose(AccountStore *store) {
+    index_unmap(store);
+    if (store->fd >= 0) {
+        close(store->fd);
+    }
+    store->fd = -1;
+}
+
+/*
+ * rebuildAccountIndex:
+ *   Rebuilds the index from scratch, e.g. after editing userprofiles.txt
+ *   by hand or upgrading from a version without the index.
+ *
+ * RETURNS:
+ *   0 on success, 1 on failure.
+ */
+
+int rebuildAccountIndex(void) {
+    AccountStore store;
+    int failed;
+
+    store.header  = NULL;
+    store.slots   = NULL;
+    store.indexFd = -1;
+    store.fd = open(dataPath(ACCOUNTS_FILE), O_RDWR | O_APPEND | O_CREAT, 0644);
+    if (store.fd < 0) {
+        fprintf(stderr, "Error: Cannot open %s\n", dataPath(ACCOUNTS_FILE));
+        return 1;
+    }
+
+    flock(store.fd, LOCK_EX);
+    failed = index_rebuild(&store);
+    flock(store.fd, LOCK_UN);
+
+    if (failed) {
+        fprintf(stderr, "Error: Could not rebuild %s\n", dataPath(ACCOUNTS_INDEX_FILE));
+    } else {
+        printf("Indexed %llu accounts in %s\n", (unsigned long long) store.header->count,
+               dataPath(ACCOUNTS_INDEX_FILE));
+    }
+    accountStoreClose(&store);
+    return failed;
+}
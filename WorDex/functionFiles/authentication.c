@@ -1,7 +1,7 @@
 #include "../headerFiles/authentication.h"
-
-char currentUsername[50]; 
-char currentHashedPassword[70]; 
+#include "../headerFiles/account_store.h"
+#include "../headerFiles/kdf.h"
+#include "../headerFiles/profile.h"
 
 /*
  * checkUserName
@@ -16,50 +16,41 @@ char currentHashedPassword[70];
  */
 int checkUserName(char *username) { 
 
-    FILE *userinfo;
-    char line[200];
+    AccountStore accounts;
+    int exists = 0;
 
     username[strcspn(username, "\n")] = '\0';
 
-    userinfo = fopen("textFiles/userprofiles.txt", "r");
-
-    // if (userinfo == NULL) {
-    //     printf("\033[0;32mSuccesful, this username is available!\n\n\033[0m");
-    //     return 0;
-    // }
-
-    while(fgets(line, sizeof(line), userinfo) != NULL) {
-       line[strcspn(line, "\n")] = '\0';
-        
-       char searchedUsername[100];
-       sprintf(searchedUsername, "username: %s", username);
+    // Index lookup instead of scanning every account in userprofiles.txt
+    if (accountStoreOpen(&accounts) == 0) {
+        exists = (accountStoreFind(&accounts, username, NULL) == 0);
+        accountStoreClose(&accounts);
+    }
 
-       if (strcmp(line, searchedUsername) == 0) {
-            fclose(userinfo);
-            fprintf(stderr, "\033[0;31mUsername already exists, please choose a different username\n\n\033[0m");
-            return 1;
-        }
+    if (exists) {
+        fprintf(stderr, "\033[0;31mUsername already exists, please choose a different username\n\n\033[0m");
+        return 1;
     }
 
-    fclose(userinfo);
     printf("\033[0;32mSuccesful, this username is available!\n\n\033[0m");
     return 0;
 }
 
 /*
- * hashPassword
+ * legacyHashPassword
  *
- * This function is responsible for hashing the user password to keep the user information safe. It 
- * hashes the passwird by mixing it with a string win and doing multiple mixes so it's hard to revert
+ * The hash accounts were stored with before PBKDF2: the password characters mixed with
+ * the string win and multiplied by 31 679 times. Only used to check old records, which
+ * are upgraded at their next successful login.
  *
  * Parameters:
  *   *password: the provided password to hash
- *   *result: the buffer to store the resulting hash string
+ *   *result: the buffer to store the resulting hash string (65 bytes)
  *
  * Return:
  *   This function returns void (no return value)
  */
-void hashPassword(char *password, char *result) {
+static void legacyHashPassword(const char *password, char *result) {
     int i;
     unsigned long long startNum = 4137;
     unsigned long long saltNum = 0;
@@ -86,8 +77,53 @@ void hashPassword(char *password, char *result) {
     // Convert the mixed number to a 64-character hexadecimal string and store in result
     sprintf(result, "%064llx", mixedNum);
 }
+
 /*
- * passwordCheck
+ * hashPassword
+ *
+ * This function is responsible for hashing the user password to keep the user information safe.
+ * It uses PBKDF2-HMAC-SHA256 with a random salt per user and the iteration count from
+ * textFiles/kdf.conf (see --calibrate-kdf), stored as pbkdf2$iterations$salt$key.
+ *
+ * Parameters:
+ *   *password: the provided password to hash
+ *   *result: the buffer to store the resulting hash string (KDF_HASH_MAX bytes)
+ *
+ * Return:
+ *   This function returns an integer, 0: success, 1: failure
+ */
+int hashPassword(char *password, char *result) {
+    PROFILE_SCOPE(PROFILE_PASSWORD);
+
+    return kdfHash(password, result);
+}
+
+/*
+ * verifyPassword
+ *
+ * Checks a password against a stored hash, either a PBKDF2 hash or a legacy one.
+ *
+ * Parameters:
+ *   *password: the password the user entered
+ *   *storedHash: the hash stored for the account
+ *
+ * Return:
+ *   This function returns an integer, 0: the password matches, 1: it does not
+ */
+int verifyPassword(const char *password, const char *storedHash) {
+    PROFILE_SCOPE(PROFILE_PASSWORD);
+    char legacyHash[65];
+
+    if (strncmp(storedHash, KDF_PREFIX, strlen(KDF_PREFIX)) == 0) {
+        return kdfVerify(password, storedHash);
+    }
+
+    legacyHashPassword(password, legacyHash);
+    return strcmp(storedHash, legacyHash) != 0;
+}
+
+/*
+ * passwordProblem
  *
  * Checks if a password meets security requirements including minimum length,
  * maximum length, presence of special characters, and presence of uppercase letters.
@@ -96,21 +132,20 @@ void hashPassword(char *password, char *result) {
  *   *password: the password string to validate
  *
  * Return:
- *   This function returns an integer, 0: success, 1: failure
+ *   This function returns NULL if the password is acceptable, otherwise a message
+ *   saying which requirement it misses
  */
-int passwordCheck(char *password) { 
+const char *passwordProblem(const char *password) {
     int i;
     int specialCheck = 0;
     int uppercaseCheck = 0;
 
     if (strlen(password) < 8) {
-        fprintf(stderr, "\033[0;31mThe password must be at least 8 characters long\n\n\033[0m");
-        return 1;
+        return "The password must be at least 8 characters long";
     }
 
     if (strlen(password) > 50) {
-        fprintf(stderr, "\033[0;31mThe password is too long, maximum 50 character limit\n\n\033[0m");
-        return 1;
+        return "The password is too long, maximum 50 character limit";
     }
 
     for (i = 0; i < strlen(password); i++) {
@@ -125,12 +160,32 @@ int passwordCheck(char *password) {
     }
 
     if (specialCheck == 0) {
-        fprintf(stderr, "\033[0;31mThe password must contain a special character\n\n\033[0m");
-        return 1;
+        return "The password must contain a special character";
     }
 
     if (uppercaseCheck == 0) {
-        fprintf(stderr, "\033[0;31mThe password must contain an uppercase character\n\n\033[0m");
+        return "The password must contain an uppercase character";
+    }
+
+    return NULL;
+}
+
+/*
+ * passwordCheck
+ *
+ * Checks a password with passwordProblem and prints the problem, if any, in red.
+ *
+ * Parameters:
+ *   *password: the password string to validate
+ *
+ * Return:
+ *   This function returns an integer, 0: success, 1: failure
+ */
+int passwordCheck(char *password) { 
+    const char *problem = passwordProblem(password);
+
+    if (problem != NULL) {
+        fprintf(stderr, "\033[0;31m%s\n\n\033[0m", problem);
         return 1;
     }
 
@@ -144,12 +199,12 @@ int passwordCheck(char *password) {
  * validating both inputs, hashing the password, and storing the user credentials in the textfile. 
  *
  * Parameters:
- *   None
+ *   *session: filled in with the new account when registration succeeds
  *
  * Return:
  *   This function returns an integer, 0: registration successful, 1: registration failed
  */
-int registerUser() {
+int registerUser(Session *session) {
 
     char username[50];
     char password[50];
@@ -168,21 +223,28 @@ int registerUser() {
         return 1;
     }
 
-    char hashedPassword[65];
-    hashPassword(password, hashedPassword);
-
-    strcpy(currentUsername, username);
-    strcpy(currentHashedPassword, hashedPassword);
+    char hashedPassword[KDF_HASH_MAX];
+    if (hashPassword(password, hashedPassword) != 0) {
+        fprintf(stderr, "\033[0;31mCould not hash the password, please try again\n\n\033[0m");
+        return 1;
+    }
 
-    FILE *userinfo;
+    AccountStore accounts;
+    int saved;
 
-    // appending info to the file
-    userinfo = fopen("textFiles/userprofiles.txt", "a");
-    fprintf(userinfo, "username: %s\n", username);
-    fprintf(userinfo, "password: %s\n", hashedPassword);
-    fprintf(userinfo, "\n");
+    // appending info to the file (one write) and to the username index
+    saved = (accountStoreOpen(&accounts) == 0);
+    if (saved) {
+        saved = (accountStoreAdd(&accounts, username, hashedPassword) == 0);
+        accountStoreClose(&accounts);
+    }
+    if (!saved) {
+        fprintf(stderr, "\033[0;31mCould not save the account, please try again\n\n\033[0m");
+        return 1;
+    }
 
-    fclose(userinfo);
+    strcpy(session->username, username);
+    strcpy(session->hashedPassword, hashedPassword);
 
     printf("\033[0;32mRegistration succesful! Welcome %s\033[0m\n\n", username);
 
@@ -197,88 +259,53 @@ int registerUser() {
  * stored hash.
  *
  * Parameters:
- *   None
+ *   *session: filled in with the account once the password matches
  *
  * Return:
  *   This function returns an integer, 0: login successful, 1: login failed
  */
-int loginUser() {
+int loginUser(Session *session) {
 
-    FILE *userinfo;
+    AccountStore accounts;
     char username[50];
     char password[50];
-    int match = 0;
-    int correctUsername = 0;
-    int correctPassword = 0;
-    
-    while (correctUsername == 0) {
+    char storedHash[ACCOUNT_HASH_MAX];
+    char upgradedHash[KDF_HASH_MAX];
+    int opened;
+
+    // One store for the whole login: every attempt is an index lookup
+    opened = (accountStoreOpen(&accounts) == 0);
+
+    while (1) {
         printf("Please enter your username:\n");
         scanf("%s", username);
 
         // Remove trailing newline character from username string if present
         username[strcspn(username, "\n")] = '\0';
-        userinfo = fopen("textFiles/userprofiles.txt", "r");
-
-        char line[200];
-        while(fgets(line, sizeof(line), userinfo) != NULL) {
-            line[strcspn(line, "\n")] = '\0';
-
-            char searchedUsername[100];
-            sprintf(searchedUsername, "username: %s", username);
-            if (strcmp(line, searchedUsername) == 0) {
-                match = 1;
-                correctUsername = 1;
-                break;
-            }
-        }
-        fclose(userinfo);
 
-        if (match == 0) {
-            fprintf(stderr, "\033[0;31mThis username does not exist, please try again.\n\n\033[0m");
+        if (opened && accountStoreFind(&accounts, username, storedHash) == 0) {
+            break;
         }
+        fprintf(stderr, "\033[0;31mThis username does not exist, please try again.\n\n\033[0m");
     }
 
     // Looping until password is correct
-    while(correctPassword == 0) {
+    while (1) {
         printf("Please enter your password:\n");
         scanf("%s", password);
 
         password[strcspn(password, "\n")] = '\0';
 
-        char storedHash[65];
-        char enteredHash[65];
-        char line[200];
-
-        userinfo = fopen("textFiles/userprofiles.txt", "r");
-        while(fgets(line, sizeof(line), userinfo) != NULL) {
-            line[strcspn(line, "\n")] = '\0';
-
-            char searchedUsername[100];
-            sprintf(searchedUsername, "username: %s", username);
-            if (strcmp(line, searchedUsername) == 0) {
-
-                fgets(line, sizeof(line), userinfo);
-                line[strcspn(line, "\n")] = '\0';
-
-                // Locate password in the line and extract the hash value that follows it
-                char *passwordStart = strstr(line, "password: ");
-                if (passwordStart != NULL) {
-                    passwordStart += strlen("password: ");
-                    strcpy(storedHash, passwordStart);
-                }
-                break;
+        // Comparing stored hash and the entered password
+        if (verifyPassword(password, storedHash) == 0) {
+            // Re-hash legacy or under-strength hashes now that we know the password
+            if (kdfNeedsUpgrade(storedHash) && hashPassword(password, upgradedHash) == 0 &&
+                accountStoreUpdate(&accounts, username, upgradedHash) == 0) {
+                strcpy(storedHash, upgradedHash);
             }
-        }
-
-        fclose(userinfo);
-
-        hashPassword(password, enteredHash);
-
-        // Comparing stored hash and user converted hash matcjes
-        if (strcmp(storedHash, enteredHash) == 0) {
-            correctPassword = 1;
-            strcpy(currentUsername, username);
-            strcpy(currentHashedPassword, storedHash);
+            accountStoreClose(&accounts);
+            strcpy(session->username, username);
+            strcpy(session->hashedPassword, storedHash);
             printf("Login Succesful! Welcome, %s", username);
             return 0;
         }
@@ -288,24 +315,20 @@ int loginUser() {
     }
 }
 
-char* getUsername() {
-    return currentUsername;
-}
-
 /*
  * logoutUser
  *
- * This function clears the current username and password.
+ * This function clears the session's username and password.
  *
  * Parameters:
- *   None
+ *   *session: the session to end
  *
  * Return:
  *   This function returns void (no return value)
  */
-void logoutUser() {
-    currentUsername[0] = '\0';
-    currentHashedPassword[0] = '\0';
+void logoutUser(Session *session) {
+    session->username[0] = '\0';
+    session->hashedPassword[0] = '\0';
 
     printf("Logged out successfully \n");
 }
\ No newline at end of file
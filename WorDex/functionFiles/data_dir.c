@@ -0,0 +1,104 @@
+/* data_dir.c
+ *
+ * The directory the game's files live in.
+ *
+ * FUNCTIONALITY:
+ *  - setDataDir / dataDir: choose and report the directory (textFiles by
+ *    default); it is fixed once the first path has been handed out
+ *  - dataPath: joins the directory and a file name; each joined path is
+ *    kept in a short list, so the hot paths that open a file per call pay
+ *    a few string compares instead of an allocation
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#include <string.h>
+#include <pthread.h>
+#include "../headerFiles/data_dir.h"
+
+/* DataPath: one joined path; the list only grows */
+typedef struct DataPath {
+    struct DataPath *next;
+    const char      *name;
+    char             path[];
+} DataPath;
+
+static pthread_mutex_t dataLock = PTHREAD_MUTEX_INITIALIZER;
+static char directory[DATA_DIR_MAX + 1] = DATA_DIR_DEFAULT;
+static int fixed = 0;                 // set once a path was handed out
+static DataPath *paths = NULL;
+
+/*
+ * setDataDir:
+ *   Replaces the default directory. A trailing '/' is dropped so paths
+ *   come out the same however the directory was written.
+ *
+ * RETURNS:
+ *   0 if it took effect, 1 otherwise.
+ */
+
+int setDataDir(const char *dir) {
+    size_t length = strlen(dir);
+    int status = 0;
+
+    while (length > 1 && dir[length - 1] == '/') {
+        length--;
+    }
+    if (length == 0 || length > DATA_DIR_MAX) {
+        return 1;
+    }
+
+    pthread_mutex_lock(&dataLock);
+    if (!fixed) {
+        memcpy(directory, dir, length);
+        directory[length] = '\0';
+    } else if (strlen(directory) != length || strncmp(directory, dir, length) != 0) {
+        status = 1;
+    }
+    pthread_mutex_unlock(&dataLock);
+    return status;
+}
+
+/* dataDir: the directory in use */
+const char *dataDir(void) {
+    pthread_mutex_lock(&dataLock);
+    fixed = 1;
+    pthread_mutex_unlock(&dataLock);
+    return directory;
+}
+
+/*
+ * dataPath:
+ *   Finds or builds "<directory>/<name>".
+ *
+ * RETURNS:
+ *   The path, or 'name' itself if there was no memory for it.
+ */
+
+const char *dataPath(const char *name) {
+    DataPath *entry;
+    size_t size;
+
+    pthread_mutex_lock(&dataLock);
+    fixed = 1;
+    for (entry = paths; entry != NULL; entry = entry->next) {
+        if (strcmp(entry->name, name) == 0) {
+            pthread_mutex_unlock(&dataLock);
+            return entry->path;
+        }
+    }
+
+    size = strlen(directory) + 1 + strlen(name) + 1;
+    entry = malloc(sizeof(DataPath) + size);
+    if (entry == NULL) {
+        pthread_mutex_unlock(&dataLock);
+        return name;
+    }
+    snprintf(entry->path, size, "%s/%s", directory, name);
+    entry->name = entry->path + strlen(directory) + 1;
+    entry->next = paths;
+    paths = entry;
+    pthread_mutex_unlock(&dataLock);
+    return entry->path;
+}
@@ -0,0 +1,398 @@
+/* dictionary.c
+ *
+ * Built-in word list, memory-mapped word store and hashed word index for
+ * the Wordex game.
+ *
+ * FUNCTIONALITY:
+ *  - packWord / unpackWord: convert between 5-letter strings and the
+ *    25-bit packed form used as the hash key
+ *  - the built-in list: packed words and their hash table generated into
+ *    dictionary_data.c at build time, so playing needs no word list file
+ *  - loadDictionary: maps a word list read-only, validates it once, and
+ *    builds an open-addressing hash table for O(1) membership checks.
+ *    Fixed-stride files (5 letters + newline per record) need no per-word
+ *    index at all; anything else gets one offset per distinct word.
+ *  - dictionaryWordAt: O(1) answer selection from either form
+ *  - getDictionary: process-wide dictionary shared by validateGuess and
+ *    setRandomWordAndCount; the built-in list unless setDictionaryPath
+ *    named a file first
+ *
+ * Built with -DNO_EMBEDDED_DICTIONARY (as tools/embed_dictionary is, since
+ * it generates the built-in list) getDictionary reads DICTIONARY_FILE.
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "../headerFiles/dictionary.h"
+#include "../headerFiles/data_dir.h"
+
+/* Every distinct 5-letter word there can be, so the most a file can index */
+#define MAX_WORDS (26 * 26 * 26 * 26 * 26)
+
+/* The shared dictionary, loaded once even if several threads ask at once */
+static Dictionary sharedDictionary;
+static pthread_once_t sharedOnce = PTHREAD_ONCE_INIT;
+static int sharedOk = 0;
+static int sharedStarted = 0;
+static const char *sharedPath = NULL;   // set by setDictionaryPath, NULL for the built-in list
+
+/*
+ * pack_letters:
+ *   Packs the first 5 bytes at 'p' without looking for a terminator.
+ *
+ * RETURNS:
+ *   The packed word, or 0 if any of the 5 bytes is not a letter.
+ */
+
+static uint32_t pack_letters(const char *p) {
+    uint32_t packed = 0;
+    int i;
+
+    for (i = 0; i < WORD_LENGTH; i++) {
+        int c = tolower((unsigned char) p[i]);
+
+        if (c < 'a' || c > 'z') {
+            return 0;
+        }
+        packed |= (uint32_t) (c - 'a' + 1) << (LETTER_BITS * i);
+    }
+    return packed;
+}
+
+/*
+ * packWord:
+ *   Packs a 5-letter word into 25 bits (5 bits per letter, 'a' = 1).
+ *
+ * PARAMETERS:
+ *   word - NUL-terminated word, any case
+ *
+ * RETURNS:
+ *   The packed word, or 0 if the word is not exactly 5 letters a-z.
+ */
+
+uint32_t packWord(const char *word) {
+    if (strnlen(word, WORD_LENGTH + 1) != WORD_LENGTH) {
+        return 0;
+    }
+    return pack_letters(word);
+}
+
+/*
+ * unpackWord:
+ *   Converts a packed word back into a lowercase string.
+ *
+ * PARAMETERS:
+ *   packed - value produced by packWord
+ *   out    - destination buffer of at least 6 characters
+ */
+
+void unpackWord(uint32_t packed, char *out) {
+    int i;
+
+    for (i = 0; i < WORD_LENGTH; i++) {
+        out[i] = (char) ('a' - 1 + ((packed >> (LETTER_BITS * i)) & 31));
+    }
+    out[WORD_LENGTH] = '\0';
+}
+
+/*
+ * insert_word:
+ *   Adds a packed word to a table of mask + 1 slots if it is not already
+ *   there.
+ *
+ * RETURNS:
+ *   1 if the word was inserted, 0 if it was a duplicate.
+ */
+
+static int insert_word(uint32_t *table, uint32_t mask, uint32_t packed) {
+    uint32_t slot = DICTIONARY_SLOT(packed, mask);
+
+    while (table[slot] != 0) {
+        if (table[slot] == packed) {
+            return 0;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    table[slot] = packed;
+    return 1;
+}
+
+/*
+ * dictionaryContains:
+ *   Probes the hash table for a packed word.
+ *
+ * RETURNS:
+ *   1 if present, 0 otherwise (including packed == 0).
+ */
+
+int dictionaryContains(const Dictionary *dict, uint32_t packed) {
+    uint32_t slot;
+
+    if (dict == NULL || packed == 0) {
+        return 0;
+    }
+
+    slot = DICTIONARY_SLOT(packed, dict->mask);
+    while (dict->table[slot] != 0) {
+        if (dict->table[slot] == packed) {
+            return 1;
+        }
+        slot = (slot + 1) & dict->mask;
+    }
+    return 0;
+}
+
+/*
+ * dictionaryPackedAt:
+ *   Reads word 'index' from the built-in list, or packs it directly from
+ *   the mapped file.
+ */
+
+uint32_t dictionaryPackedAt(const Dictionary *dict, int index) {
+    size_t offset;
+
+    if (dict->words != NULL) {
+        return dict->words[index];
+    }
+    if (dict->offsets != NULL) {
+        offset = dict->offsets[index];
+    } else {
+        offset = (size_t) index * RECORD_STRIDE;
+    }
+    return pack_letters(dict->base + offset);
+}
+
+/*
+ * dictionaryWordAt:
+ *   Copies word 'index' out as a lowercase string.
+ */
+
+void dictionaryWordAt(const Dictionary *dict, int index, char *out) {
+    unpackWord(dictionaryPackedAt(dict, index), out);
+}
+
+/*
+ * dictionaryHash:
+ *   FNV-1a over the 4 bytes of every packed word, in order.
+ */
+
+uint64_t dictionaryHash(const Dictionary *dict) {
+    uint64_t hash = 14695981039346656037ull;
+    int i, b;
+
+    for (i = 0; i < dict->count; i++) {
+        uint32_t packed = dictionaryPackedAt(dict, i);
+
+        for (b = 0; b < 4; b++) {
+            hash ^= (packed >> (8 * b)) & 0xff;
+            hash *= 1099511628211ull;
+        }
+    }
+    return hash;
+}
+
+/*
+ * index_words:
+ *   Walks the mapped file once, inserting every valid 5-letter line into the
+ *   hash table and recording its offset. If every line turned out to be a
+ *   distinct word at offset 6 * i the offsets are dropped again, because
+ *   the stride alone is enough to find any word.
+ *
+ * RETURNS:
+ *   0 on success, 1 if memory ran out.
+ */
+
+static int index_words(Dictionary *dict) {
+    const char *p = dict->base;
+    const char *end = dict->base + dict->size;
+    size_t lines = 0;
+    size_t words;
+    uint32_t size = 16;
+    uint32_t *table;
+    int fixedStride = 1;
+
+    // Count lines first so the table and offsets are allocated once
+    while (p < end) {
+        const char *nl = memchr(p, '\n', (size_t) (end - p));
+
+        lines = lines + 1;
+        p = (nl == NULL) ? end : nl + 1;
+    }
+
+    // Only distinct words are kept, however many lines repeat them
+    words = (lines < MAX_WORDS) ? lines : MAX_WORDS;
+    while (size < words * 2) {
+        size = size * 2;
+    }
+
+    table = calloc(size, sizeof(uint32_t));
+    dict->table = table;
+    dict->offsets = malloc(sizeof(uint32_t) * (words > 0 ? words : 1));
+    dict->mask = size - 1;
+
+    if (table == NULL || dict->offsets == NULL) {
+        return 1;
+    }
+
+    p = dict->base;
+    while (p < end) {
+        const char *nl = memchr(p, '\n', (size_t) (end - p));
+        size_t len = (nl == NULL) ? (size_t) (end - p) : (size_t) (nl - p);
+        uint32_t packed = 0;
+
+        if (len > 0 && p[len - 1] == '\r') {
+            len = len - 1;
+        }
+        if (len == WORD_LENGTH) {
+            packed = pack_letters(p);
+        }
+
+        if (packed != 0 && insert_word(table, dict->mask, packed)) {
+            if ((size_t) (p - dict->base) != (size_t) dict->count * RECORD_STRIDE) {
+                fixedStride = 0;
+            }
+            dict->offsets[dict->count] = (uint32_t) (p - dict->base);
+            dict->count = dict->count + 1;
+        } else {
+            fixedStride = 0;   // blank, malformed or repeated line
+        }
+
+        p = (nl == NULL) ? end : nl + 1;
+    }
+
+    if (fixedStride) {
+        free(dict->offsets);
+        dict->offsets = NULL;
+    }
+    return 0;
+}
+
+/*
+ * loadDictionary:
+ *   Maps 'path' read-only and indexes it. The words themselves are never
+ *   copied; only the hash table (and offsets for irregular files) are built.
+ *
+ * RETURNS:
+ *   0 on success, 1 if the file could not be opened, mapped or indexed.
+ */
+
+int loadDictionary(const char *path, Dictionary *dict) {
+    struct stat st;
+    void *map;
+    int fd;
+
+    memset(dict, 0, sizeof(*dict));
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return 1;
+    }
+
+    if (fstat(fd, &st) != 0 || st.st_size <= 0 || (uint64_t) st.st_size > UINT32_MAX) {
+        close(fd);
+        return 1;
+    }
+
+    map = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);   // the mapping stays valid after the descriptor is closed
+
+    if (map == MAP_FAILED) {
+        return 1;
+    }
+
+    dict->base = map;
+    dict->size = (size_t) st.st_size;
+
+    if (index_words(dict) != 0) {
+        freeDictionary(dict);
+        return 1;
+    }
+    return 0;
+}
+
+/*
+ * freeDictionary:
+ *   Unmaps the word list, releases the index and resets dict to empty.
+ */
+
+void freeDictionary(Dictionary *dict) {
+    if (dict->words == NULL) {
+        if (dict->base != NULL) {
+            munmap((void *) dict->base, dict->size);
+        }
+        free(dict->offsets);
+        free((void *) dict->table);
+    }
+    memset(dict, 0, sizeof(*dict));
+}
+
+/*
+ * load_shared_dictionary:
+ *   pthread_once callback: maps the file given to setDictionaryPath, or
+ *   points the shared dictionary at the built-in list.
+ */
+
+static void load_shared_dictionary(void) {
+    sharedStarted = 1;
+
+#ifdef NO_EMBEDDED_DICTIONARY
+    if (sharedPath == NULL) {
+        sharedPath = dataPath(DICTIONARY_FILE);
+    }
+#endif
+    if (sharedPath != NULL) {
+        sharedOk = (loadDictionary(sharedPath, &sharedDictionary) == 0);
+        return;
+    }
+
+#ifndef NO_EMBEDDED_DICTIONARY
+    memset(&sharedDictionary, 0, sizeof(sharedDictionary));
+    sharedDictionary.words = embeddedWords;
+    sharedDictionary.count = embeddedWordCount;
+    sharedDictionary.table = embeddedTable;
+    sharedDictionary.mask = embeddedMask;
+    sharedOk = 1;
+#endif
+}
+
+/*
+ * setDictionaryPath:
+ *   Names the word list file getDictionary should load instead of the
+ *   built-in one. Called from main, before any thread is started.
+ *
+ * RETURNS:
+ *   0 if it took effect, 1 if the dictionary was already in use.
+ */
+
+int setDictionaryPath(const char *path) {
+    if (sharedStarted) {
+        return 1;
+    }
+    sharedPath = path;
+    return 0;
+}
+
+/*
+ * getDictionary:
+ *   Returns the process-wide dictionary, set up the first time it is
+ *   needed. Later calls reuse the same table.
+ *
+ * RETURNS:
+ *   Pointer to the shared dictionary, or NULL if it could not be loaded.
+ */
+
+const Dictionary *getDictionary(void) {
+    pthread_once(&sharedOnce, load_shared_dictionary);
+
+    if (!sharedOk) {
+        return NULL;
+    }
+    return &sharedDictionary;
+}
@@ -0,0 +1,269 @@
+/* feedback.c
+ *
+ * Feedback scoring kernel for the Wordex game.
+ *
+ * FUNCTIONALITY:
+ *  - scoreGuess: branch-free scoring of one packed guess against one packed
+ *    answer, returning a base-3 pattern code
+ *  - scoreBatch: scores one guess against many answers at once, 8 answers
+ *    per step with AVX2 or 4 with SSE2, picked at runtime
+ *
+ * How duplicates are scored:
+ *   A position is green when the letters match. A non-green position i is
+ *   yellow when the answer still has an unclaimed copy of the letter, i.e.
+ *   when the number of non-green answer positions holding that letter is
+ *   greater than the number of earlier non-green guess positions with the
+ *   same letter. This is the same result the two-pass loop in interface()
+ *   produces, but needs no branches or scratch arrays.
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#include "../headerFiles/feedback.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HAVE_X86_SIMD 1
+#endif
+
+/* Powers of three for each letter position */
+static const int pow3[WORD_LENGTH] = {1, 3, 9, 27, 81};
+
+/*
+ * letter_at:
+ *   Extracts the 5-bit letter code at 'position' from a packed word.
+ */
+
+static inline uint32_t letter_at(uint32_t packed, int position) {
+    return (packed >> (LETTER_BITS * position)) & 31;
+}
+
+/*
+ * scoreGuess:
+ *   Scalar kernel. All comparisons produce 0/1 values that are summed,
+ *   so the loops have a fixed trip count and no data-dependent branches.
+ *
+ * RETURNS:
+ *   Pattern code 0 - 242.
+ */
+
+uint8_t scoreGuess(uint32_t guess, uint32_t answer) {
+    uint32_t g[WORD_LENGTH];
+    uint32_t a[WORD_LENGTH];
+    int green[WORD_LENGTH];
+    int code = 0;
+    int i, k;
+
+    for (i = 0; i < WORD_LENGTH; i++) {
+        g[i] = letter_at(guess, i);
+        a[i] = letter_at(answer, i);
+        green[i] = (g[i] == a[i]);
+    }
+
+    for (i = 0; i < WORD_LENGTH; i++) {
+        int available = 0;   // unclaimed copies of g[i] in the answer
+        int earlier = 0;     // earlier non-green guesses of the same letter
+
+        for (k = 0; k < WORD_LENGTH; k++) {
+            available += !green[k] & (a[k] == g[i]);
+        }
+        for (k = 0; k < i; k++) {
+            earlier += !green[k] & (g[k] == g[i]);
+        }
+
+        code += green[i] * DIGIT_GREEN * pow3[i];
+        code += (!green[i] & (available > earlier)) * DIGIT_YELLOW * pow3[i];
+    }
+
+    return (uint8_t) code;
+}
+
+/*
+ * patternDigit:
+ *   Reads the base-3 digit for one position out of a pattern code.
+ */
+
+int patternDigit(uint8_t pattern, int position) {
+    return (pattern / pow3[position]) % 3;
+}
+
+/*
+ * scoreBatchScalar:
+ *   Reference batch version, one answer at a time.
+ */
+
+void scoreBatchScalar(uint32_t guess, const uint32_t *answers, size_t n, uint8_t *out) {
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        out[i] = scoreGuess(guess, answers[i]);
+    }
+}
+
+#ifdef HAVE_X86_SIMD
+
+/*
+ * The SIMD kernels below follow scoreGuess lane by lane. Comparison masks
+ * are -1 / 0, so summing masks counts *negatively*: "available > earlier"
+ * becomes "earlierNeg > availableNeg". Pattern digits are added by masking
+ * the per-position constants, which avoids any vector multiply.
+ */
+
+/*
+ * score_batch_sse2:
+ *   Scores 4 answers per iteration; the tail falls back to scoreGuess.
+ */
+
+static void score_batch_sse2(uint32_t guess, const uint32_t *answers, size_t n, uint8_t *out) {
+    __m128i g[WORD_LENGTH];
+    int same[WORD_LENGTH][WORD_LENGTH];
+    const __m128i letterMask = _mm_set1_epi32(31);
+    size_t base = 0;
+    int i, k;
+
+    for (i = 0; i < WORD_LENGTH; i++) {
+        g[i] = _mm_set1_epi32((int) letter_at(guess, i));
+        for (k = 0; k < WORD_LENGTH; k++) {
+            same[i][k] = (letter_at(guess, i) == letter_at(guess, k));
+        }
+    }
+
+    for (; base + 4 <= n; base += 4) {
+        __m128i word = _mm_loadu_si128((const __m128i *) (answers + base));
+        __m128i a[WORD_LENGTH];
+        __m128i green[WORD_LENGTH];
+        __m128i code = _mm_setzero_si128();
+        uint32_t lanes[4];
+
+        a[0] = _mm_and_si128(word, letterMask);
+        a[1] = _mm_and_si128(_mm_srli_epi32(word, 5), letterMask);
+        a[2] = _mm_and_si128(_mm_srli_epi32(word, 10), letterMask);
+        a[3] = _mm_and_si128(_mm_srli_epi32(word, 15), letterMask);
+        a[4] = _mm_and_si128(_mm_srli_epi32(word, 20), letterMask);
+
+        for (i = 0; i < WORD_LENGTH; i++) {
+            green[i] = _mm_cmpeq_epi32(a[i], g[i]);
+        }
+
+        for (i = 0; i < WORD_LENGTH; i++) {
+            __m128i availableNeg = _mm_setzero_si128();
+            __m128i earlierNeg = _mm_setzero_si128();
+            __m128i yellow;
+
+            for (k = 0; k < WORD_LENGTH; k++) {
+                availableNeg = _mm_add_epi32(availableNeg,
+                                   _mm_andnot_si128(green[k], _mm_cmpeq_epi32(a[k], g[i])));
+            }
+            for (k = 0; k < i; k++) {
+                if (same[i][k]) {
+                    earlierNeg = _mm_add_epi32(earlierNeg, _mm_andnot_si128(green[k], _mm_set1_epi32(-1)));
+                }
+            }
+
+            yellow = _mm_andnot_si128(green[i], _mm_cmpgt_epi32(earlierNeg, availableNeg));
+            code = _mm_add_epi32(code, _mm_and_si128(green[i], _mm_set1_epi32(DIGIT_GREEN * pow3[i])));
+            code = _mm_add_epi32(code, _mm_and_si128(yellow, _mm_set1_epi32(DIGIT_YELLOW * pow3[i])));
+        }
+
+        _mm_storeu_si128((__m128i *) lanes, code);
+        for (i = 0; i < 4; i++) {
+            out[base + i] = (uint8_t) lanes[i];
+        }
+    }
+
+    scoreBatchScalar(guess, answers + base, n - base, out + base);
+}
+
+/*
+ * score_batch_avx2:
+ *   Same kernel as score_batch_sse2 with 8 answers per iteration.
+ */
+
+__attribute__((target("avx2")))
+static void score_batch_avx2(uint32_t guess, const uint32_t *answers, size_t n, uint8_t *out) {
+    __m256i g[WORD_LENGTH];
+    int same[WORD_LENGTH][WORD_LENGTH];
+    const __m256i letterMask = _mm256_set1_epi32(31);
+    size_t base = 0;
+    int i, k;
+
+    for (i = 0; i < WORD_LENGTH; i++) {
+        g[i] = _mm256_set1_epi32((int) letter_at(guess, i));
+        for (k = 0; k < WORD_LENGTH; k++) {
+            same[i][k] = (letter_at(guess, i) == letter_at(guess, k));
+        }
+    }
+
+    for (; base + 8 <= n; base += 8) {
+        __m256i word = _mm256_loadu_si256((const __m256i *) (answers + base));
+        __m256i a[WORD_LENGTH];
+        __m256i green[WORD_LENGTH];
+        __m256i code = _mm256_setzero_si256();
+        uint32_t lanes[8];
+
+        a[0] = _mm256_and_si256(word, letterMask);
+        a[1] = _mm256_and_si256(_mm256_srli_epi32(word, 5), letterMask);
+        a[2] = _mm256_and_si256(_mm256_srli_epi32(word, 10), letterMask);
+        a[3] = _mm256_and_si256(_mm256_srli_epi32(word, 15), letterMask);
+        a[4] = _mm256_and_si256(_mm256_srli_epi32(word, 20), letterMask);
+
+        for (i = 0; i < WORD_LENGTH; i++) {
+            green[i] = _mm256_cmpeq_epi32(a[i], g[i]);
+        }
+
+        for (i = 0; i < WORD_LENGTH; i++) {
+            __m256i availableNeg = _mm256_setzero_si256();
+            __m256i earlierNeg = _mm256_setzero_si256();
+            __m256i yellow;
+
+            for (k = 0; k < WORD_LENGTH; k++) {
+                availableNeg = _mm256_add_epi32(availableNeg,
+                                   _mm256_andnot_si256(green[k], _mm256_cmpeq_epi32(a[k], g[i])));
+            }
+            for (k = 0; k < i; k++) {
+                if (same[i][k]) {
+                    earlierNeg = _mm256_add_epi32(earlierNeg, _mm256_andnot_si256(green[k], _mm256_set1_epi32(-1)));
+                }
+            }
+
+            yellow = _mm256_andnot_si256(green[i], _mm256_cmpgt_epi32(earlierNeg, availableNeg));
+            code = _mm256_add_epi32(code, _mm256_and_si256(green[i], _mm256_set1_epi32(DIGIT_GREEN * pow3[i])));
+            code = _mm256_add_epi32(code, _mm256_and_si256(yellow, _mm256_set1_epi32(DIGIT_YELLOW * pow3[i])));
+        }
+
+        _mm256_storeu_si256((__m256i *) lanes, code);
+        for (i = 0; i < 8; i++) {
+            out[base + i] = (uint8_t) lanes[i];
+        }
+    }
+
+    score_batch_sse2(guess, answers + base, n - base, out + base);
+}
+
+#endif
+
+/*
+ * scoreBatch:
+ *   Picks the widest kernel this CPU supports. The check is done once and
+ *   cached, so the per-call cost is a single branch.
+ */
+
+void scoreBatch(uint32_t guess, const uint32_t *answers, size_t n, uint8_t *out) {
+#ifdef HAVE_X86_SIMD
+    static int hasAvx2 = -1;
+
+    if (hasAvx2 < 0) {
+        __builtin_cpu_init();
+        hasAvx2 = __builtin_cpu_supports("avx2") ? 1 : 0;
+    }
+
+    if (hasAvx2) {
+        score_batch_avx2(guess, answers, n, out);
+    } else {
+        score_batch_sse2(guess, answers, n, out);
+    }
+#else
+    scoreBatchScalar(guess, answers, n, out);
+#endif
+}
@@ -1,16 +1,17 @@
 #include "../headerFiles/game_logic.h"
+#include "../headerFiles/hint.h"
+#include "../headerFiles/render.h"
+#include "../headerFiles/profile.h"
 
-#ifdef TESTING
-    #define CLEAR_SCREEN()
-#else
-    #define CLEAR_SCREEN() system("clear")
-#endif
+#define GUESS_PROMPT "Enter a 5-letter word: "
 
 /*
  * setRandomWordAndCount
  *
- * Selects a random 5-letter word from the dictionary and counts how many
- * valid words exist in the file. In TESTING mode, the function bypasses
+ * Selects a random 5-letter word from the shared dictionary and reports how
+ * many distinct words it holds. The word is read straight out of the mapped
+ * word list, so starting a game costs the same however long the list is.
+ * In TESTING mode, the function bypasses
  * randomness and uses a fixed word.
  *
  * Parameters:
@@ -21,37 +22,22 @@
  *   This function does not return a value.
  */
 void setRandomWordAndCount(char *randomWord, int *count) {
+    PROFILE_SCOPE(PROFILE_RANDOM_WORD);
+
     #ifdef TESTING  
         strcpy(randomWord, "banes");
         *count = 1;
         return;
     #endif
 
-    FILE *file = fopen("textFiles/words.txt", "r");
-    if (!file) {
+    const Dictionary *dict = getDictionary();
+    if (dict == NULL) {
         printf("Could not open file.\n");
         *count = 0;
         return;
     }
 
-    char words[10000][6];
-    char line[100];
-    *count = 0;
-
-    while (fgets(line, sizeof(line), file)) {
-
-        // remove newline
-        line[strcspn(line, "\n")] = '\0';
-
-        if (strlen(line) == 5) {
-            strcpy(words[*count], line);
-            (*count)++;
-
-            if (*count >= 10000) break;
-        }
-    }
-
-    fclose(file);
+    *count = dict->count;
 
     if (*count == 0) {
         printf("No 5-letter words in the file.\n");
@@ -60,7 +46,7 @@ void setRandomWordAndCount(char *randomWord, int *count) {
 
     srand(time(NULL));
     int index = rand() % *count;
-    strcpy(randomWord, words[index]);
+    dictionaryWordAt(dict, index, randomWord);   // O(1): no per-game copy of the list
 }
 
 /*
@@ -81,63 +67,92 @@ void convertToLower(char *str) {
     }
 }
 
+/*
+ * checkGuess
+ *
+ * Checks a guess against the rules alone: exactly 5 letters, and a word in
+ * the in-memory dictionary. It neither reads nor prints, so the terminal
+ * game, the JSON-lines protocol and libwordex all share it.
+ *
+ * Parameters:
+ *   typed — the guess as typed, any case
+ *   word  — receives the lowercased guess when it is valid (6 bytes)
+ *
+ * Return:
+ *   GUESS_OK, GUESS_BAD_LENGTH or GUESS_NOT_A_WORD.
+ */
+int checkGuess(const char *typed, char *word) {
+    char lower[6];
+    int i;
+
+    if (strlen(typed) != 5) {
+        return GUESS_BAD_LENGTH;
+    }
+    for (i = 0; i < 5; i++) {
+        if (!isalpha((unsigned char) typed[i])) {
+            return GUESS_NOT_A_WORD;
+        }
+        lower[i] = (char) tolower((unsigned char) typed[i]);
+    }
+    lower[5] = '\0';
+
+    // Look the packed word up in the shared in-memory dictionary
+    if (!dictionaryContains(getDictionary(), packWord(lower))) {
+        return GUESS_NOT_A_WORD;
+    }
+    memcpy(word, lower, sizeof(lower));
+    return GUESS_OK;
+}
+
 /*
  * validateGuess
  *
  * Continuously prompts the user for a 5-letter word until a valid dictionary
  * word is entered. Converts the guess to lowercase and stores it if valid.
+ * Membership is checked against the in-memory dictionary, so the word list
+ * is only read once per process. Typing "?" instead of a word prints the
+ * best next guess for the round in progress. Every line it prints goes
+ * under the board, so each is passed on to the renderer (see render.c).
  *
  * Parameters:
  *   setWord — destination array for the validated 5-letter guesses
  *   counter — pointer to the number of successful guesses made so far
+ *   game    — the round in progress, used for hints (may be NULL)
  *
  * Return:
  *   This function does not return a value.
  */
-void validateGuess(char *setWord, int *counter) {
+void validateGuess(char *setWord, int *counter, const GameState *game) {
 
     // Big array to hold whatever the user types
     char userGuess[1000]; 
     int valid = false;  
     
     while (!valid) {
-        printf("Enter a 5-letter word: ");
+        printf(GUESS_PROMPT);
         scanf("%s", userGuess);  
-        
-        if (strlen(userGuess) != 5) {
-            printf("That word has %ld letters. Please enter exactly 5 letters.\n", strlen(userGuess));
-            continue;  
-        }
+        renderScreenNoteLine((int) (strlen(GUESS_PROMPT) + strlen(userGuess)));   // echoed by the terminal
 
-        convertToLower(userGuess);
-        
-        FILE *file = fopen("textFiles/words.txt", "r");
-        
-        char line[6];
-        int found = false;  
-        
-        // Read the file line by line
-        while (fgets(line, sizeof(line), file) != NULL) {
-
-            // Remove the newline character
-            line[strcspn(line, "\n")] = '\0';  
-            convertToLower(line);
-
-            // Compare the user's word with the word from the file
-            if (strcmp(line, userGuess) == 0) {
-                found = true;  
-                break;  
-            }
+        // "?" asks for the highest-information next guess
+        if (strcmp(userGuess, HINT_KEY) == 0 && game != NULL) {
+            renderScreenNoteLine(printHint(game) - 1);
+            continue;
         }
-        
-        fclose(file);  
-        
-        if (found) {
-            strcpy(setWord, userGuess);  
+
+        // Time the checks, not the wait for the player to type
+        PROFILE_SCOPE(PROFILE_VALIDATE_GUESS);
+
+        int result = checkGuess(userGuess, setWord);
+
+        if (result == GUESS_BAD_LENGTH) {
+            renderScreenNoteLine(printf("That word has %ld letters. Please enter exactly 5 letters.\n",
+                                        strlen(userGuess)) - 1);
+        } else if (result == GUESS_NOT_A_WORD) {
+            convertToLower(userGuess);
+            renderScreenNoteLine(printf("Sorry, %s is not in our word list. Try another word.\n", userGuess) - 1);
+        } else {
             (*counter)++;  
             valid = true;  
-        } else {
-            printf("Sorry, %s is not in our word list. Try another word.\n", userGuess);
         }
     }
 }
@@ -146,7 +161,8 @@ void validateGuess(char *setWord, int *counter) {
  * defaultInterface
  *
  * Displays the empty WorDex game board and keyboard status before any guesses
- * have been entered. Used at the beginning of a game or when resetting the UI.
+ * have been entered. Used at the beginning of a game or when resetting the UI,
+ * so the screen is cleared and the whole frame drawn (see render.c).
  *
  * Parameters:
  *   None
@@ -155,209 +171,121 @@ void validateGuess(char *setWord, int *counter) {
  *   This function does not return a value.
  */
 void defaultInterface() {
-    CLEAR_SCREEN();
-    printf("\n╔═══════════════════════════════════════════════╗\n");
-    printf("║                    WORDEX                     ║\n");
-    printf("╠═══════════════════════════════════════════════╣\n");
-    printf("║       _       _       _       _       _       ║\n");
-    printf("║       _       _       _       _       _       ║\n");
-    printf("║       _       _       _       _       _       ║\n");
-    printf("║       _       _       _       _       _       ║\n");
-    printf("║       _       _       _       _       _       ║\n");
-    printf("║       _       _       _       _       _       ║\n");
-    printf("╚═══════════════════════════════════════════════╝\n\n");
-
-    printf("\n╔═══════════════════════════════════════════════╗\n");
-    printf("║              KEYBOARD STATUS                  ║\n");
-    printf("╠═══════════════════════════════════════════════╣\n");
-
-    char letters[] = "qwertyuiopasdfghjklzxcvbnm";
-
-    for (int i = 0; i < 26; i++) {
-
-        if (letters[i] == 'q') {
-            printf("║    ");
-        } else if (letters[i] == 'a') {
-            printf("║      ");
-        } else if (letters[i] == 'z') {
-            printf("║         ");
-        }
+    PROFILE_SCOPE(PROFILE_INTERFACE);
 
-        printf(" %c  ", toupper(letters[i]));  
+    renderScreenReset();
+    renderScreen(NULL);
+}
 
-        if (letters[i] == 'p') {
-            printf("   ║\n");
-        } else if (letters[i] == 'l') {
-            printf("     ║\n");
-        } else if (letters[i] == 'm') {
-            printf("          ║\n");
-        }
-    }
+/*
+ * gameStateInit
+ *
+ * Starts a new game against the given answer: no guesses, no patterns and
+ * an untouched keyboard.
+ *
+ * Parameters:
+ *   game   — the state to initialise
+ *   answer — the 5-letter answer for this round
+ *
+ * Return:
+ *   This function does not return a value.
+ */
+void gameStateInit(GameState *game, const char *answer) {
+    memset(game, 0, sizeof(*game));
+
+    strncpy(game->answerWord, answer, 5);
+    game->answerWord[5] = '\0';
+    convertToLower(game->answerWord);
+    game->answer = packWord(game->answerWord);
 
-    printf("╚═══════════════════════════════════════════════╝\n\n");
+    // Remember which letters appear anywhere in the answer for the keyboard
+    for (int i = 0; i < 5; i++) {
+        game->answerLetters |= letterBit(game->answerWord[i]);
+    }
 }
 
 /*
- * interface
+ * gameStateSubmit
  *
- * Displays the full WorDex game interface, including:
- *   - all previous guesses with colour coding (green, yellow, gray)
- *   - the updated on-screen keyboard showing discovered letter statuses
+ * Records one submitted guess. The guess is scored exactly once here and
+ * the keyboard masks are updated from that single result, so nothing has
+ * to be recomputed when the board is drawn again.
  *
- * Recalculates letter colouring based on all guesses stored so far.
+ *   - a letter is green once it has been guessed in the right position
+ *   - otherwise it is yellow if it appears anywhere in the answer
+ *   - otherwise it is gray
  *
  * Parameters:
- *   userGuesses   — 2D array containing all previous 5-letter guesses
- *   counter       — pointer to the number of valid guesses made
- *   randomWord    — the correct answer word for this round
- *   lettersGreen  — array containing letters confirmed in correct position
- *   lettersYellow — array containing letters in word but wrong position
- *   lettersGray   — array containing letters not in the word
+ *   game  — the game being played (must not be over)
+ *   guess — a validated 5-letter guess
  *
  * Return:
- *   This function does not return a value.
+ *   The pattern code for the guess, or PATTERN_COUNT if the game was
+ *   already over.
  */
-void interface(char userGuesses[][6], int *counter, char *randomWord, char *lettersGreen, char *lettersYellow, char *lettersGray) {
-    CLEAR_SCREEN();
-
-    if (*counter > 0) {
-
-        lettersGreen[0] = '\0';
-        lettersYellow[0] = '\0';
-        lettersGray[0] = '\0';
-        
-        for (int guessNum = 0; guessNum < *counter; guessNum++) {
-            for (int i = 0; i < 5; i++) {
-                char letter = userGuesses[guessNum][i];
-                
-                if (strchr(lettersGreen, letter) != NULL) {
-                    continue;
-                }
-                
-                if (letter == randomWord[i]) {
-                    int len = strlen(lettersGreen);
-                    lettersGreen[len] = letter;
-                    lettersGreen[len + 1] = '\0';
-                    continue;
-                }
-                
-                if (strchr(lettersYellow, letter) != NULL) {
-                    continue;
-                }
-                
-                bool foundInWord = false;
-                for (int j = 0; j < 5; j++) {
-                    if (letter == randomWord[j]) {
-                        foundInWord = true;
-                        break;
-                    }
-                }
-                
-                if (foundInWord) {
-                    int len = strlen(lettersYellow);
-                    lettersYellow[len] = letter;
-                    lettersYellow[len + 1] = '\0';
-                } else {
-                    if (strchr(lettersGray, letter) == NULL) {
-                        int len = strlen(lettersGray);
-                        lettersGray[len] = letter;
-                        lettersGray[len + 1] = '\0';
-                    }
-                }
-            }
-        }
+uint8_t gameStateSubmit(GameState *game, const char *guess) {
+    if (gameStateOver(game)) {
+        return PATTERN_COUNT;
     }
 
-    printf("\n╔═══════════════════════════════════════════════╗\n");
-    printf("║                    WORDEX                     ║\n");
-    printf("╠═══════════════════════════════════════════════╣\n");
-
-    for (int row = 0; row < 6; row++) {
-        printf("║       ");
-        
-        if (row < *counter) {
-            char colours[5];
-            int available[5];
-            
-            for (int k = 0; k < 5; k++) {
-                available[k] = 1;
-                colours[k] = 'X';
-            }
-            
-            for (int col = 0; col < 5; col++) {
-                if (userGuesses[row][col] == randomWord[col]) {
-                    colours[col] = 'G';
-                    available[col] = 0;
-                }
-            }
-            
-            for (int col = 0; col < 5; col++) {
-                if (colours[col] == 'X') {
-                    char currentLetter = userGuesses[row][col];
-                    
-                    for (int j = 0; j < 5; j++) {
-                        if (available[j] && currentLetter == randomWord[j]) {
-                            colours[col] = 'Y';
-                            available[j] = 0;
-                            break;
-                        }
-                    }
-                }
-            }
-            
-            for (int col = 0; col < 5; col++) {
-                char currentLetter = userGuesses[row][col];
-                
-                if (colours[col] == 'G') {
-                    printf("\033[32m%c\033[0m       ", toupper(currentLetter));
-                } else if (colours[col] == 'Y') {
-                    printf("\033[33m%c\033[0m       ", toupper(currentLetter));
-                } else {
-                    printf("\033[90m%c\033[0m       ", toupper(currentLetter));
-                }
-            }
-        } else {
-            printf("_       _       _       _       _       ");
-        }
-        
-        printf("║\n");
-    }
+    int row = game->guessCount;
 
-    printf("╚═══════════════════════════════════════════════╝\n\n");
+    strncpy(game->guessWords[row], guess, 5);
+    game->guessWords[row][5] = '\0';
+    convertToLower(game->guessWords[row]);
 
-    char letters[] = "qwertyuiopasdfghjklzxcvbnm";
+    game->guesses[row] = packWord(game->guessWords[row]);
+    game->patterns[row] = scoreGuess(game->guesses[row], game->answer);
 
-    printf("\n╔═══════════════════════════════════════════════╗\n");
-    printf("║              KEYBOARD STATUS                  ║\n");
-    printf("╠═══════════════════════════════════════════════╣\n");
+    for (int i = 0; i < 5; i++) {
+        uint32_t bit = letterBit(game->guessWords[row][i]);
 
-    for (int i = 0; i < 26; i++) {
-        if (letters[i] == 'q') {
-            printf("║    ");
-        } else if (letters[i] == 'a') {
-            printf("║      ");
-        } else if (letters[i] == 'z') {
-            printf("║         ");
-        }
-        
-        if (strchr(lettersGreen, letters[i]) != NULL) {
-            printf(" \033[32m%c\033[0m  ", toupper(letters[i]));
-        } else if (strchr(lettersYellow, letters[i]) != NULL) {
-            printf(" \033[33m%c\033[0m  ", toupper(letters[i]));
-        } else if (strchr(lettersGray, letters[i]) != NULL) {
-            printf(" \033[90m%c\033[0m  ", toupper(letters[i]));
+        if (patternDigit(game->patterns[row], i) == DIGIT_GREEN) {
+            game->keysGreen |= bit;
+        } else if (game->answerLetters & bit) {
+            game->keysYellow |= bit;
         } else {
-            printf(" %c  ", toupper(letters[i]));
+            game->keysGray |= bit;
         }
+    }
 
-        if (letters[i] == 'p') {
-            printf("   ║\n");
-        } else if (letters[i] == 'l') {
-            printf("     ║\n");
-        } else if (letters[i] == 'm') {
-            printf("          ║\n");
-        }
+    game->guessCount++;
+    if (game->patterns[row] == PATTERN_WIN) {
+        game->won = 1;
     }
+    return game->patterns[row];
+}
+
+/*
+ * gameStateOver
+ *
+ * Return:
+ *   1 if the answer has been found or all guesses are used, 0 otherwise.
+ */
+int gameStateOver(const GameState *game) {
+    return game->won || game->guessCount >= MAX_GUESSES;
+}
 
-    printf("╚═══════════════════════════════════════════════╝\n\n");
-}
\ No newline at end of file
+/*
+ * interface
+ *
+ * Displays the full WorDex game interface, including:
+ *   - all previous guesses with colour coding (green, yellow, gray)
+ *   - the updated on-screen keyboard showing discovered letter statuses
+ *
+ * Only reads the game state: row patterns and keyboard masks were already
+ * computed by gameStateSubmit when each guess was entered. On a terminal
+ * only the cells that changed since the last frame are redrawn, in one
+ * write (see render.c).
+ *
+ * Parameters:
+ *   game — the game being played
+ *
+ * Return:
+ *   This function does not return a value.
+ */
+void interface(const GameState *game) {
+    PROFILE_SCOPE(PROFILE_INTERFACE);
+
+    renderScreen(game);
+}
@@ -0,0 +1,376 @@
+/* hint.c
+ *
+ * Entropy-based hint engine for the Wordex game.
+ *
+ * FUNCTIONALITY:
+ *  - filterCandidates: keeps only the answers that agree with every pattern
+ *    shown so far
+ *  - bestGuess: for each allowed guess, builds the histogram of patterns it
+ *    would produce over the candidates and picks the guess whose histogram
+ *    has the highest entropy (the most expected information)
+ *  - printHint: what the player sees after typing '?' instead of a guess
+ *
+ * Keeping it fast:
+ *  - guesses are split across worker threads, each keeping its own best
+ *  - pattern rows come from the mapped pattern matrix when it is available,
+ *    otherwise from the SIMD batch kernel
+ *  - guesses made only of letters already known to be gray are skipped,
+ *    since every answer would give them the same pattern
+ *  - once a candidate reaches the largest entropy that is possible for
+ *    this many candidates, nothing after it in the dictionary can win, so
+ *    workers stop when they pass the lowest such index; the result is the
+ *    same as scoring every guess, whichever thread gets there first
+ *  - c * log2(c) is tabulated once per hint and only the pattern buckets
+ *    a guess actually produced are summed
+ *  - the opening hint never changes for a dictionary, so it is cached
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "../headerFiles/hint.h"
+#include "../headerFiles/profile.h"
+
+/* Slack used when comparing entropies computed in floating point */
+#define ENTROPY_EPSILON 1e-9
+
+/* Cached opening hint for the shared dictionary */
+static Hint openingHint;
+static int openingCached = 0;
+static pthread_mutex_t openingLock = PTHREAD_MUTEX_INITIALIZER;
+
+/* HintJob:
+ *   Shared inputs plus one worker's result. Worker t scores guesses
+ *   t, t + stride, t + 2 * stride, ...
+ */
+struct HintJob {
+    const Dictionary    *dict;
+    const PatternMatrix *matrix;       // NULL when patterns are computed
+    const uint32_t      *packed;       // every dictionary word, packed
+    const int           *candidates;
+    const uint32_t      *candPacked;
+    const char          *isCandidate;  // per dictionary index
+    const double        *countLog;     // countLog[c] = c * log2(c)
+    int                  candCount;
+    uint32_t             grayLetters;
+    double               bound;        // best entropy possible
+    int                 *stopAt;       // lowest perfect candidate found so far
+    int                  first;
+    int                  stride;
+
+    int                  bestIndex;
+    double               bestEntropy;
+};
+
+/*
+ * word_letters:
+ *   Keyboard-style letter mask (bit 0 = 'a') of a packed word.
+ */
+
+static uint32_t word_letters(uint32_t packed) {
+    uint32_t mask = 0;
+    int i;
+
+    for (i = 0; i < WORD_LENGTH; i++) {
+        mask |= (uint32_t) 1 << (((packed >> (LETTER_BITS * i)) & 31) - 1);
+    }
+    return mask;
+}
+
+/*
+ * better_guess:
+ *   Orders two guesses: higher entropy first, then guesses that could
+ *   still be the answer, then the lower dictionary index.
+ */
+
+static int better_guess(const struct HintJob *job, int index, double entropy,
+                        int bestIndex, double bestEntropy) {
+    if (bestIndex < 0 || entropy > bestEntropy + ENTROPY_EPSILON) {
+        return 1;
+    }
+    if (entropy < bestEntropy - ENTROPY_EPSILON) {
+        return 0;
+    }
+    if (job->isCandidate[index] != job->isCandidate[bestIndex]) {
+        return job->isCandidate[index];
+    }
+    return index < bestIndex;
+}
+
+/*
+ * score_guesses:
+ *   Thread entry point: entropy of every guess in this worker's share.
+ */
+
+static void *score_guesses(void *arg) {
+    struct HintJob *job = arg;
+    int counts[PATTERN_COUNT];
+    uint8_t touched[PATTERN_COUNT];
+    uint8_t *row = NULL;
+    int g, c;
+
+    if (job->matrix == NULL) {
+        row = malloc((size_t) job->candCount);
+    }
+
+    memset(counts, 0, sizeof(counts));
+    job->bestIndex = -1;
+    job->bestEntropy = 0.0;
+
+    for (g = job->first; g < job->dict->count && g < __atomic_load_n(job->stopAt, __ATOMIC_RELAXED);
+         g += job->stride) {
+        const uint8_t *patterns;
+        int used = 0;
+        double sum = 0.0;
+        double entropy;
+
+        if ((word_letters(job->packed[g]) & ~job->grayLetters) == 0) {
+            continue;   // only gray letters: same pattern for every answer
+        }
+
+        if (job->matrix != NULL) {
+            patterns = job->matrix->cells + (size_t) g * job->matrix->count;
+        } else {
+            scoreBatch(job->packed[g], job->candPacked, (size_t) job->candCount, row);
+            patterns = row;
+        }
+
+        // Histogram, remembering which of the 243 buckets were touched
+        for (c = 0; c < job->candCount; c++) {
+            int p = (job->matrix != NULL) ? patterns[job->candidates[c]] : patterns[c];
+
+            if (counts[p] == 0) {
+                touched[used] = (uint8_t) p;
+                used = used + 1;
+            }
+            counts[p]++;
+        }
+
+        // H = log2(n) - (1/n) * sum(count * log2(count))
+        for (c = 0; c < used; c++) {
+            sum += job->countLog[counts[touched[c]]];
+            counts[touched[c]] = 0;
+        }
+        entropy = job->countLog[job->candCount] / job->candCount - sum / job->candCount;
+
+        if (better_guess(job, g, entropy, job->bestIndex, job->bestEntropy)) {
+            job->bestIndex = g;
+            job->bestEntropy = entropy;
+
+            // Nothing after a candidate that splits the set perfectly can
+            // beat it; one before it still might, by the index tie-break
+            if (job->isCandidate[g] && entropy >= job->bound - ENTROPY_EPSILON) {
+                int seen = __atomic_load_n(job->stopAt, __ATOMIC_RELAXED);
+
+                while (g < seen && !__atomic_compare_exchange_n(job->stopAt, &seen, g, 0,
+                                                                __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                }
+            }
+        }
+    }
+
+    free(row);
+    return NULL;
+}
+
+/*
+ * filterCandidates:
+ *   Keeps dictionary words that reproduce every recorded pattern.
+ *
+ * RETURNS:
+ *   Number of candidate indices written to 'out'.
+ */
+
+int filterCandidates(const Dictionary *dict, const GameState *game, int *out) {
+    int count = 0;
+    int i, k;
+
+    for (i = 0; i < dict->count; i++) {
+        uint32_t answer = dictionaryPackedAt(dict, i);
+        int consistent = 1;
+
+        for (k = 0; k < game->guessCount && consistent; k++) {
+            consistent = (scoreGuess(game->guesses[k], answer) == game->patterns[k]);
+        }
+        if (consistent) {
+            out[count] = i;
+            count = count + 1;
+        }
+    }
+    return count;
+}
+
+/*
+ * bestGuess:
+ *   Runs the worker threads and merges their results.
+ *
+ * RETURNS:
+ *   0 on success, 1 if there are no candidates left or memory ran out.
+ */
+
+int bestGuess(const Dictionary *dict, const GameState *game, int threads, Hint *hint) {
+    struct HintJob *jobs;
+    pthread_t *tids;
+    uint32_t *packed;
+    uint32_t *candPacked;
+    int *candidates;
+    char *isCandidate;
+    double *countLog;
+    int stopAt = dict->count;
+    int candCount, best, created, i;
+    int opening = (game->guessCount == 0 && dict == getDictionary());
+
+    if (opening) {
+        pthread_mutex_lock(&openingLock);
+        if (openingCached) {
+            *hint = openingHint;
+            pthread_mutex_unlock(&openingLock);
+            return 0;
+        }
+        pthread_mutex_unlock(&openingLock);
+    }
+
+    if (threads < 1) {
+        threads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+        if (threads < 1) {
+            threads = 1;
+        }
+    }
+
+    packed = malloc(sizeof(uint32_t) * (dict->count + 1));
+    candPacked = malloc(sizeof(uint32_t) * (dict->count + 1));
+    candidates = malloc(sizeof(int) * (dict->count + 1));
+    isCandidate = calloc((size_t) dict->count + 1, 1);
+    countLog = malloc(sizeof(double) * (dict->count + 1));
+    jobs = calloc((size_t) threads, sizeof(struct HintJob));
+    tids = calloc((size_t) threads, sizeof(pthread_t));
+
+    if (packed == NULL || candPacked == NULL || candidates == NULL ||
+        isCandidate == NULL || countLog == NULL || jobs == NULL || tids == NULL) {
+        candCount = 0;
+    } else {
+        candCount = filterCandidates(dict, game, candidates);
+    }
+
+    best = -1;
+    hint->entropy = 0.0;
+    hint->candidates = candCount;
+
+    if (candCount > 0 && candCount <= 2) {
+        // Guessing a remaining candidate is optimal: it wins or decides it
+        best = candidates[0];
+        hint->entropy = (candCount == 2) ? 1.0 : 0.0;
+    } else if (candCount > 2) {
+        for (i = 0; i < dict->count; i++) {
+            packed[i] = dictionaryPackedAt(dict, i);
+        }
+        for (i = 0; i < candCount; i++) {
+            candPacked[i] = packed[candidates[i]];
+            isCandidate[candidates[i]] = 1;
+        }
+        // Entropy terms only ever need c * log2(c) for c <= candCount
+        countLog[0] = 0.0;
+        for (i = 1; i <= candCount; i++) {
+            countLog[i] = i * log2((double) i);
+        }
+
+        for (i = 0; i < threads; i++) {
+            jobs[i].dict = dict;
+            jobs[i].matrix = (dict == getDictionary()) ? getPatternMatrix() : NULL;
+            jobs[i].packed = packed;
+            jobs[i].candidates = candidates;
+            jobs[i].candPacked = candPacked;
+            jobs[i].isCandidate = isCandidate;
+            jobs[i].countLog = countLog;
+            jobs[i].candCount = candCount;
+            jobs[i].grayLetters = game->keysGray;
+            jobs[i].bound = log2((double) (candCount < PATTERN_COUNT ? candCount : PATTERN_COUNT));
+            jobs[i].stopAt = &stopAt;
+            jobs[i].first = i;
+            jobs[i].stride = threads;
+        }
+
+        // A single worker runs inline, so callers that are already
+        // multithreaded (like the simulator) do not pay for a thread per hint
+        if (threads == 1) {
+            score_guesses(&jobs[0]);
+        } else {
+            for (created = 0; created < threads; created++) {
+                if (pthread_create(&tids[created], NULL, score_guesses, &jobs[created]) != 0) {
+                    break;
+                }
+            }
+            // Shares no thread could be started for are scored here
+            for (i = created; i < threads; i++) {
+                score_guesses(&jobs[i]);
+            }
+            for (i = 0; i < created; i++) {
+                pthread_join(tids[i], NULL);
+            }
+        }
+        for (i = 0; i < threads; i++) {
+            if (jobs[i].bestIndex >= 0 &&
+                better_guess(&jobs[0], jobs[i].bestIndex, jobs[i].bestEntropy, best, hint->entropy)) {
+                best = jobs[i].bestIndex;
+                hint->entropy = jobs[i].bestEntropy;
+            }
+        }
+    }
+
+    if (best >= 0) {
+        hint->guessIndex = best;
+        dictionaryWordAt(dict, best, hint->word);
+    }
+
+    free(packed);
+    free(candPacked);
+    free(candidates);
+    free(isCandidate);
+    free(countLog);
+    free(jobs);
+    free(tids);
+
+    if (best < 0) {
+        return 1;
+    }
+
+    if (opening) {
+        pthread_mutex_lock(&openingLock);
+        openingHint = *hint;
+        openingCached = 1;
+        pthread_mutex_unlock(&openingLock);
+    }
+    return 0;
+}
+
+/*
+ * printHint:
+ *   Prints the suggested guess, its expected information and how many
+ *   answers are still possible.
+ *
+ * RETURNS:
+ *   printf's result for the line.
+ */
+
+int printHint(const GameState *game) {
+    PROFILE_SCOPE(PROFILE_HINT);
+    const Dictionary *dict = getDictionary();
+    Hint hint;
+    char shown[6];
+    int i;
+
+    if (dict == NULL || bestGuess(dict, game, 0, &hint) != 0) {
+        return printf("Sorry, no hint is available for this round.\n");
+    }
+
+    for (i = 0; i < 6; i++) {
+        shown[i] = (char) toupper((unsigned char) hint.word[i]);
+    }
+
+    return printf("Hint: try %s (%.2f bits of information, %d possible word%s left)\n",
+                  shown, hint.entropy, hint.candidates, hint.candidates == 1 ? "" : "s");
+}
@@ -5,8 +5,20 @@
  * FUNCTIONALITY:
  *  - logGame:  append a finished game (username, word, guesses, result, time)
  *              to textFiles/history.txt
- *  - CheckHistory: loads all saved games from the file, then print a table
- *                  of results from most recent game to oldest, with colour.
+ *  - logGames: append many finished games with one write and one sync, for
+ *              the result log (see result_log.c)
+ *  - CheckHistory: prints a table of results from most recent game to
+ *                  oldest, with colour.
+ *  - CheckHistoryPage: the same table for one page (offset / limit).
+ *  - ReadHistoryPage: one page as GameResults, for the game server.
+ *
+ * When textFiles/history.bin exists both use the binary log instead
+ * (see history_binary.c).
+ *
+ * The history is read backwards from the end of the file in aligned
+ * blocks, so the newest games come first, the first row costs the same no
+ * matter how long the history is, and memory stays at one block plus one
+ * page of output. Each page of rows is written to stdout in one go.
  *
  * AUTHOR:  Lohitashwa Madhan
  * DATE:    2nd December, 2025
@@ -15,41 +27,68 @@
 #include <stdio.h>
 #include <string.h>
 #include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
 #include "../headerFiles/history.h"
+#include "../headerFiles/history_binary.h"
+#include "../headerFiles/record_parser.h"
+#include "../headerFiles/profile.h"
+#include "../headerFiles/data_dir.h"
+#include "../headerFiles/file_io.h"
 
-#define HISTORY_FILE "textFiles/history.txt"
+#define HISTORY_FILE "history.txt"
 
 #define COLOR_RESET   "\033[0m"
 #define COLOR_GREEN   "\033[32m"
 #define COLOR_RED     "\033[31m"
 #define COLOR_MAGENTA "\033[35m"
 
-/* Reasonable cap on how many history lines we read */
-#define MAX_HISTORY_RECORDS 1000
+/* Size of each backwards read; block reads start on a multiple of it */
+#define HISTORY_BLOCK_SIZE 65536
+
+/* Rows formatted into one buffer before each write to stdout */
+#define HISTORY_PAGE_ROWS  64
+
+/* Longest formatted table row, colour codes included */
+#define HISTORY_ROW_MAX    128
+
+/* Longest history.txt line logGames writes */
+#define HISTORY_LINE_MAX   96
+
+/* HistoryReader:
+ *   Yields the lines of the history file newest-first. 'data' holds the
+ *   file bytes [pos, pos + len) that have not been handed out yet; the
+ *   oldest of them may be the end of a line whose start is still unread.
+ */
+struct HistoryReader {
+    int    fd;
+    off_t  pos;
+    char  *data;
+    size_t len;
+    size_t cap;
+};
 
 /*
- * fill_timestamp:
- *   Writes the current local time into 'buffer' as a string
+ * format_timestamp:
+ *   Writes the local time 'when' into 'buffer' as a string
  *   using the format "YYYY-MM-DD_HH:MM".
  *   If localtime fails, it writes an empty string.
  *
  * PARAMETERS:
+ *   when   - the time to write
  *   buffer - destination character array
  *   size   - size of the buffer in bytes
  * SIDE EFFECTS:
  *   Overwrites the contents of buffer with a formatted timestamp or "".
  */
 
-static void fill_timestamp(char *buffer, int size) {
-    time_t now;
-    struct tm *info;
-
-    now = time(NULL);   // get current time
-    info = localtime(&now);  // convert to local time components
+static void format_timestamp(time_t when, char *buffer, int size) {
+    struct tm info;
 
-    if (info != NULL) {
+    if (localtime_r(&when, &info) != NULL) {
         // Format time as "YYYY-MM-DD_HH:MM" into buffer
-        strftime(buffer, size, "%Y-%m-%d_%H:%M", info);
+        strftime(buffer, size, "%Y-%m-%d_%H:%M", &info);
     } else {
         if (size > 0) {
             buffer[0] = '\0';
@@ -58,34 +97,135 @@ static void fill_timestamp(char *buffer, int size) {
 }
 
 /*
- * read_game:
- *   Attempts to read one GameResult from the given file pointer 'fp'.
+ * fill_timestamp:
+ *   format_timestamp for the current time.
+ */
+
+static void fill_timestamp(char *buffer, int size) {
+    format_timestamp(time(NULL), buffer, size);   // current time
+}
+
+/*
+ * reader_open:
+ *   Opens 'path' for reading backwards from its end.
  *
- * PARAMETERS:
- *   fp - open FILE pointer for the history file
- *   r  - pointer to a GameResult struct to fill
+ * RETURNS:
+ *   0 on success, 1 if the file cannot be opened.
+ */
+
+static int reader_open(struct HistoryReader *reader, const char *path) {
+    struct stat st;
+
+    reader->fd = open(path, O_RDONLY);
+    if (reader->fd < 0) {
+        return 1;
+    }
+    if (fstat(reader->fd, &st) != 0) {
+        close(reader->fd);
+        return 1;
+    }
+
+    reader->pos  = st.st_size;
+    reader->data = NULL;
+    reader->len  = 0;
+    reader->cap  = 0;
+    return 0;
+}
+
+/*
+ * reader_close:
+ *   Releases the reader's file and buffer.
+ */
+
+static void reader_close(struct HistoryReader *reader) {
+    close(reader->fd);
+    free(reader->data);
+}
+
+/*
+ * reader_fill:
+ *   Reads the block before the buffered bytes and puts it in front of
+ *   them. The first read covers the partial block at the end of the file,
+ *   so every later read starts on a HISTORY_BLOCK_SIZE boundary.
  *
  * RETURNS:
- *   1 if a full record (5 values) was successfully read,
- *   0 otherwise (end-of-file or bad line).
+ *   0 on success, 1 on a read error or if memory ran out.
  */
 
-static int read_game(FILE *fp, struct GameResult *r) {
-    int scanned;
+static int reader_fill(struct HistoryReader *reader) {
+    off_t start = ((reader->pos - 1) / HISTORY_BLOCK_SIZE) * HISTORY_BLOCK_SIZE;
+    size_t want = (size_t) (reader->pos - start);
+    size_t done = 0;
 
-    scanned = fscanf(fp, "%31s %5s %d %d %19s",
-                     r->username,
-                     r->word,
-                     &r->guesses,
-                     &r->won,
-                     r->timestamp);
+    if (reader->len + want > reader->cap) {
+        char *grown = realloc(reader->data, reader->len + want);
 
-    if (scanned == 5) {
-        return 1;
+        if (grown == NULL) {
+            return 1;
+        }
+        reader->data = grown;
+        reader->cap = reader->len + want;
     }
+
+    // Only the unfinished oldest line is ever carried over, so this is short
+    memmove(reader->data + want, reader->data, reader->len);
+
+    while (done < want) {
+        ssize_t got = pread(reader->fd, reader->data + done, want - done, start + (off_t) done);
+
+        if (got <= 0) {
+            return 1;
+        }
+        done = done + (size_t) got;
+    }
+
+    reader->pos = start;
+    reader->len = reader->len + want;
     return 0;
 }
 
+/*
+ * reader_prev_line:
+ *   Hands out the newest line not returned yet, without its newline, as
+ *   'length' bytes of the buffer that stay valid until the next call.
+ *
+ * RETURNS:
+ *   1 if a line was returned, 0 once the start of the file is reached
+ *   (or the file could not be read).
+ */
+
+static int reader_prev_line(struct HistoryReader *reader, const char **line, size_t *length) {
+    while (1) {
+        size_t end = reader->len;
+        size_t i;
+
+        if (end > 0 && reader->data[end - 1] == '\n') {
+            end = end - 1;
+        }
+
+        // Look for the newline that ends the line before this one
+        i = end;
+        while (i > 0 && reader->data[i - 1] != '\n') {
+            i = i - 1;
+        }
+
+        if (i > 0 || reader->pos == 0) {
+            if (reader->len == 0) {
+                return 0;
+            }
+            *line = reader->data + i;
+            *length = end - i;
+            reader->len = i;
+            return 1;
+        }
+
+        // The line starts in an earlier block
+        if (reader_fill(reader) != 0) {
+            return 0;
+        }
+    }
+}
+
 /*
  * print_history_header:
  *   Prints the column titles for the history table.
@@ -121,9 +261,11 @@ static void print_history_header(void) {
  */
 
 void logGame(const char *username, const char *word, int guesses, int won) {
+    PROFILE_SCOPE(PROFILE_LOG_GAME);
 
     FILE *fp;
     struct GameResult r;
+    const char *lead = "";
 
     // Copies username into the struct 
     strncpy(r.username, username, NAME_MAX_LEN - 1);
@@ -141,14 +283,29 @@ void logGame(const char *username, const char *word, int guesses, int won) {
         r.won = 0;
     }
 
+    // The binary log, when in use, takes the record instead of history.txt
+    if (historyBinaryEnabled()) {
+        historyLogAppend(&r, time(NULL));
+        return;
+    }
+
     // Adds a timestamp string for when this game was logged
     fill_timestamp(r.timestamp, TIME_MAX_LEN);
 
-    // Opens the history file in append mode 
-    fp = fopen(HISTORY_FILE, "a");
+    // Opens the history file in append mode (readable, to check the last byte)
+    fp = fopen(dataPath(HISTORY_FILE), "a+");
+    if (fp == NULL) {
+        return;
+    }
+
+    // A file whose last line has no newline would glue this record onto it
+    if (fseek(fp, -1, SEEK_END) == 0 && fgetc(fp) != '\n') {
+        lead = "\n";
+    }
 
     // Writes one line with all five fields - username word guesses won timestamp
-    fprintf(fp, "%s %s %d %d %s\n",
+    fprintf(fp, "%s%s %s %d %d %s\n",
+            lead,
             r.username,
             r.word,
             r.guesses,
@@ -159,51 +316,266 @@ void logGame(const char *username, const char *word, int guesses, int won) {
 }
 
 /*
- * CheckHistory:
- *   Reads all previous game entries from HISTORY_FILE (history.txt)
- *   and prints them in a formatted table.
+ * sync_file:
+ *   Flushes a file's data to disk.
+ *
+ * RETURNS:
+ *   0 on success (or if the file does not exist), 1 on failure.
+ */
+
+static int sync_file(const char *path) {
+    int fd = open(path, O_RDONLY);
+    int failed;
+
+    if (fd < 0) {
+        return 0;
+    }
+    failed = (fdatasync(fd) != 0);
+    close(fd);
+    return failed;
+}
+
+/*
+ * logGames:
+ *   Appends 'count' finished games to the history, in order, with the
+ *   time each one ended (times[i]) rather than the time of the call.
+ *   Text lines are built in memory and added with one write; either way
+ *   the file is synced before returning, so a caller can forget the games
+ *   once this succeeds.
+ *
+ * RETURNS:
+ *   0 on success, 1 on failure.
+ */
+
+int logGames(const struct GameResult *games, const time_t *times, int count) {
+    PROFILE_SCOPE(PROFILE_LOG_GAME);
+    char *lines;
+    char last;
+    size_t length = 0;
+    struct stat st;
+    int failed = 0;
+    int fd;
+    int i;
+
+    if (count <= 0) {
+        return 0;
+    }
+
+    // The binary log, when in use, takes the records instead of history.txt
+    if (historyBinaryEnabled()) {
+        for (i = 0; i < count; i++) {
+            failed = historyLogAppend(&games[i], times[i]) || failed;
+        }
+        failed = sync_file(dataPath(HISTORY_NAMES_FILE)) || failed;
+        return sync_file(dataPath(HISTORY_BINARY_FILE)) || failed;
+    }
+
+    lines = malloc((size_t) count * HISTORY_LINE_MAX + 2);
+    if (lines == NULL) {
+        return 1;
+    }
+    fd = open(dataPath(HISTORY_FILE), O_RDWR | O_APPEND | O_CREAT, 0644);
+    if (fd < 0) {
+        free(lines);
+        return 1;
+    }
+
+    // A file whose last line has no newline would glue this record onto it
+    if (fstat(fd, &st) == 0 && st.st_size > 0 &&
+        pread(fd, &last, 1, st.st_size - 1) == 1 && last != '\n') {
+        lines[length++] = '\n';
+    }
+
+    for (i = 0; i < count; i++) {
+        char timestamp[TIME_MAX_LEN];
+
+        format_timestamp(times[i], timestamp, TIME_MAX_LEN);
+        length += (size_t) snprintf(lines + length, HISTORY_LINE_MAX, "%.*s %.*s %d %d %s\n",
+                                    NAME_MAX_LEN - 1, games[i].username,
+                                    WORD_MAX_LEN - 1, games[i].word,
+                                    games[i].guesses, games[i].won != 0, timestamp);
+    }
+
+    failed = writeAll(fd, lines, length);
+    failed = (fdatasync(fd) != 0) || failed;
+
+    close(fd);
+    free(lines);
+    return failed;
+}
+
+/*
+ * next_record:
+ *   Reads backwards to the next (older) well-formed game record.
+ *
+ * RETURNS:
+ *   1 if *r was filled, 0 once there are no more records.
+ */
+
+static int next_record(struct HistoryReader *reader, struct GameResult *r) {
+    const char *line;
+    size_t length;
+
+    while (reader_prev_line(reader, &line, &length) == 1) {
+        if (recordParseGame(line, length, r) == 1) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * format_row:
+ *   Formats one history table row into 'out' (HISTORY_ROW_MAX bytes),
+ *   WIN in green and LOSS in red.
+ *
+ * RETURNS:
+ *   Number of bytes written, not counting the NUL.
+ */
+
+static size_t format_row(char *out, const struct GameResult *r) {
+    int n;
+
+    if (r->won == 1) {
+        n = snprintf(out, HISTORY_ROW_MAX, "%-12s %-8s %-8d %s%-8s%s %-16s\n",
+                     r->username,
+                     r->word,
+                     r->guesses,
+                     COLOR_GREEN, "WIN", COLOR_RESET,
+                     r->timestamp);
+    } else {
+        n = snprintf(out, HISTORY_ROW_MAX, "%-12s %-8s %-8d %s%-8s%s %-16s\n",
+                     r->username,
+                     r->word,
+                     r->guesses,
+                     COLOR_RED, "LOSS", COLOR_RESET,
+                     r->timestamp);
+    }
+
+    if (n < 0) {
+        return 0;
+    }
+    return (n < HISTORY_ROW_MAX) ? (size_t) n : HISTORY_ROW_MAX - 1;
+}
+
+/*
+ * write_rows:
+ *   Sends a page of formatted rows to stdout with a single write, after
+ *   flushing anything already buffered by printf.
+ */
+
+static void write_rows(const char *rows, size_t length) {
+    fflush(stdout);
+    writeAll(STDOUT_FILENO, rows, length);
+}
+
+/*
+ * check_binary_page:
+ *   CheckHistoryPage for history.bin. Records are fixed-size, so the page
+ *   is found by index and read a batch at a time, newest first.
+ */
+
+static void check_binary_page(long offset, long limit) {
+    HistoryLog log;
+    HistoryRecord batch[HISTORY_PAGE_ROWS];
+    char rows[HISTORY_PAGE_ROWS * HISTORY_ROW_MAX];
+    long next;
+    long shown = 0;
+
+    if (historyLogOpen(&log, dataPath(HISTORY_BINARY_FILE)) != 0 || log.count == 0) {
+        historyLogClose(&log);
+        printf("No history yet.\n");
+        return;
+    }
+
+    // Magenta heading 
+    printf("\n" COLOR_MAGENTA "----------------------Game History----------------------" COLOR_RESET "\n");
+
+    // Table header 
+    print_history_header();
+
+    // 'next' is the newest record not printed yet
+    next = log.count - 1 - (offset > 0 ? offset : 0);
+    while (next >= 0 && (limit <= 0 || shown < limit)) {
+        long want = HISTORY_PAGE_ROWS;
+        long first, got, i;
+        size_t used = 0;
+
+        if (limit > 0 && limit - shown < want) {
+            want = limit - shown;
+        }
+        first = (next + 1 > want) ? next + 1 - want : 0;
+        got = historyLogRead(&log, first, next + 1 - first, batch);
+        if (got <= 0) {
+            break;
+        }
+
+        for (i = got - 1; i >= 0; i--) {
+            struct GameResult r;
+
+            if (historyRecordToResult(&batch[i], &r) == 0) {
+                used = used + format_row(rows + used, &r);
+            }
+            shown = shown + 1;
+        }
+        write_rows(rows, used);
+        next = first - 1;
+    }
+
+    historyLogClose(&log);
+
+    /* Magenta closing line */
+    printf(COLOR_MAGENTA "--------------------------------------------------------" COLOR_RESET "\n");
+}
+
+/*
+ * CheckHistoryPage:
+ *   Prints one page of the game history in a formatted table, most recent
+ *   game first.
  *
  *   Behaviour:
- *     - If the file does not exist, prints "No history yet." and returns.
+ *     - If the file does not exist or holds no games, prints
+ *       "No history yet." and returns.
  *     - Otherwise:
- *         * reads all records into an array,
- *         * prints them in **reverse order** (most recent first),
+ *         * reads the file backwards, newest record first,
+ *         * skips the 'offset' most recent games,
+ *         * prints up to 'limit' games (all remaining when limit <= 0),
  *         * shows WIN in green and LOSS in red,
  *         * wraps the table with magenta heading and footer lines.
  *
  * PARAMETERS:
- *   none
+ *   offset - number of most recent games to skip
+ *   limit  - maximum number of games to print, <= 0 for no limit
  *
  * SIDE EFFECTS:
- *   Writes either an empty-history message or a full history table to stdout.
+ *   Writes either an empty-history message or a history table to stdout.
  */
 
-void CheckHistory(void) {
-    FILE *fp;
-    struct GameResult records[MAX_HISTORY_RECORDS];
-    int count;
-    int ok;
-
-// Opens the history file for reading
-
-    fp = fopen(HISTORY_FILE, "r");
-    if (fp == NULL) {
-        printf("No history yet.\n");
+void CheckHistoryPage(long offset, long limit) {
+    PROFILE_SCOPE(PROFILE_HISTORY);
+    struct HistoryReader reader;
+    struct GameResult r;
+    char rows[HISTORY_PAGE_ROWS * HISTORY_ROW_MAX];
+    size_t used = 0;
+    long skipped = 0;
+    long shown = 0;
+    int found;
+
+    if (historyBinaryEnabled()) {
+        check_binary_page(offset, limit);
         return;
     }
 
-    // Reads all records into the array 
-    count = 0;
-    ok = read_game(fp, &records[count]);
-    while (ok == 1 && count < MAX_HISTORY_RECORDS - 1) {
-        count = count + 1;
-        ok = read_game(fp, &records[count]);
+    // Opens the history file for reading from the end
+    if (reader_open(&reader, dataPath(HISTORY_FILE)) != 0) {
+        printf("No history yet.\n");
+        return;
     }
 
-    fclose(fp);
-
-    if (count == 0 && ok == 0) {
+    found = next_record(&reader, &r);
+    if (found == 0) {
         //File exists but had no valid lines
+        reader_close(&reader);
         printf("No history yet.\n");
         return;
     }
@@ -214,35 +586,100 @@ void CheckHistory(void) {
     // Table header 
     print_history_header();
 
-/* Prints from most recent to oldest:
-     *   - last record read (index count-1) is newest
-     *   - index 0 is the oldest
-     */
-
-    {
-        int i;
-
-        i = count - 1;
-        while (i >= 0) {
-            if (records[i].won == 1) {
-                printf("%-12s %-8s %-8d %s%-8s%s %-16s\n",
-                       records[i].username,
-                       records[i].word,
-                       records[i].guesses,
-                       COLOR_GREEN, "WIN", COLOR_RESET,
-                       records[i].timestamp);
-            } else {
-                printf("%-12s %-8s %-8d %s%-8s%s %-16s\n",
-                       records[i].username,
-                       records[i].word,
-                       records[i].guesses,
-                       COLOR_RED, "LOSS", COLOR_RESET,
-                       records[i].timestamp);
+    // Rows arrive newest first; each full page is written at once
+    while (found == 1 && (limit <= 0 || shown < limit)) {
+        if (skipped < offset) {
+            skipped = skipped + 1;
+        } else {
+            used = used + format_row(rows + used, &r);
+            shown = shown + 1;
+
+            if (used + HISTORY_ROW_MAX > sizeof(rows)) {
+                write_rows(rows, used);
+                used = 0;
             }
-            i = i - 1;
         }
+        found = next_record(&reader, &r);
     }
 
+    write_rows(rows, used);
+    reader_close(&reader);
+
     /* Magenta closing line */
     printf(COLOR_MAGENTA "--------------------------------------------------------" COLOR_RESET "\n");
 }
+
+/*
+ * ReadHistoryPage:
+ *   CheckHistoryPage without the table: the same games, newest first,
+ *   copied into 'out' (room for 'limit' results) from either history file.
+ *
+ * RETURNS:
+ *   The number of games stored in 'out'.
+ */
+
+long ReadHistoryPage(long offset, long limit, struct GameResult *out) {
+    PROFILE_SCOPE(PROFILE_HISTORY);
+    long shown = 0;
+
+    if (limit <= 0) {
+        return 0;
+    }
+
+    if (historyBinaryEnabled()) {
+        HistoryLog log;
+        HistoryRecord batch[HISTORY_PAGE_ROWS];
+        long next;
+
+        if (historyLogOpen(&log, dataPath(HISTORY_BINARY_FILE)) != 0) {
+            return 0;
+        }
+
+        next = log.count - 1 - (offset > 0 ? offset : 0);
+        while (next >= 0 && shown < limit) {
+            long want = limit - shown < HISTORY_PAGE_ROWS ? limit - shown : HISTORY_PAGE_ROWS;
+            long first = (next + 1 > want) ? next + 1 - want : 0;
+            long got = historyLogRead(&log, first, next + 1 - first, batch);
+            long i;
+
+            if (got <= 0) {
+                break;
+            }
+            for (i = got - 1; i >= 0; i--) {
+                if (historyRecordToResult(&batch[i], &out[shown]) == 0) {
+                    shown = shown + 1;
+                }
+            }
+            next = first - 1;
+        }
+        historyLogClose(&log);
+    } else {
+        struct HistoryReader reader;
+        long skipped = 0;
+
+        if (reader_open(&reader, dataPath(HISTORY_FILE)) != 0) {
+            return 0;
+        }
+        while (shown < limit && next_record(&reader, &out[shown]) == 1) {
+            if (skipped < offset) {
+                skipped = skipped + 1;
+            } else {
+                shown = shown + 1;
+            }
+        }
+        reader_close(&reader);
+    }
+    return shown;
+}
+
+/*
+ * CheckHistory:
+ *   Prints every game in the history, most recent first.
+ *
+ * SIDE EFFECTS:
+ *   Writes either an empty-history message or a full history table to stdout.
+ */
+
+void CheckHistory(void) {
+    CheckHistoryPage(0, 0);
+}
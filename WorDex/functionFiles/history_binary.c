@@ -0,0 +1,878 @@
+/* history_binary.c
+ *
+ * Optional binary game history for the Wordex game.
+ *
+ * FUNCTIONALITY:
+ *  - historyLogAppend: logGame's path when textFiles/history.bin exists;
+ *    one fixed-size record per game, added with a single O_APPEND write
+ *  - historyLogOpen / historyLogRead: random access to record N, which is
+ *    what paging and parallel scans need
+ *  - historyRecordToResult: turns a record back into the GameResult the
+ *    text format would have produced
+ *  - convertHistoryToBinary / convertHistoryToText: lossless converters
+ *    between history.txt and history.bin
+ *
+ * Usernames are stored once, one per line, in textFiles/history.names; a
+ * record keeps the line number. The names are cached in memory with a hash
+ * index and only the lines appended since the last look are read. New
+ * names are added under an flock so two games never get the same id.
+ * Lookups share a read-write lock, so many scanning threads can decode
+ * records at once.
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include "../headerFiles/history_binary.h"
+#include "../headerFiles/record_parser.h"
+#include "../headerFiles/data_dir.h"
+#include "../headerFiles/file_io.h"
+#include "../headerFiles/name_hash.h"
+
+#define HISTORY_TEXT_FILE "history.txt"
+
+/* Records converted or read per batch */
+#define CONVERT_BATCH     4096
+
+/* Initial size of the name hash index; always a power of two */
+#define NAME_SLOTS        1024
+
+/* Username cache: every name NUL-separated in 'text', name i starting at
+ * starts[i], plus an open-addressing index (slots hold id + 1, 0 = empty).
+ */
+static struct {
+    char     *text;
+    size_t    textLen;
+    size_t    textCap;
+    uint32_t *starts;
+    uint32_t  count;
+    uint32_t  cap;
+    uint32_t *slots;
+    uint32_t  mask;
+    off_t     loadedBytes;   // bytes of history.names already cached
+    dev_t     device;
+    ino_t     inode;
+} names;
+
+static pthread_rwlock_t namesLock = PTHREAD_RWLOCK_INITIALIZER;
+
+/*
+ * put_le32 / put_le64 / get_le32 / get_le64:
+ *   Little-endian field encoding, independent of the host byte order.
+ */
+
+static void put_le32(unsigned char *out, uint32_t value) {
+    int i;
+
+    for (i = 0; i < 4; i++) {
+        out[i] = (unsigned char) (value >> (8 * i));
+    }
+}
+
+static void put_le64(unsigned char *out, uint64_t value) {
+    int i;
+
+    for (i = 0; i < 8; i++) {
+        out[i] = (unsigned char) (value >> (8 * i));
+    }
+}
+
+static uint32_t get_le32(const unsigned char *in) {
+    uint32_t value = 0;
+    int i;
+
+    for (i = 3; i >= 0; i--) {
+        value = (value << 8) | in[i];
+    }
+    return value;
+}
+
+static uint64_t get_le64(const unsigned char *in) {
+    uint64_t value = 0;
+    int i;
+
+    for (i = 7; i >= 0; i--) {
+        value = (value << 8) | in[i];
+    }
+    return value;
+}
+
+/*
+ * encode_record / decode_record:
+ *   Converts between a HistoryRecord and its HISTORY_RECORD_SIZE bytes.
+ */
+
+static void encode_record(const HistoryRecord *record, unsigned char *out) {
+    memset(out, 0, HISTORY_RECORD_SIZE);
+    put_le32(out, record->userId);
+    put_le32(out + 4, record->word);
+    put_le64(out + 8, (uint64_t) record->when);
+    out[16] = record->guesses;
+    out[17] = record->won;
+}
+
+static void decode_record(const unsigned char *in, HistoryRecord *record) {
+    record->userId  = get_le32(in);
+    record->word    = get_le32(in + 4);
+    record->when    = (int64_t) get_le64(in + 8);
+    record->guesses = in[16];
+    record->won     = in[17];
+}
+
+/*
+ * encode_header:
+ *   Fills the HISTORY_HEADER_SIZE byte file header.
+ */
+
+static void encode_header(unsigned char *out) {
+    memset(out, 0, HISTORY_HEADER_SIZE);
+    memcpy(out, HISTORY_BINARY_MAGIC, 8);
+    put_le32(out + 8, HISTORY_BINARY_VERSION);
+    put_le32(out + 12, HISTORY_RECORD_SIZE);
+    put_le32(out + 16, HISTORY_HEADER_SIZE);
+}
+
+/*
+ * encode_word:
+ *   Packs a word of up to 5 letters, remembering which were upper case.
+ *
+ * RETURNS:
+ *   0 on success, 1 if the word is too long or has a non-letter.
+ */
+
+static int encode_word(const char *word, uint32_t *out) {
+    uint32_t packed = 0;
+    int i;
+
+    for (i = 0; word[i] != '\0'; i++) {
+        unsigned char c = (unsigned char) word[i];
+
+        if (i >= 5 || c > 127 || !isalpha(c)) {
+            return 1;
+        }
+        packed |= (uint32_t) (tolower(c) - 'a' + 1) << (5 * i);
+        if (isupper(c)) {
+            packed |= (uint32_t) 1 << (25 + i);
+        }
+    }
+
+    *out = packed;
+    return 0;
+}
+
+/*
+ * decode_word:
+ *   Inverse of encode_word; 'out' holds at least WORD_MAX_LEN bytes.
+ */
+
+static void decode_word(uint32_t packed, char *out) {
+    int i;
+
+    for (i = 0; i < 5; i++) {
+        uint32_t code = (packed >> (5 * i)) & 31;
+
+        if (code == 0) {
+            break;
+        }
+        out[i] = (char) ('a' + code - 1);
+        if ((packed >> (25 + i)) & 1) {
+            out[i] = (char) toupper((unsigned char) out[i]);
+        }
+    }
+    out[i] = '\0';
+}
+
+/*
+ * format_when:
+ *   The text history's timestamp, "YYYY-MM-DD_HH:MM" in local time.
+ */
+
+static void format_when(int64_t when, char *out) {
+    time_t t = (time_t) when;
+    struct tm info;
+
+    if (localtime_r(&t, &info) == NULL ||
+        strftime(out, TIME_MAX_LEN, "%Y-%m-%d_%H:%M", &info) == 0) {
+        out[0] = '\0';
+    }
+}
+
+/*
+ * parse_when:
+ *   Local-time "YYYY-MM-DD_HH:MM" to epoch seconds.
+ *
+ * RETURNS:
+ *   0 on success, 1 if the text is not a timestamp.
+ */
+
+static int parse_when(const char *text, int64_t *when) {
+    struct tm info;
+    time_t t;
+
+    memset(&info, 0, sizeof(info));
+    if (sscanf(text, "%d-%d-%d_%d:%d", &info.tm_year, &info.tm_mon, &info.tm_mday,
+               &info.tm_hour, &info.tm_min) != 5) {
+        return 1;
+    }
+    info.tm_year = info.tm_year - 1900;
+    info.tm_mon = info.tm_mon - 1;
+    info.tm_isdst = -1;
+
+    t = mktime(&info);
+    if (t == (time_t) -1) {
+        return 1;
+    }
+    *when = (int64_t) t;
+    return 0;
+}
+
+/*
+ * names_reset:
+ *   Forgets every cached name. Caller holds namesLock for writing.
+ */
+
+static void names_reset(void) {
+    free(names.text);
+    free(names.starts);
+    free(names.slots);
+    memset(&names, 0, sizeof(names));
+}
+
+/*
+ * names_find:
+ *   Looks a name up in the cache. Caller holds namesLock.
+ *
+ * RETURNS:
+ *   The name's id, or -1 if it is not cached.
+ */
+
+static long names_find(const char *name) {
+    uint32_t h;
+
+    if (names.slots == NULL) {
+        return -1;
+    }
+
+    h = hashUsername(name) & names.mask;
+    while (names.slots[h] != 0) {
+        uint32_t id = names.slots[h] - 1;
+
+        if (strcmp(names.text + names.starts[id], name) == 0) {
+            return (long) id;
+        }
+        h = (h + 1) & names.mask;
+    }
+    return -1;
+}
+
+/*
+ * names_add:
+ *   Gives 'name' the next id in the cache. Caller holds namesLock for writing.
+ *
+ * RETURNS:
+ *   0 on success, 1 if memory ran out.
+ */
+
+static int names_add(const char *name) {
+    size_t length = strlen(name) + 1;
+    uint32_t h;
+
+    // Keep the index at most half full
+    if (names.slots == NULL || (names.count + 1) * 2 > names.mask + 1) {
+        uint32_t size = (names.slots == NULL) ? NAME_SLOTS : (names.mask + 1) * 2;
+        uint32_t *slots = calloc(size, sizeof(uint32_t));
+        uint32_t i;
+
+        if (slots == NULL) {
+            return 1;
+        }
+        for (i = 0; i < names.count; i++) {
+            h = hashUsername(names.text + names.starts[i]) & (size - 1);
+            while (slots[h] != 0) {
+                h = (h + 1) & (size - 1);
+            }
+            slots[h] = i + 1;
+        }
+        free(names.slots);
+        names.slots = slots;
+        names.mask = size - 1;
+    }
+
+    if (names.count == names.cap) {
+        uint32_t cap = (names.cap == 0) ? NAME_SLOTS : names.cap * 2;
+        uint32_t *starts = realloc(names.starts, sizeof(uint32_t) * cap);
+
+        if (starts == NULL) {
+            return 1;
+        }
+        names.starts = starts;
+        names.cap = cap;
+    }
+
+    if (names.textLen + length > names.textCap) {
+        size_t cap = (names.textCap == 0) ? 4096 : names.textCap;
+        char *text;
+
+        while (cap < names.textLen + length) {
+            cap = cap * 2;
+        }
+        text = realloc(names.text, cap);
+        if (text == NULL) {
+            return 1;
+        }
+        names.text = text;
+        names.textCap = cap;
+    }
+
+    memcpy(names.text + names.textLen, name, length);
+    names.starts[names.count] = (uint32_t) names.textLen;
+    names.textLen = names.textLen + length;
+
+    h = hashUsername(name) & names.mask;
+    while (names.slots[h] != 0) {
+        h = (h + 1) & names.mask;
+    }
+    names.slots[h] = names.count + 1;
+    names.count = names.count + 1;
+    return 0;
+}
+
+/*
+ * names_refresh:
+ *   Caches the lines appended to history.names since the last call,
+ *   starting over if the file was replaced. Caller holds namesLock for
+ *   writing.
+ *
+ * RETURNS:
+ *   0 on success (a missing file just means no names), 1 on error.
+ */
+
+static int names_refresh(void) {
+    struct stat st;
+    FILE *fp;
+    char line[NAME_MAX_LEN + 2];
+    int failed = 0;
+
+    fp = fopen(dataPath(HISTORY_NAMES_FILE), "r");
+    if (fp == NULL) {
+        if (names.count > 0) {
+            names_reset();
+        }
+        return 0;
+    }
+
+    if (fstat(fileno(fp), &st) != 0) {
+        fclose(fp);
+        return 1;
+    }
+    if (st.st_dev != names.device || st.st_ino != names.inode || st.st_size < names.loadedBytes) {
+        names_reset();
+        names.device = st.st_dev;
+        names.inode = st.st_ino;
+    }
+    if (st.st_size == names.loadedBytes || fseeko(fp, names.loadedBytes, SEEK_SET) != 0) {
+        fclose(fp);
+        return 0;
+    }
+
+    // Names are written whole, so only a line still being written can be cut short
+    while (!failed && fgets(line, sizeof(line), fp) != NULL) {
+        size_t length = strlen(line);
+
+        if (length == 0 || line[length - 1] != '\n') {
+            break;
+        }
+        names.loadedBytes = names.loadedBytes + (off_t) length;
+        line[length - 1] = '\0';
+        failed = names_add(line);
+    }
+
+    fclose(fp);
+    return failed;
+}
+
+/*
+ * user_id:
+ *   Finds the id of 'username', appending it to history.names if it is new.
+ *
+ * RETURNS:
+ *   0 and sets *id on success, 1 on failure.
+ */
+
+static int user_id(const char *username, uint32_t *id) {
+    char line[NAME_MAX_LEN + 1];
+    long found;
+    int fd;
+    int failed = 0;
+
+    pthread_rwlock_wrlock(&namesLock);
+
+    found = (names_refresh() == 0) ? names_find(username) : -1;
+    if (found >= 0) {
+        *id = (uint32_t) found;
+        pthread_rwlock_unlock(&namesLock);
+        return 0;
+    }
+
+    // New player: take the file lock, catch up with other processes, append
+    fd = open(dataPath(HISTORY_NAMES_FILE), O_WRONLY | O_APPEND | O_CREAT, 0644);
+    if (fd < 0 || flock(fd, LOCK_EX) != 0) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        pthread_rwlock_unlock(&namesLock);
+        return 1;
+    }
+
+    failed = names_refresh();
+    found = failed ? -1 : names_find(username);
+    if (!failed && found < 0) {
+        int length = snprintf(line, sizeof(line), "%s\n", username);
+
+        if (write(fd, line, (size_t) length) != length) {
+            failed = 1;
+        } else {
+            names.loadedBytes = names.loadedBytes + length;
+            failed = names_add(username);
+            found = (long) names.count - 1;
+        }
+    }
+
+    flock(fd, LOCK_UN);
+    close(fd);
+    pthread_rwlock_unlock(&namesLock);
+
+    if (failed) {
+        return 1;
+    }
+    *id = (uint32_t) found;
+    return 0;
+}
+
+/*
+ * historyBinaryEnabled:
+ *   The binary log is used whenever history.bin exists.
+ *
+ * RETURNS:
+ *   1 if history.bin exists, 0 otherwise.
+ */
+
+int historyBinaryEnabled(void) {
+    return access(dataPath(HISTORY_BINARY_FILE), F_OK) == 0;
+}
+
+/*
+ * historyLogOpen:
+ *   Opens a binary history and checks its header.
+ *
+ * RETURNS:
+ *   0 on success, 1 if the file is missing or not a version 1 log.
+ */
+
+int historyLogOpen(HistoryLog *log, const char *path) {
+    unsigned char header[HISTORY_HEADER_SIZE];
+    struct stat st;
+
+    log->fd = open(path, O_RDONLY);
+    if (log->fd < 0) {
+        return 1;
+    }
+
+    if (pread(log->fd, header, sizeof(header), 0) != (ssize_t) sizeof(header) ||
+        memcmp(header, HISTORY_BINARY_MAGIC, 8) != 0 ||
+        get_le32(header + 8) != HISTORY_BINARY_VERSION ||
+        get_le32(header + 12) != HISTORY_RECORD_SIZE ||
+        get_le32(header + 16) != HISTORY_HEADER_SIZE ||
+        fstat(log->fd, &st) != 0) {
+        close(log->fd);
+        log->fd = -1;
+        return 1;
+    }
+
+    // A record still being appended is not counted yet
+    log->count = (long) ((st.st_size - HISTORY_HEADER_SIZE) / HISTORY_RECORD_SIZE);
+    return 0;
+}
+
+/*
+ * historyLogRead:
+ *   Reads records [first, first + n) with one pread.
+ *
+ * RETURNS:
+ *   The number of records read (0 past the end or on error).
+ */
+
+long historyLogRead(const HistoryLog *log, long first, long n, HistoryRecord *out) {
+    unsigned char *buffer;
+    ssize_t got;
+    long i;
+
+    if (first < 0 || n <= 0 || first >= log->count) {
+        return 0;
+    }
+    if (n > log->count - first) {
+        n = log->count - first;
+    }
+
+    buffer = malloc((size_t) n * HISTORY_RECORD_SIZE);
+    if (buffer == NULL) {
+        return 0;
+    }
+
+    got = pread(log->fd, buffer, (size_t) n * HISTORY_RECORD_SIZE,
+                HISTORY_HEADER_SIZE + (off_t) first * HISTORY_RECORD_SIZE);
+    n = (got > 0) ? got / HISTORY_RECORD_SIZE : 0;
+
+    for (i = 0; i < n; i++) {
+        decode_record(buffer + i * HISTORY_RECORD_SIZE, &out[i]);
+    }
+
+    free(buffer);
+    return n;
+}
+
+/*
+ * historyLogClose:
+ *   Closes the log's file.
+ */
+
+void historyLogClose(HistoryLog *log) {
+    if (log->fd >= 0) {
+        close(log->fd);
+    }
+    log->fd = -1;
+}
+
+/*
+ * historyLogAppend:
+ *   Appends one game. The time is kept to the minute, like history.txt,
+ *   so converting to text and back gives the same bytes.
+ *
+ * RETURNS:
+ *   0 on success, 1 on failure.
+ */
+
+int historyLogAppend(const struct GameResult *r, time_t when) {
+    unsigned char bytes[HISTORY_RECORD_SIZE];
+    HistoryRecord record;
+    int fd;
+    ssize_t put;
+
+    if (user_id(r->username, &record.userId) != 0 || encode_word(r->word, &record.word) != 0) {
+        return 1;
+    }
+    record.when    = (int64_t) (when - when % 60);
+    record.guesses = (uint8_t) r->guesses;
+    record.won     = (uint8_t) (r->won != 0);
+    encode_record(&record, bytes);
+
+    fd = open(dataPath(HISTORY_BINARY_FILE), O_WRONLY | O_APPEND);
+    if (fd < 0) {
+        return 1;
+    }
+    // One write per record: concurrent games never interleave their bytes
+    put = write(fd, bytes, sizeof(bytes));
+    close(fd);
+
+    return put == (ssize_t) sizeof(bytes) ? 0 : 1;
+}
+
+/*
+ * historyRecordToResult:
+ *   Fills a GameResult from a record, looking the username up by id.
+ *   Known ids only need the read lock, so parallel scans do not queue
+ *   behind each other; a new id re-reads history.names under the write lock.
+ *
+ * RETURNS:
+ *   0 on success, 1 if the id is not in history.names.
+ */
+
+int historyRecordToResult(const HistoryRecord *record, struct GameResult *r) {
+    pthread_rwlock_rdlock(&namesLock);
+    if (record->userId >= names.count) {
+        pthread_rwlock_unlock(&namesLock);
+        pthread_rwlock_wrlock(&namesLock);
+        if (record->userId >= names.count) {
+            names_refresh();
+        }
+    }
+    if (record->userId >= names.count) {
+        pthread_rwlock_unlock(&namesLock);
+        return 1;
+    }
+    strncpy(r->username, names.text + names.starts[record->userId], NAME_MAX_LEN - 1);
+    r->username[NAME_MAX_LEN - 1] = '\0';
+    pthread_rwlock_unlock(&namesLock);
+
+    decode_word(record->word, r->word);
+    r->guesses = record->guesses;
+    r->won = record->won;
+    format_when(record->when, r->timestamp);
+    return 0;
+}
+
+/*
+ * format_line:
+ *   One history.txt line (without the newline), exactly as logGame writes it.
+ */
+
+static int format_line(char *out, size_t size, const struct GameResult *r) {
+    return snprintf(out, size, "%s %s %d %d %s", r->username, r->word, r->guesses, r->won,
+                    r->timestamp);
+}
+
+/*
+ * install_converted:
+ *   Renames the converted names and records into place, names first, so
+ *   history.bin never refers to unknown ids. The names an existing
+ *   history.bin was written against are kept as history.names.old until
+ *   both renames are done, and put back if the second one fails.
+ *
+ * RETURNS:
+ *   0 on success, 1 if the old files are still the live ones.
+ */
+
+static int install_converted(void) {
+    int kept;
+
+    remove(dataPath(HISTORY_NAMES_FILE ".old"));
+    kept = (link(dataPath(HISTORY_NAMES_FILE), dataPath(HISTORY_NAMES_FILE ".old")) == 0);
+    if (!kept && errno != ENOENT) {
+        return 1;
+    }
+
+    if (rename(dataPath(HISTORY_NAMES_FILE ".tmp"), dataPath(HISTORY_NAMES_FILE)) != 0) {
+        if (kept) {
+            remove(dataPath(HISTORY_NAMES_FILE ".old"));
+        }
+        return 1;
+    }
+    if (rename(dataPath(HISTORY_BINARY_FILE ".tmp"), dataPath(HISTORY_BINARY_FILE)) != 0) {
+        if (kept) {
+            rename(dataPath(HISTORY_NAMES_FILE ".old"), dataPath(HISTORY_NAMES_FILE));
+        }
+        return 1;
+    }
+
+    if (kept) {
+        remove(dataPath(HISTORY_NAMES_FILE ".old"));
+    }
+    return 0;
+}
+
+/*
+ * convertHistoryToBinary:
+ *   Reads history.txt line by line. Every record must come back from its
+ *   binary form as exactly the same line, or nothing is written. Blank
+ *   lines are dropped. Output goes to temporary files that
+ *   install_converted puts in place.
+ *
+ * RETURNS:
+ *   0 on success, 1 on failure.
+ */
+
+int convertHistoryToBinary(void) {
+    unsigned char header[HISTORY_HEADER_SIZE];
+    unsigned char *batch;
+    char line[256];
+    char check[256];
+    FILE *in;
+    FILE *namesOut = NULL;
+    int binOut = -1;
+    long lineNumber = 0;
+    long converted = 0;
+    int used = 0;
+    int failed = 0;
+    uint32_t i;
+
+    in = fopen(dataPath(HISTORY_TEXT_FILE), "r");
+    batch = malloc((size_t) CONVERT_BATCH * HISTORY_RECORD_SIZE);
+    if (batch == NULL) {
+        if (in != NULL) {
+            fclose(in);
+        }
+        return 1;
+    }
+
+    binOut = open(dataPath(HISTORY_BINARY_FILE ".tmp"), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    encode_header(header);
+    if (binOut < 0 || writeAll(binOut, header, sizeof(header)) != 0) {
+        fprintf(stderr, "Error: Cannot write %s\n", dataPath(HISTORY_BINARY_FILE ".tmp"));
+        failed = 1;
+    }
+
+    // The converted names replace whatever was cached
+    pthread_rwlock_wrlock(&namesLock);
+    names_reset();
+
+    while (!failed && in != NULL && fgets(line, sizeof(line), in) != NULL) {
+        struct GameResult r;
+        struct GameResult back;
+        HistoryRecord record;
+        size_t length = strlen(line);
+        RecordCursor cursor;
+        RecordField extra;
+        long found;
+
+        lineNumber = lineNumber + 1;
+        if (length > 0 && line[length - 1] == '\n') {
+            line[length - 1] = '\0';
+        }
+        if (line[0] == '\0') {
+            continue;
+        }
+
+        recordCursorInit(&cursor, line, strlen(line));
+        if (!recordReadGame(&cursor, &r) || recordNextField(&cursor, &extra) ||
+            r.guesses < 0 || r.guesses > 255 || (r.won != 0 && r.won != 1) ||
+            encode_word(r.word, &record.word) != 0 ||
+            parse_when(r.timestamp, &record.when) != 0) {
+            fprintf(stderr, "Error: history.txt line %ld is not a game record\n", lineNumber);
+            failed = 1;
+            break;
+        }
+
+        found = names_find(r.username);
+        if (found < 0) {
+            if (names_add(r.username) != 0) {
+                failed = 1;
+                break;
+            }
+            found = (long) names.count - 1;
+        }
+        record.userId  = (uint32_t) found;
+        record.guesses = (uint8_t) r.guesses;
+        record.won     = (uint8_t) r.won;
+
+        // The binary form must give back the very same line
+        strcpy(back.username, r.username);
+        decode_word(record.word, back.word);
+        back.guesses = record.guesses;
+        back.won = record.won;
+        format_when(record.when, back.timestamp);
+        format_line(check, sizeof(check), &back);
+        if (strcmp(check, line) != 0) {
+            fprintf(stderr, "Error: history.txt line %ld cannot be stored exactly (\"%s\")\n",
+                    lineNumber, line);
+            failed = 1;
+            break;
+        }
+
+        encode_record(&record, batch + (size_t) used * HISTORY_RECORD_SIZE);
+        used = used + 1;
+        converted = converted + 1;
+        if (used == CONVERT_BATCH) {
+            failed = writeAll(binOut, batch, (size_t) used * HISTORY_RECORD_SIZE);
+            used = 0;
+        }
+    }
+
+    if (!failed && used > 0) {
+        failed = writeAll(binOut, batch, (size_t) used * HISTORY_RECORD_SIZE);
+    }
+
+    if (!failed) {
+        namesOut = fopen(dataPath(HISTORY_NAMES_FILE ".tmp"), "w");
+        failed = (namesOut == NULL);
+        for (i = 0; !failed && i < names.count; i++) {
+            failed = (fprintf(namesOut, "%s\n", names.text + names.starts[i]) < 0);
+        }
+        if (namesOut != NULL && fclose(namesOut) != 0) {
+            failed = 1;
+        }
+    }
+
+    names_reset();
+    pthread_rwlock_unlock(&namesLock);
+
+    if (binOut >= 0 && (fsync(binOut) != 0 || close(binOut) != 0)) {
+        failed = 1;
+    }
+    if (in != NULL) {
+        fclose(in);
+    }
+    free(batch);
+
+    if (failed || install_converted() != 0) {
+        remove(dataPath(HISTORY_BINARY_FILE ".tmp"));
+        remove(dataPath(HISTORY_NAMES_FILE ".tmp"));
+        fprintf(stderr, "Error: history was not converted\n");
+        return 1;
+    }
+
+    printf("Converted %ld games to %s\n", converted, dataPath(HISTORY_BINARY_FILE));
+    return 0;
+}
+
+/*
+ * convertHistoryToText:
+ *   Writes every record of history.bin as a history.txt line, then moves
+ *   history.bin aside so the text file is the live history again.
+ *
+ * RETURNS:
+ *   0 on success, 1 on failure.
+ */
+
+int convertHistoryToText(void) {
+    HistoryLog log;
+    HistoryRecord *records;
+    FILE *out;
+    long first;
+    int failed = 0;
+
+    if (historyLogOpen(&log, dataPath(HISTORY_BINARY_FILE)) != 0) {
+        fprintf(stderr, "Error: %s is missing or is not a Wordex history log\n", dataPath(HISTORY_BINARY_FILE));
+        return 1;
+    }
+
+    records = malloc(sizeof(HistoryRecord) * CONVERT_BATCH);
+    out = fopen(dataPath(HISTORY_TEXT_FILE ".tmp"), "w");
+    if (records == NULL || out == NULL) {
+        failed = 1;
+    }
+
+    for (first = 0; !failed && first < log.count; first += CONVERT_BATCH) {
+        long n = historyLogRead(&log, first, CONVERT_BATCH, records);
+        long i;
+
+        if (n <= 0) {
+            failed = 1;
+        }
+        for (i = 0; !failed && i < n; i++) {
+            struct GameResult r;
+            char line[256];
+
+            if (historyRecordToResult(&records[i], &r) != 0) {
+                fprintf(stderr, "Error: record %ld has an unknown user id\n", first + i);
+                failed = 1;
+                break;
+            }
+            format_line(line, sizeof(line), &r);
+            failed = (fprintf(out, "%s\n", line) < 0);
+        }
+    }
+
+    if (out != NULL && fclose(out) != 0) {
+        failed = 1;
+    }
+    free(records);
+    historyLogClose(&log);
+
+    if (failed || rename(dataPath(HISTORY_TEXT_FILE ".tmp"), dataPath(HISTORY_TEXT_FILE)) != 0 ||
+        rename(dataPath(HISTORY_BINARY_FILE), dataPath(HISTORY_BINARY_FILE ".old")) != 0) {
+        remove(dataPath(HISTORY_TEXT_FILE ".tmp"));
+        fprintf(stderr, "Error: history was not converted\n");
+        return 1;
+    }
+
+    printf("Converted %ld games to %s\n", log.count, dataPath(HISTORY_TEXT_FILE));
+    return 0;
+}
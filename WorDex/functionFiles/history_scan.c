@@ -0,0 +1,413 @@
+/* history_scan.c
+ *
+ * Scans the game history on many threads into a caller's aggregate.
+ *
+ * FUNCTIONALITY:
+ *  - historyScanText: maps history.txt, cuts it into chunks that end on a
+ *    '\n' and parses each chunk on its own worker, straight from the
+ *    mapping
+ *  - historyScanBinary: the same over record ranges of history.bin, read
+ *    with pread
+ *  - historyScanAll: whichever history is in use, from the start
+ *
+ * Worker 0 is the calling thread. When a worker has finished its chunk it
+ * joins its neighbours in a binary tree: at level L, worker i (a multiple
+ * of 2^(L+1)) waits for worker i + 2^L and merges that aggregate into its
+ * own, so merges run in parallel, each only ever joins chunks that are
+ * next to each other, and the result reaches worker 0 after log2(N)
+ * levels.
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#define _GNU_SOURCE
+#include <string.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "../headerFiles/history_scan.h"
+#include "../headerFiles/record_parser.h"
+#include "../headerFiles/data_dir.h"
+
+#define HISTORY_TEXT_FILE "history.txt"
+
+/* Longest unterminated last line that is still counted */
+#define SCAN_TAIL_MAX     256
+
+/* Records read per pread from history.bin */
+#define SCAN_BATCH        4096
+
+/* ScanWorker: one chunk of the history and the aggregate built from it */
+typedef struct ScanWorker {
+    const HistoryScanOps *ops;
+    struct ScanWorker    *all;
+    int                   index;
+    int                   count;
+
+    const char           *begin;     // text: [begin, end) holds whole lines
+    const char           *end;
+    const HistoryLog     *log;       // binary: records [first, last)
+    long                  first;
+    long                  last;
+
+    void                 *aggregate;
+    pthread_t             thread;
+    int                   started;
+    int                   failed;
+    pthread_mutex_t      *gate;      // held until every 'started' is known
+} ScanWorker;
+
+/* historyScanThreads: one worker per online CPU, capped */
+int historyScanThreads(void) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+    if (cpus < 1) {
+        return 1;
+    }
+    return cpus > HISTORY_SCAN_MAX_THREADS ? HISTORY_SCAN_MAX_THREADS : (int) cpus;
+}
+
+/* chunk_count: workers for 'units' of history, given the least per worker */
+static int chunk_count(uint64_t units, uint64_t minChunk, int threads) {
+    uint64_t n = units / minChunk;
+
+    if (threads <= 0) {
+        threads = historyScanThreads();
+    }
+    if (threads > HISTORY_SCAN_MAX_THREADS) {
+        threads = HISTORY_SCAN_MAX_THREADS;
+    }
+    if (n < 1) {
+        n = 1;
+    }
+    return n > (uint64_t) threads ? threads : (int) n;
+}
+
+/*
+ * add_line:
+ *   Parses the line of 'length' bytes at 'text', in place, into the
+ *   aggregate.
+ *
+ * RETURNS:
+ *   0 on success (bad lines are skipped), 1 if add ran out of memory.
+ */
+
+static int add_line(const HistoryScanOps *ops, void *aggregate, const char *text, size_t length) {
+    struct GameResult r;
+
+    if (recordParseGame(text, length, &r) != 1) {
+        return 0;
+    }
+    return ops->add(aggregate, &r, ops->arg);
+}
+
+/* scan_lines: adds every line of a text chunk; 0, or 1 if memory ran out */
+static int scan_lines(ScanWorker *w) {
+    const char *p = w->begin;
+
+    while (p < w->end) {
+        const char *newline = memchr(p, '\n', (size_t) (w->end - p));
+
+        if (newline == NULL) {
+            newline = w->end;
+        }
+        if (add_line(w->ops, w->aggregate, p, (size_t) (newline - p)) != 0) {
+            return 1;
+        }
+        p = newline + 1;
+    }
+    return 0;
+}
+
+/* scan_records: adds every record of a binary chunk; 0, or 1 if memory ran out */
+static int scan_records(ScanWorker *w) {
+    HistoryRecord *batch = malloc(sizeof(HistoryRecord) * SCAN_BATCH);
+    long next = w->first;
+
+    if (batch == NULL) {
+        return 1;
+    }
+    while (next < w->last) {
+        long want = (w->last - next < SCAN_BATCH) ? w->last - next : SCAN_BATCH;
+        long got = historyLogRead(w->log, next, want, batch);
+        long i;
+
+        if (got <= 0) {
+            break;
+        }
+        for (i = 0; i < got; i++) {
+            struct GameResult r;
+
+            if (historyRecordToResult(&batch[i], &r) == 0 &&
+                w->ops->add(w->aggregate, &r, w->ops->arg) != 0) {
+                free(batch);
+                return 1;
+            }
+        }
+        next = next + got;
+    }
+
+    free(batch);
+    return 0;
+}
+
+static void *run_worker(void *arg);
+
+/* finish_worker: waits for a worker's subtree, running it here if its thread never started */
+static void finish_worker(ScanWorker *w) {
+    if (w->started) {
+        pthread_join(w->thread, NULL);
+    } else {
+        run_worker(w);
+    }
+}
+
+/*
+ * run_worker:
+ *   Builds the aggregate of one chunk, then merges in the aggregates of
+ *   the workers below it in the reduction tree, nearest first.
+ */
+
+static void *run_worker(void *arg) {
+    ScanWorker *w = arg;
+    const HistoryScanOps *ops = w->ops;
+    int stride;
+
+    w->aggregate = ops->create(ops->arg);
+    if (w->aggregate == NULL) {
+        w->failed = 1;
+    } else {
+        w->failed = (w->log != NULL) ? scan_records(w) : scan_lines(w);
+    }
+
+    // Which neighbours are running on threads is only settled once all have been created
+    pthread_mutex_lock(w->gate);
+    pthread_mutex_unlock(w->gate);
+
+    for (stride = 1; w->index % (2 * stride) == 0 && w->index + stride < w->count; stride *= 2) {
+        ScanWorker *later = &w->all[w->index + stride];
+
+        finish_worker(later);
+        if (!w->failed && !later->failed) {
+            w->failed = ops->merge(w->aggregate, later->aggregate, ops->arg);
+        } else {
+            w->failed = 1;
+        }
+        if (later->aggregate != NULL) {
+            ops->destroy(later->aggregate, ops->arg);
+            later->aggregate = NULL;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * run_scan:
+ *   Starts workers 1..count-1 on their own threads, runs worker 0 here and
+ *   hands back the merged aggregate.
+ *
+ * RETURNS:
+ *   0 on success, 1 if any worker failed.
+ */
+
+static int run_scan(ScanWorker *workers, int count, const HistoryScanOps *ops, void **result) {
+    pthread_mutex_t gate = PTHREAD_MUTEX_INITIALIZER;
+    int i;
+
+    for (i = 0; i < count; i++) {
+        workers[i].ops = ops;
+        workers[i].all = workers;
+        workers[i].index = i;
+        workers[i].count = count;
+        workers[i].gate = &gate;
+    }
+    // A worker whose thread cannot start is run by the one that merges it
+    pthread_mutex_lock(&gate);
+    for (i = 1; i < count; i++) {
+        workers[i].started = (pthread_create(&workers[i].thread, NULL, run_worker, &workers[i]) == 0);
+    }
+    pthread_mutex_unlock(&gate);
+    run_worker(&workers[0]);
+    pthread_mutex_destroy(&gate);
+
+    if (workers[0].failed) {
+        if (workers[0].aggregate != NULL) {
+            ops->destroy(workers[0].aggregate, ops->arg);
+        }
+        return 1;
+    }
+    *result = workers[0].aggregate;
+    return 0;
+}
+
+/* empty_result: an aggregate of no games; 0, or 1 if memory ran out */
+static int empty_result(const HistoryScanOps *ops, void **result) {
+    *result = ops->create(ops->arg);
+    return *result == NULL;
+}
+
+/*
+ * historyScanText:
+ *   Maps the file, finds the last '\n', and moves each of the evenly spaced
+ *   chunk boundaries forward to just past the next '\n'.
+ *
+ * RETURNS:
+ *   0 on success, 1 on error.
+ */
+
+int historyScanText(int fd, uint64_t start, int threads, const HistoryScanOps *ops,
+                    void **result, uint64_t *end) {
+    ScanWorker *workers;
+    struct stat st;
+    const char *map;
+    const char *last;
+    uint64_t size, stop, previous;
+    int count, i, failed;
+
+    *end = start;
+    if (fstat(fd, &st) != 0) {
+        return 1;
+    }
+    size = (uint64_t) st.st_size;
+    if (start >= size) {
+        return empty_result(ops, result);
+    }
+
+    map = mmap(NULL, (size_t) size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map == MAP_FAILED) {
+        return 1;
+    }
+    madvise((void *) map, (size_t) size, MADV_SEQUENTIAL);
+
+    last = memrchr(map + start, '\n', (size_t) (size - start));
+    stop = (last != NULL) ? (uint64_t) (last - map) + 1 : start;
+
+    count = chunk_count(stop - start, HISTORY_SCAN_MIN_CHUNK, threads);
+    workers = calloc((size_t) count, sizeof(ScanWorker));
+    if (workers == NULL) {
+        munmap((void *) map, (size_t) size);
+        return 1;
+    }
+
+    previous = start;
+    for (i = 0; i < count; i++) {
+        uint64_t boundary = stop;
+
+        if (i < count - 1) {
+            uint64_t nominal = start + (stop - start) * (uint64_t) (i + 1) / (uint64_t) count;
+            const char *newline;
+
+            if (nominal < previous) {
+                nominal = previous;
+            }
+            newline = memchr(map + nominal, '\n', (size_t) (stop - nominal));
+            boundary = (newline != NULL) ? (uint64_t) (newline - map) + 1 : stop;
+        }
+        workers[i].begin = map + previous;
+        workers[i].end = map + boundary;
+        previous = boundary;
+    }
+
+    failed = run_scan(workers, count, ops, result);
+    if (!failed) {
+        *end = stop;
+    }
+
+    free(workers);
+    munmap((void *) map, (size_t) size);
+    return failed;
+}
+
+/*
+ * historyScanBinary:
+ *   Splits the records evenly; every boundary is already a record boundary.
+ *
+ * RETURNS:
+ *   0 on success, 1 on error.
+ */
+
+int historyScanBinary(const HistoryLog *log, long first, int threads, const HistoryScanOps *ops,
+                      void **result) {
+    ScanWorker *workers;
+    long total;
+    int count, i, failed;
+
+    if (first < 0) {
+        first = 0;
+    }
+    if (first >= log->count) {
+        return empty_result(ops, result);
+    }
+    total = log->count - first;
+
+    count = chunk_count((uint64_t) total, HISTORY_SCAN_MIN_CHUNK / HISTORY_RECORD_SIZE, threads);
+    workers = calloc((size_t) count, sizeof(ScanWorker));
+    if (workers == NULL) {
+        return 1;
+    }
+    for (i = 0; i < count; i++) {
+        workers[i].log = log;
+        workers[i].first = first + (long) ((uint64_t) total * (uint64_t) i / (uint64_t) count);
+        workers[i].last = first + (long) ((uint64_t) total * (uint64_t) (i + 1) / (uint64_t) count);
+    }
+
+    failed = run_scan(workers, count, ops, result);
+    free(workers);
+    return failed;
+}
+
+/*
+ * scan_text_file:
+ *   historyScanText over the whole of history.txt, then the unterminated
+ *   last line, if any, on top.
+ *
+ * RETURNS:
+ *   0 on success, 1 on error.
+ */
+
+static int scan_text_file(int threads, const HistoryScanOps *ops, void **result) {
+    char tail[SCAN_TAIL_MAX];
+    uint64_t end;
+    ssize_t got;
+    int fd = open(dataPath(HISTORY_TEXT_FILE), O_RDONLY);
+
+    if (fd < 0) {
+        return empty_result(ops, result);   // no history yet
+    }
+    if (historyScanText(fd, 0, threads, ops, result, &end) != 0) {
+        close(fd);
+        return 1;
+    }
+
+    got = pread(fd, tail, sizeof(tail), (off_t) end);
+    close(fd);
+    if (got > 0) {
+        const char *newline = memchr(tail, '\n', (size_t) got);
+        size_t length = (newline != NULL) ? (size_t) (newline - tail) : (size_t) got;
+
+        if (add_line(ops, *result, tail, length) != 0) {
+            ops->destroy(*result, ops->arg);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* historyScanAll: scans history.bin or history.txt, whichever is in use */
+int historyScanAll(int threads, const HistoryScanOps *ops, void **result) {
+    HistoryLog log;
+    int failed;
+
+    if (!historyBinaryEnabled()) {
+        return scan_text_file(threads, ops, result);
+    }
+    if (historyLogOpen(&log, dataPath(HISTORY_BINARY_FILE)) != 0) {
+        return empty_result(ops, result);
+    }
+    failed = historyScanBinary(&log, 0, threads, ops, result);
+    historyLogClose(&log);
+    return failed;
+}
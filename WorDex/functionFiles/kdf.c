@@ -0,0 +1,570 @@
+/* kdf.c
+ *
+ * Password key derivation for the Wordex game.
+ *
+ * FUNCTIONALITY:
+ *  - sha256 / pbkdf2HmacSha256: SHA-256 (FIPS 180-4) and PBKDF2-HMAC-SHA256
+ *    (RFC 8018), implemented here so the game needs no crypto library
+ *  - kdfHash / kdfVerify: the stored "pbkdf2$<iterations>$<salt>$<key>"
+ *    strings, with a random per-user salt from /dev/urandom
+ *  - kdfIterations / kdfNeedsUpgrade: the configured work factor and
+ *    whether a stored hash is below it
+ *  - calibrateKdf: measures this machine and saves the iteration count
+ *    that meets a login latency target to textFiles/kdf.conf
+ *
+ * Each PBKDF2 iteration is two SHA-256 compressions: the HMAC inner and
+ * outer key blocks are hashed once up front, and the fixed-size message
+ * blocks of the iteration loop are padded once.
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "../headerFiles/kdf.h"
+#include "../headerFiles/data_dir.h"
+
+/* Sha256:
+ *   Running SHA-256 state: chaining value, pending block, bytes hashed.
+ */
+typedef struct {
+    uint32_t state[8];
+    uint8_t  block[64];
+    size_t   used;
+    uint64_t length;
+} Sha256;
+
+static const uint32_t K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static const uint32_t INITIAL_STATE[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+#define ROTR(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+/*
+ * compress:
+ *   The SHA-256 compression function on one 64-byte block.
+ */
+
+static void compress(uint32_t state[8], const uint8_t block[64]) {
+    uint32_t w[64];
+    uint32_t a, b, c, d, e, f, g, h;
+    int i;
+
+    for (i = 0; i < 16; i++) {
+        w[i] = ((uint32_t) block[4 * i] << 24) | ((uint32_t) block[4 * i + 1] << 16) |
+               ((uint32_t) block[4 * i + 2] << 8) | (uint32_t) block[4 * i + 3];
+    }
+    for (i = 16; i < 64; i++) {
+        uint32_t s0 = ROTR(w[i - 15], 7) ^ ROTR(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = ROTR(w[i - 2], 17) ^ ROTR(w[i - 2], 19) ^ (w[i - 2] >> 10);
+
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    a = state[0]; b = state[1]; c = state[2]; d = state[3];
+    e = state[4]; f = state[5]; g = state[6]; h = state[7];
+
+    for (i = 0; i < 64; i++) {
+        uint32_t t1 = h + (ROTR(e, 6) ^ ROTR(e, 11) ^ ROTR(e, 25)) + ((e & f) ^ (~e & g)) + K[i] + w[i];
+        uint32_t t2 = (ROTR(a, 2) ^ ROTR(a, 13) ^ ROTR(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+
+        h = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
+    }
+
+    state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+    state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+}
+
+static void sha256_init(Sha256 *ctx) {
+    memcpy(ctx->state, INITIAL_STATE, sizeof(INITIAL_STATE));
+    ctx->used = 0;
+    ctx->length = 0;
+}
+
+static void sha256_update(Sha256 *ctx, const uint8_t *data, size_t length) {
+    ctx->length = ctx->length + length;
+
+    while (length > 0) {
+        size_t n = 64 - ctx->used;
+
+        if (n > length) {
+            n = length;
+        }
+        memcpy(ctx->block + ctx->used, data, n);
+        ctx->used = ctx->used + n;
+        data = data + n;
+        length = length - n;
+
+        if (ctx->used == 64) {
+            compress(ctx->state, ctx->block);
+            ctx->used = 0;
+        }
+    }
+}
+
+/* store_be32: writes the chaining value as big-endian digest bytes */
+static void store_be32(const uint32_t state[8], uint8_t digest[32]) {
+    int i;
+
+    for (i = 0; i < 8; i++) {
+        digest[4 * i]     = (uint8_t) (state[i] >> 24);
+        digest[4 * i + 1] = (uint8_t) (state[i] >> 16);
+        digest[4 * i + 2] = (uint8_t) (state[i] >> 8);
+        digest[4 * i + 3] = (uint8_t) state[i];
+    }
+}
+
+static void sha256_final(Sha256 *ctx, uint8_t digest[32]) {
+    uint64_t bits = ctx->length * 8;
+    int i;
+
+    ctx->block[ctx->used++] = 0x80;
+    if (ctx->used > 56) {
+        memset(ctx->block + ctx->used, 0, 64 - ctx->used);
+        compress(ctx->state, ctx->block);
+        ctx->used = 0;
+    }
+    memset(ctx->block + ctx->used, 0, 56 - ctx->used);
+    for (i = 0; i < 8; i++) {
+        ctx->block[56 + i] = (uint8_t) (bits >> (56 - 8 * i));
+    }
+    compress(ctx->state, ctx->block);
+    store_be32(ctx->state, digest);
+}
+
+/*
+ * sha256:
+ *   One-shot SHA-256 digest.
+ */
+
+void sha256(const uint8_t *data, size_t length, uint8_t digest[32]) {
+    Sha256 ctx;
+
+    sha256_init(&ctx);
+    sha256_update(&ctx, data, length);
+    sha256_final(&ctx, digest);
+}
+
+/*
+ * hmac_keys:
+ *   Starts the HMAC inner and outer hashes: both have absorbed their
+ *   64-byte padded key block and are reused for every message.
+ */
+
+static void hmac_keys(const uint8_t *key, size_t keyLength, Sha256 *inner, Sha256 *outer) {
+    uint8_t block[64];
+    uint8_t hashedKey[32];
+    int i;
+
+    if (keyLength > 64) {
+        sha256(key, keyLength, hashedKey);
+        key = hashedKey;
+        keyLength = 32;
+    }
+
+    memset(block, 0, sizeof(block));
+    memcpy(block, key, keyLength);
+
+    for (i = 0; i < 64; i++) {
+        block[i] ^= 0x36;
+    }
+    sha256_init(inner);
+    sha256_update(inner, block, 64);
+
+    for (i = 0; i < 64; i++) {
+        block[i] ^= 0x36 ^ 0x5c;
+    }
+    sha256_init(outer);
+    sha256_update(outer, block, 64);
+}
+
+/*
+ * pbkdf2HmacSha256:
+ *   T_i = U_1 ^ ... ^ U_c with U_1 = HMAC(P, S || INT(i)) and
+ *   U_j = HMAC(P, U_{j-1}). After U_1 every HMAC input is 32 bytes, so each
+ *   U_j is one compression from the inner state and one from the outer
+ *   state on a pre-padded block.
+ */
+
+void pbkdf2HmacSha256(const uint8_t *password, size_t passwordLength,
+                      const uint8_t *salt, size_t saltLength,
+                      uint32_t iterations, uint8_t *key, size_t keyLength) {
+    Sha256 inner, outer;
+    uint8_t block[64];
+    uint32_t blockIndex = 1;
+    int i;
+
+    hmac_keys(password, passwordLength, &inner, &outer);
+
+    // 32 message bytes after a 64-byte key block: 96 bytes = 768 bits
+    memset(block, 0, sizeof(block));
+    block[32] = 0x80;
+    block[62] = 0x03;
+    block[63] = 0x00;
+
+    while (keyLength > 0) {
+        uint8_t u[32];
+        uint8_t t[32];
+        uint8_t counter[4];
+        Sha256 ctx;
+        size_t n = keyLength < 32 ? keyLength : 32;
+        uint32_t j;
+
+        counter[0] = (uint8_t) (blockIndex >> 24);
+        counter[1] = (uint8_t) (blockIndex >> 16);
+        counter[2] = (uint8_t) (blockIndex >> 8);
+        counter[3] = (uint8_t) blockIndex;
+
+        // U_1 = HMAC(P, S || INT(i))
+        ctx = inner;
+        sha256_update(&ctx, salt, saltLength);
+        sha256_update(&ctx, counter, 4);
+        sha256_final(&ctx, u);
+        ctx = outer;
+        sha256_update(&ctx, u, 32);
+        sha256_final(&ctx, u);
+        memcpy(t, u, 32);
+
+        for (j = 1; j < iterations; j++) {
+            uint32_t state[8];
+
+            memcpy(block, u, 32);
+            memcpy(state, inner.state, sizeof(state));
+            compress(state, block);
+            store_be32(state, block);
+
+            memcpy(state, outer.state, sizeof(state));
+            compress(state, block);
+            store_be32(state, u);
+
+            for (i = 0; i < 32; i++) {
+                t[i] ^= u[i];
+            }
+        }
+
+        memcpy(key, t, n);
+        key = key + n;
+        keyLength = keyLength - n;
+        blockIndex = blockIndex + 1;
+    }
+}
+
+/* to_hex / from_hex: byte strings in the stored format */
+static void to_hex(const uint8_t *bytes, size_t length, char *out) {
+    size_t i;
+
+    for (i = 0; i < length; i++) {
+        sprintf(out + 2 * i, "%02x", bytes[i]);
+    }
+}
+
+static int from_hex(const char *text, size_t textLength, uint8_t *bytes, size_t length) {
+    size_t i;
+
+    if (textLength != 2 * length) {
+        return 1;
+    }
+    for (i = 0; i < length; i++) {
+        unsigned int byte;
+
+        if (sscanf(text + 2 * i, "%2x", &byte) != 1) {
+            return 1;
+        }
+        bytes[i] = (uint8_t) byte;
+    }
+    return 0;
+}
+
+/*
+ * read_iterations:
+ *   The "iterations=N" line of kdf.conf.
+ *
+ * RETURNS:
+ *   The count, or 0 if the file is missing or holds no usable count.
+ */
+
+static uint32_t read_iterations(void) {
+    FILE *fp = fopen(dataPath(KDF_CONFIG_FILE), "r");
+    unsigned long iterations = 0;
+    char line[100];
+
+    if (fp == NULL) {
+        return 0;
+    }
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        if (sscanf(line, "iterations=%lu", &iterations) == 1) {
+            break;
+        }
+    }
+    fclose(fp);
+
+    if (iterations < KDF_MIN_ITERATIONS || iterations > UINT32_MAX) {
+        return 0;
+    }
+    return (uint32_t) iterations;
+}
+
+/* kdf.conf as read by the first kdfIterations */
+static pthread_once_t iterationsOnce = PTHREAD_ONCE_INIT;
+static uint32_t configuredIterations;
+
+/* load_iterations: pthread_once callback for kdfIterations */
+static void load_iterations(void) {
+    uint32_t iterations = read_iterations();
+
+    configuredIterations = iterations != 0 ? iterations : KDF_DEFAULT_ITERATIONS;
+}
+
+/*
+ * kdfIterations:
+ *   Work factor for new hashes. kdf.conf is read once per process: every
+ *   hash and upgrade check after that uses the same count.
+ *
+ * RETURNS:
+ *   The calibrated iteration count, or KDF_DEFAULT_ITERATIONS.
+ */
+
+uint32_t kdfIterations(void) {
+    pthread_once(&iterationsOnce, load_iterations);
+    return configuredIterations;
+}
+
+/*
+ * hash_with:
+ *   Formats "pbkdf2$<iterations>$<salt hex>$<key hex>" into 'out'.
+ */
+
+static void hash_with(const char *password, const uint8_t *salt, uint32_t iterations, char *out) {
+    uint8_t key[KDF_KEY_BYTES];
+    int length;
+
+    pbkdf2HmacSha256((const uint8_t *) password, strlen(password), salt, KDF_SALT_BYTES,
+                     iterations, key, sizeof(key));
+
+    length = sprintf(out, "%s%lu$", KDF_PREFIX, (unsigned long) iterations);
+    to_hex(salt, KDF_SALT_BYTES, out + length);
+    length = length + 2 * KDF_SALT_BYTES;
+    out[length] = '$';
+    to_hex(key, sizeof(key), out + length + 1);
+}
+
+/*
+ * kdfHash:
+ *   Hash for a new or upgraded password.
+ *
+ * RETURNS:
+ *   0 on success, 1 if /dev/urandom cannot be read.
+ */
+
+int kdfHash(const char *password, char *out) {
+    uint8_t salt[KDF_SALT_BYTES];
+    FILE *fp = fopen("/dev/urandom", "rb");
+    size_t got = 0;
+
+    if (fp != NULL) {
+        got = fread(salt, 1, sizeof(salt), fp);
+        fclose(fp);
+    }
+    if (got != sizeof(salt)) {
+        return 1;
+    }
+
+    hash_with(password, salt, kdfIterations(), out);
+    return 0;
+}
+
+/*
+ * parse_stored:
+ *   Splits a stored hash into its iteration count, salt and key.
+ *
+ * RETURNS:
+ *   0 on success, 1 if it is not a well-formed PBKDF2 hash.
+ */
+
+static int parse_stored(const char *stored, uint32_t *iterations, uint8_t *salt, uint8_t *key) {
+    const char *p;
+    const char *dollar;
+    char *end;
+    unsigned long count;
+
+    if (strncmp(stored, KDF_PREFIX, strlen(KDF_PREFIX)) != 0) {
+        return 1;
+    }
+    p = stored + strlen(KDF_PREFIX);
+
+    count = strtoul(p, &end, 10);
+    if (end == p || *end != '$' || count == 0 || count > UINT32_MAX) {
+        return 1;
+    }
+    p = end + 1;
+
+    dollar = strchr(p, '$');
+    if (dollar == NULL || from_hex(p, (size_t) (dollar - p), salt, KDF_SALT_BYTES) != 0 ||
+        from_hex(dollar + 1, strlen(dollar + 1), key, KDF_KEY_BYTES) != 0) {
+        return 1;
+    }
+    *iterations = (uint32_t) count;
+    return 0;
+}
+
+/*
+ * kdfVerify:
+ *   Recomputes the key with the stored salt and iteration count and
+ *   compares it without an early exit.
+ *
+ * RETURNS:
+ *   0 if the password matches, 1 otherwise.
+ */
+
+int kdfVerify(const char *password, const char *stored) {
+    uint8_t salt[KDF_SALT_BYTES];
+    uint8_t expected[KDF_KEY_BYTES];
+    uint8_t key[KDF_KEY_BYTES];
+    uint32_t iterations;
+    uint8_t difference = 0;
+    size_t i;
+
+    if (parse_stored(stored, &iterations, salt, expected) != 0) {
+        return 1;
+    }
+
+    pbkdf2HmacSha256((const uint8_t *) password, strlen(password), salt, sizeof(salt),
+                     iterations, key, sizeof(key));
+
+    for (i = 0; i < sizeof(key); i++) {
+        difference |= key[i] ^ expected[i];
+    }
+    return difference != 0;
+}
+
+/*
+ * kdfNeedsUpgrade:
+ *   Whether a successful login should re-hash the password.
+ *
+ * RETURNS:
+ *   1 for legacy hashes and weaker work factors, 0 otherwise.
+ */
+
+int kdfNeedsUpgrade(const char *stored) {
+    uint8_t salt[KDF_SALT_BYTES];
+    uint8_t key[KDF_KEY_BYTES];
+    uint32_t iterations;
+
+    if (parse_stored(stored, &iterations, salt, key) != 0) {
+        return 1;
+    }
+    return iterations < kdfIterations();
+}
+
+/* now_ms: monotonic clock in milliseconds */
+static double now_ms(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec * 1e3 + (double) ts.tv_nsec / 1e6;
+}
+
+/*
+ * time_pbkdf2:
+ *   Fastest of three runs of a login's PBKDF2 at 'iterations', in ms.
+ */
+
+static double time_pbkdf2(uint32_t iterations) {
+    static const uint8_t salt[KDF_SALT_BYTES] = "calibrate-salt!";
+    uint8_t key[KDF_KEY_BYTES];
+    double best = 0.0;
+    int run;
+
+    for (run = 0; run < 3; run++) {
+        double start = now_ms();
+        double elapsed;
+
+        pbkdf2HmacSha256((const uint8_t *) "Calibrate@123", 13, salt, sizeof(salt),
+                         iterations, key, sizeof(key));
+        elapsed = now_ms() - start;
+        if (run == 0 || elapsed < best) {
+            best = elapsed;
+        }
+    }
+    return best;
+}
+
+/*
+ * calibrateKdf:
+ *   Scales a short probe run up to the target, then times the chosen
+ *   count once more and corrects for the difference.
+ *
+ * RETURNS:
+ *   0 on success, 1 if the target is invalid or kdf.conf cannot be written.
+ */
+
+int calibrateKdf(int targetMs) {
+    uint32_t iterations = KDF_MIN_ITERATIONS;
+    double elapsed;
+    double scaled;
+    int round;
+    FILE *fp;
+
+    if (targetMs < 1) {
+        fprintf(stderr, "Error: --calibrate-kdf expects a positive number of milliseconds\n");
+        return 1;
+    }
+
+    elapsed = time_pbkdf2(iterations);
+    for (round = 0; round < 2; round++) {
+        scaled = (double) iterations * targetMs / (elapsed > 0.001 ? elapsed : 0.001);
+        if (scaled < KDF_MIN_ITERATIONS) {
+            scaled = KDF_MIN_ITERATIONS;
+        }
+        if (scaled > UINT32_MAX) {
+            scaled = UINT32_MAX;
+        }
+        iterations = (uint32_t) scaled;
+        elapsed = time_pbkdf2(iterations);
+    }
+
+    // Round to a readable number: three significant digits
+    {
+        uint32_t unit = 1;
+
+        while (iterations / unit >= 1000) {
+            unit = unit * 10;
+        }
+        iterations = iterations / unit * unit;
+        if (iterations < KDF_MIN_ITERATIONS) {
+            iterations = KDF_MIN_ITERATIONS;
+        }
+    }
+
+    fp = fopen(dataPath(KDF_CONFIG_FILE ".tmp"), "w");
+    if (fp == NULL) {
+        fprintf(stderr, "Error: Cannot write %s\n", dataPath(KDF_CONFIG_FILE));
+        return 1;
+    }
+    fprintf(fp, "# PBKDF2-HMAC-SHA256 work factor, written by --calibrate-kdf %d\n", targetMs);
+    fprintf(fp, "iterations=%lu\n", (unsigned long) iterations);
+    if (fclose(fp) != 0 || rename(dataPath(KDF_CONFIG_FILE ".tmp"), dataPath(KDF_CONFIG_FILE)) != 0) {
+        remove(dataPath(KDF_CONFIG_FILE ".tmp"));
+        fprintf(stderr, "Error: Cannot write %s\n", dataPath(KDF_CONFIG_FILE));
+        return 1;
+    }
+
+    printf("PBKDF2-HMAC-SHA256: %lu iterations take %.1f ms on this machine (target %d ms)\n",
+           (unsigned long) iterations, time_pbkdf2(iterations), targetMs);
+    printf("Saved to %s; passwords are upgraded to it at their next login\n", dataPath(KDF_CONFIG_FILE));
+    return 0;
+}
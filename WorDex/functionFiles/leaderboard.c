@@ -6,8 +6,23 @@
  *  - Reads all completed games from history.txt
  *  - Aggregates per-player stats (games played, wins, losses, total guesses)
  *  - Computes win rate and average guesses per player
- *  - Sorts players in descending order of wins
- *  - Prints a coloured leaderboard table to the terminal
+ *  - Sorts players by wins, then win rate, then fewest average guesses
+ *  - Prints a coloured leaderboard table to the terminal, either every
+ *    player or only the top N
+ *
+ * Players are found through an open-addressing hash table on the username
+ * that grows with the history, so there is no cap on the number of players
+ * and each history line costs O(1). The full table is ordered with qsort;
+ * a top-N request keeps only a bounded min-heap of the N best players.
+ *
+ * History only ever grows, so the per-player totals are saved to
+ * leaderboard.snap together with the byte offset, device and inode they
+ * cover. Each view loads the snapshot, parses only the lines appended
+ * since and moves the checkpoint forward; if history was truncated or
+ * replaced the snapshot no longer matches and it is rebuilt from scratch.
+ * The same works for the binary history.bin, where the checkpoint is a
+ * record boundary. The new part is read by the parallel history scanner,
+ * each worker counting into a PlayerTable of its own that is then merged.
  *
  * AUTHOR:  Lohitashwa Madhan
  * DATE:    2nd December, 2025
@@ -15,13 +30,74 @@
  */
 
 #include <stdio.h>
+#include <stdint.h>
 #include <string.h>
+#include <strings.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
 #include "../headerFiles/leaderboard.h"
-
-#define HISTORY_FILE   "textFiles/history.txt"
+#include "../headerFiles/history_binary.h"
+#include "../headerFiles/history_scan.h"
+#include "../headerFiles/record_parser.h"
+#include "../headerFiles/profile.h"
+#include "../headerFiles/data_dir.h"
+#include "../headerFiles/name_hash.h"
+
+#define HISTORY_FILE   "history.txt"
+#define SNAPSHOT_FILE  "leaderboard.snap"
 #define COLOR_MAGENTA  "\033[35m"
 #define COLOR_RESET    "\033[0m"
 
+/* Initial number of hash slots; always a power of two */
+#define INITIAL_SLOTS  256
+
+/* Longest unterminated last line of history.txt that is still counted */
+#define TAIL_MAX       256
+
+/* Snapshot identification, and how many bytes before the checkpoint are
+ * hashed to notice a history file that was rewritten in place
+ */
+#define SNAPSHOT_MAGIC    "WXLBSNP"
+#define SNAPSHOT_VERSION  1
+#define SIGNATURE_BYTES   64
+
+/* SnapshotHeader:
+ *   Start of the snapshot file, followed by 'count' SnapshotRecords.
+ */
+struct SnapshotHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t count;
+    uint64_t device;      // st_dev of the history file it covers
+    uint64_t inode;       // st_ino of the history file it covers
+    uint64_t offset;      // bytes of history counted; always ends on a '\n'
+    uint64_t signature;   // hash of the SIGNATURE_BYTES before 'offset'
+};
+
+/* SnapshotRecord:
+ *   Saved totals for one player (averages are recomputed on load).
+ */
+struct SnapshotRecord {
+    char    username[NAME_MAX_LEN];
+    int32_t gamesPlayed;
+    int32_t wins;
+    int32_t losses;
+    int32_t totalGuesses;
+};
+
+/* PlayerTable:
+ *   Growable array of entries plus an open-addressing index into it.
+ *   slots[i] holds entry index + 1, or 0 for an empty slot.
+ */
+struct PlayerTable {
+    struct LeaderboardEntry *entries;
+    int                      count;
+    int                      capacity;
+    int                     *slots;
+    uint32_t                 mask;
+};
+
 /* init_entry:
  *   Initializes one leaderboard entry for a player.
  *   PARAMETERS:
@@ -44,174 +120,643 @@ static void init_entry(struct LeaderboardEntry *e, const char *username) {
     e->winRate      = 0.0;
 }
 
-/* find_user:
- *   Searches for a username in the entries array.
- *   PARAMETERS:
- *     entries  - array of LeaderboardEntry structures
- *     count    - number of valid entries stored in the array
- *     username - name to search for
+/* rebuild_index:
+ *   Replaces the hash index with one of 'size' slots (a power of two)
+ *   holding every known player.
  *   RETURNS:
- *     Index of the matching entry, or -1 if not found.
+ *     0 on success, 1 if memory ran out (the old index is kept).
  */
-static int find_user(struct LeaderboardEntry *entries, int count, const char *username) {
-    int i = 0;
 
-    while (i < count) {
-        if (strcmp(entries[i].username, username) == 0) {
-            return i;
+static int rebuild_index(struct PlayerTable *t, uint32_t size) {
+    int *slots = calloc(size, sizeof(int));
+    int i;
+
+    if (slots == NULL) {
+        return 1;
+    }
+
+    for (i = 0; i < t->count; i++) {
+        uint32_t h = hashUsername(t->entries[i].username) & (size - 1);
+
+        while (slots[h] != 0) {
+            h = (h + 1) & (size - 1);
         }
-        i = i + 1;
+        slots[h] = i + 1;
     }
-    return -1;
+
+    free(t->slots);
+    t->slots = slots;
+    t->mask = size - 1;
+    return 0;
 }
 
-/* read_game_lb:
- *   Reads one game record from the history file into *r.
- *   File format: username word guesses won timestamp
- *   PARAMETERS:
- *     fp - open FILE pointer for the history file
- *     r  - pointer to GameResult struct to fill
+/* find_or_add_user:
+ *   Looks a username up in the table, adding a fresh entry if it is new.
+ *   The index is built on first use, so a snapshot with nothing new to
+ *   merge never pays for hashing its players.
+ *   RETURNS:
+ *     Index of the player's entry, or -1 if memory ran out.
+ */
+
+static int find_or_add_user(struct PlayerTable *t, const char *username) {
+    uint32_t h;
+
+    // Keep the index at most half full so probes stay short
+    if (t->slots == NULL || (uint32_t) (t->count + 1) * 2 > t->mask + 1) {
+        uint32_t size = INITIAL_SLOTS;
+
+        while (size < (uint32_t) (t->count + 1) * 2) {
+            size = size * 2;
+        }
+        if (t->slots != NULL && size == t->mask + 1) {
+            size = size * 2;
+        }
+        if (rebuild_index(t, size) != 0) {
+            return -1;
+        }
+    }
+
+    h = hashUsername(username) & t->mask;
+    while (t->slots[h] != 0) {
+        int idx = t->slots[h] - 1;
+
+        if (strcmp(t->entries[idx].username, username) == 0) {
+            return idx;
+        }
+        h = (h + 1) & t->mask;
+    }
+
+    if (t->count == t->capacity) {
+        int capacity = t->capacity * 2;
+        struct LeaderboardEntry *grown =
+            realloc(t->entries, sizeof(struct LeaderboardEntry) * (size_t) capacity);
+
+        if (grown == NULL) {
+            return -1;
+        }
+        t->entries = grown;
+        t->capacity = capacity;
+    }
+
+    init_entry(&t->entries[t->count], username);
+    t->slots[h] = t->count + 1;
+    t->count = t->count + 1;
+    return t->count - 1;
+}
+
+/* add_result:
+ *   Merges one game into its player's entry.
  *   RETURNS:
- *     1 if a full record (5 values) is read successfully,
- *     0 otherwise (EOF or bad line).
+ *     0 on success, 1 if memory ran out.
  */
 
-static int read_game_lb(FILE *fp, struct GameResult *r) {
-    int scanned;
+static int add_result(struct PlayerTable *t, const struct GameResult *r) {
+    int idx;
+
+    idx = find_or_add_user(t, r->username);
+    if (idx == -1) {
+        return 1;
+    }
 
-    // Reads one line of game info into the GameResult struct 
-    scanned = fscanf(fp, "%31s %5s %d %d %19s",
-                     r->username,
-                     r->word,
-                     &r->guesses,
-                     &r->won,
-                     r->timestamp);
+    // Updates the stats for this player's entry 
+    t->entries[idx].gamesPlayed  = t->entries[idx].gamesPlayed + 1;
+    t->entries[idx].totalGuesses = t->entries[idx].totalGuesses + r->guesses;
 
-    if (scanned == 5) {
-        return 1; 
+    if (r->won == 1) {
+        t->entries[idx].wins = t->entries[idx].wins + 1;
+    } else {
+        t->entries[idx].losses = t->entries[idx].losses + 1;
     }
-    return 0; 
+    return 0;
 }
 
-/* build_leaderboard:
- *   Builds per-player stats from all entries in history.txt.
- *   PARAMETERS:
- *     entries - array of LeaderboardEntry to fill
- *     count   - pointer to an int where the number of players is stored
- *   SIDE EFFECTS:
- *     - Reads all games from HISTORY_FILE if it exists
- *     - For each player, updates gamesPlayed, wins, losses, totalGuesses
- *     - Computes avgGuesses and winRate for each entry
+/* add_game:
+ *   Merges the history line of 'length' bytes at 'line' into its
+ *   player's entry. Lines that are not a full record are skipped.
+ *   RETURNS:
+ *     0 on success, 1 if memory ran out.
  */
 
-static void build_leaderboard(struct LeaderboardEntry *entries, int *count) {
-    FILE *fp;
+static int add_game(struct PlayerTable *t, const char *line, size_t length) {
     struct GameResult r;
-    int ok;
-    int idx;
 
-    *count = 0;  //Starts with zero players in the leaderboard
+    if (recordParseGame(line, length, &r) != 1) {
+        return 0;
+    }
+    return add_result(t, &r);
+}
+
+/* table_init:
+ *   Starts an empty player table.
+ *   RETURNS:
+ *     0 on success, 1 if memory ran out.
+ */
+
+static int table_init(struct PlayerTable *t) {
+    t->count    = 0;  //Starts with zero players in the leaderboard
+    t->capacity = INITIAL_SLOTS / 2;
+    t->slots    = NULL;
+    t->mask     = 0;
+    t->entries  = malloc(sizeof(struct LeaderboardEntry) * (size_t) t->capacity);
+
+    return t->entries == NULL;
+}
+
+/* merge_tables:
+ *   Adds every player's totals in 'from' to the same player in 'into'.
+ *   RETURNS:
+ *     0 on success, 1 if memory ran out.
+ */
 
-    fp = fopen(HISTORY_FILE, "r"); // Opens the history file in read mode
+static int merge_tables(struct PlayerTable *into, const struct PlayerTable *from) {
+    int i;
 
-    // Read each game line and add its data into the correct player entry 
-    ok = read_game_lb(fp, &r);
-    while (ok == 1) {
-        idx = find_user(entries, *count, r.username);
+    for (i = 0; i < from->count; i++) {
+        const struct LeaderboardEntry *e = &from->entries[i];
+        int idx = find_or_add_user(into, e->username);
 
         if (idx == -1) {
-            if (*count < MAX_USERS) {
-                idx = *count;
-                init_entry(&entries[idx], r.username);
-                *count = *count + 1;
-            } 
+            return 1;
         }
+        into->entries[idx].gamesPlayed  = into->entries[idx].gamesPlayed + e->gamesPlayed;
+        into->entries[idx].wins         = into->entries[idx].wins + e->wins;
+        into->entries[idx].losses       = into->entries[idx].losses + e->losses;
+        into->entries[idx].totalGuesses = into->entries[idx].totalGuesses + e->totalGuesses;
+    }
+    return 0;
+}
 
-        if (idx != -1) {
-            // Updates the stats for this player's entry 
-            entries[idx].gamesPlayed  = entries[idx].gamesPlayed + 1;
-            entries[idx].totalGuesses = entries[idx].totalGuesses + r.guesses;
+/* scan_create / scan_add / scan_merge / scan_destroy:
+ *   A PlayerTable as the history scanner's per-worker aggregate.
+ */
 
-            if (r.won == 1) {
-                entries[idx].wins = entries[idx].wins + 1;
-            } else {
-                entries[idx].losses = entries[idx].losses + 1;
-            }
+static void *scan_create(void *arg) {
+    struct PlayerTable *t = malloc(sizeof(struct PlayerTable));
+
+    (void) arg;
+    if (t != NULL && table_init(t) != 0) {
+        free(t);
+        return NULL;
+    }
+    return t;
+}
+
+static int scan_add(void *aggregate, const struct GameResult *r, void *arg) {
+    (void) arg;
+    return add_result(aggregate, r);
+}
+
+static int scan_merge(void *into, void *later, void *arg) {
+    (void) arg;
+    return merge_tables(into, later);
+}
+
+static void scan_destroy(void *aggregate, void *arg) {
+    struct PlayerTable *t = aggregate;
+
+    (void) arg;
+    free(t->entries);
+    free(t->slots);
+    free(t);
+}
+
+static const HistoryScanOps playerScan = {scan_create, scan_add, scan_merge, scan_destroy, NULL};
+
+/* merge_scan:
+ *   Adds a finished scan's totals to the table and frees the scan.
+ *   RETURNS:
+ *     0 on success, 1 if memory ran out.
+ */
+
+static int merge_scan(struct PlayerTable *t, void *scanned) {
+    int failed = merge_tables(t, scanned);
+
+    scan_destroy(scanned, NULL);
+    return failed;
+}
+
+/* history_signature:
+ *   Hashes the SIGNATURE_BYTES of history that end at 'offset', so a file
+ *   that was rewritten in place (same inode, at least as long) is still
+ *   noticed.
+ *   RETURNS:
+ *     FNV-1a 64 hash of those bytes, 0 if they could not be read.
+ */
+
+static uint64_t history_signature(int fd, uint64_t offset) {
+    unsigned char buffer[SIGNATURE_BYTES];
+    size_t want = offset < SIGNATURE_BYTES ? (size_t) offset : SIGNATURE_BYTES;
+    uint64_t h = 14695981039346656037ULL;
+    size_t i;
+
+    if (pread(fd, buffer, want, (off_t) (offset - want)) != (ssize_t) want) {
+        return 0;
+    }
+    for (i = 0; i < want; i++) {
+        h = (h ^ buffer[i]) * 1099511628211ULL;
+    }
+    return h;
+}
+
+/* load_snapshot:
+ *   Loads the saved per-player totals if they still describe a prefix of
+ *   this history file: same device and inode, the file is at least as long
+ *   as the covered prefix, and the bytes just before the checkpoint match.
+ *   PARAMETERS:
+ *     t  - empty player table to fill
+ *     fd - descriptor of the open history file
+ *     st - fstat of the history file
+ *   RETURNS:
+ *     Bytes of history already counted in the table, or 0 (with the table
+ *     still empty) when there is no usable snapshot and history must be
+ *     read from the start.
+ */
+
+static uint64_t load_snapshot(struct PlayerTable *t, int fd, const struct stat *st) {
+    struct SnapshotHeader header;
+    struct SnapshotRecord record;
+    FILE *fp;
+    uint32_t i;
+
+    fp = fopen(dataPath(SNAPSHOT_FILE), "rb");
+    if (fp == NULL) {
+        return 0;
+    }
+
+    if (fread(&header, sizeof(header), 1, fp) != 1 ||
+        memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != SNAPSHOT_VERSION ||
+        header.device != (uint64_t) st->st_dev ||
+        header.inode != (uint64_t) st->st_ino ||
+        header.offset > (uint64_t) st->st_size ||
+        header.signature != history_signature(fd, header.offset)) {
+        // Truncated, replaced or rewritten: start again from byte zero
+        fclose(fp);
+        return 0;
+    }
+
+    if ((int) header.count > t->capacity) {
+        struct LeaderboardEntry *grown =
+            realloc(t->entries, sizeof(struct LeaderboardEntry) * header.count);
+
+        if (grown == NULL) {
+            fclose(fp);
+            return 0;
         }
-       //Reads the next game from the history.txt file 
-        ok = read_game_lb(fp, &r);
+        t->entries = grown;
+        t->capacity = (int) header.count;
     }
 
+    for (i = 0; i < header.count; i++) {
+        struct LeaderboardEntry *e = &t->entries[i];
+
+        if (fread(&record, sizeof(record), 1, fp) != 1) {
+            t->count = 0;
+            fclose(fp);
+            return 0;
+        }
+        init_entry(e, record.username);
+        e->gamesPlayed  = record.gamesPlayed;
+        e->wins         = record.wins;
+        e->losses       = record.losses;
+        e->totalGuesses = record.totalGuesses;
+    }
+
+    t->count = (int) header.count;
     fclose(fp);
+    return header.offset;
+}
+
+/* save_snapshot:
+ *   Writes the per-player totals for the first 'offset' bytes of history.
+ *   The snapshot is only a cache, so any failure just leaves the old one
+ *   (or none) in place. It is written to a private temporary file and
+ *   renamed, so readers never see half a snapshot.
+ */
+
+static void save_snapshot(const struct PlayerTable *t, int fd, const struct stat *st,
+                          uint64_t offset) {
+    struct SnapshotHeader header;
+    char tmpPath[DATA_DIR_MAX + 64];
+    FILE *fp;
+    int ok = 1;
+    int i;
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version   = SNAPSHOT_VERSION;
+    header.count     = (uint32_t) t->count;
+    header.device    = (uint64_t) st->st_dev;
+    header.inode     = (uint64_t) st->st_ino;
+    header.offset    = offset;
+    header.signature = history_signature(fd, offset);
+
+    snprintf(tmpPath, sizeof(tmpPath), "%s.%ld", dataPath(SNAPSHOT_FILE), (long) getpid());
+    fp = fopen(tmpPath, "wb");
+    if (fp == NULL) {
+        return;
+    }
+
+    ok = (fwrite(&header, sizeof(header), 1, fp) == 1);
+    for (i = 0; i < t->count && ok; i++) {
+        struct SnapshotRecord record;
+
+        memset(&record, 0, sizeof(record));
+        memcpy(record.username, t->entries[i].username, NAME_MAX_LEN);
+        record.gamesPlayed  = t->entries[i].gamesPlayed;
+        record.wins         = t->entries[i].wins;
+        record.losses       = t->entries[i].losses;
+        record.totalGuesses = t->entries[i].totalGuesses;
+        ok = (fwrite(&record, sizeof(record), 1, fp) == 1);
+    }
+
+    if (fclose(fp) != 0 || !ok || rename(tmpPath, dataPath(SNAPSHOT_FILE)) != 0) {
+        remove(tmpPath);
+    }
+}
+
+/* ingest_text:
+ *   Brings the table up to date with history.txt, starting from the saved
+ *   snapshot and scanning only the lines appended since.
+ *   RETURNS:
+ *     0 on success, 1 if memory ran out.
+ */
+
+static int ingest_text(struct PlayerTable *t) {
+    char tail[TAIL_MAX];
+    struct stat st;
+    void *scanned;
+    uint64_t loaded;
+    uint64_t checkpoint;
+    ssize_t got;
+    int fd;
+    int failed;
+
+    fd = open(dataPath(HISTORY_FILE), O_RDONLY); // Opens the history file in read mode
+    if (fd < 0) {
+        return 0;                  // No history yet: an empty leaderboard
+    }
+
+    if (fstat(fd, &st) != 0) {
+        memset(&st, 0, sizeof(st));
+    }
+    loaded = load_snapshot(t, fd, &st);
+
+    // Only the whole lines appended since the snapshot are scanned
+    if (historyScanText(fd, loaded, 0, &playerScan, &scanned, &checkpoint) != 0) {
+        close(fd);
+        return 1;
+    }
+    failed = merge_scan(t, scanned);
+
+    // Only whole lines go into the snapshot...
+    if (!failed && checkpoint != loaded) {
+        save_snapshot(t, fd, &st, checkpoint);
+    }
+    // ...an unterminated last line (a game still being written) is counted for this view only
+    got = pread(fd, tail, sizeof(tail), (off_t) checkpoint);
+    if (!failed && got > 0) {
+        const char *newline = memchr(tail, '\n', (size_t) got);
+
+        failed = add_game(t, tail, (newline != NULL) ? (size_t) (newline - tail) : (size_t) got);
+    }
+
+    close(fd);
+    return failed;
+}
+
+/* ingest_binary:
+ *   Brings the table up to date with history.bin. The snapshot offset is
+ *   always a record boundary, so the new records are found by index.
+ *   RETURNS:
+ *     0 on success, 1 if memory ran out.
+ */
+
+static int ingest_binary(struct PlayerTable *t) {
+    HistoryLog log;
+    struct stat st;
+    void *scanned;
+    uint64_t loaded;
+    uint64_t checkpoint;
+    long next = 0;
+    int failed;
+
+    if (historyLogOpen(&log, dataPath(HISTORY_BINARY_FILE)) != 0) {
+        return 0;                  // Not a usable log: an empty leaderboard
+    }
+
+    if (fstat(log.fd, &st) != 0) {
+        memset(&st, 0, sizeof(st));
+    }
+    loaded = load_snapshot(t, log.fd, &st);
+    if (loaded >= HISTORY_HEADER_SIZE && (loaded - HISTORY_HEADER_SIZE) % HISTORY_RECORD_SIZE == 0) {
+        next = (long) ((loaded - HISTORY_HEADER_SIZE) / HISTORY_RECORD_SIZE);
+    } else {
+        t->count = 0;
+        loaded = 0;
+    }
+
+    if (historyScanBinary(&log, next, 0, &playerScan, &scanned) != 0) {
+        historyLogClose(&log);
+        return 1;
+    }
+    failed = merge_scan(t, scanned);
+
+    checkpoint = HISTORY_HEADER_SIZE + (uint64_t) log.count * HISTORY_RECORD_SIZE;
+    if (!failed && checkpoint != loaded) {
+        save_snapshot(t, log.fd, &st, checkpoint);
+    }
+
+    historyLogClose(&log);
+    return failed;
+}
+
+/* build_leaderboard:
+ *   Builds per-player stats for everything in the game history, from
+ *   history.bin when the binary log is in use and history.txt otherwise.
+ *   PARAMETERS:
+ *     t - empty player table to fill
+ *   RETURNS:
+ *     0 on success, 1 if memory ran out.
+ *   SIDE EFFECTS:
+ *     - Reads the new tail of the history if it exists
+ *     - For each player, updates gamesPlayed, wins, losses, totalGuesses
+ *     - Moves the snapshot forward to the last complete record
+ *     - Computes avgGuesses and winRate for each entry
+ */
+
+static int build_leaderboard(struct PlayerTable *t) {
+    int failed;
+
+    if (table_init(t) != 0) {
+        return 1;
+    }
+
+    if (historyBinaryEnabled()) {
+        failed = ingest_binary(t);
+    } else {
+        failed = ingest_text(t);
+    }
+
+    if (failed) {
+        return 1;
+    }
 
     //Compute averages and win rate for each player 
     {
         int i = 0;
 
-        while (i < *count) {
-            if (entries[i].gamesPlayed > 0) {
+        while (i < t->count) {
+            struct LeaderboardEntry *e = &t->entries[i];
+
+            if (e->gamesPlayed > 0) {
                 //Average guesses per game for this player
-                entries[i].avgGuesses =
-                    (double) entries[i].totalGuesses /
-                    (double) entries[i].gamesPlayed;
+                e->avgGuesses = (double) e->totalGuesses / (double) e->gamesPlayed;
                 //Win rate = wins / total games
-                entries[i].winRate =
-                    (double) entries[i].wins /
-                    (double) entries[i].gamesPlayed;
+                e->winRate = (double) e->wins / (double) e->gamesPlayed;
             } else {
-                entries[i].avgGuesses = 0.0;
-                entries[i].winRate    = 0.0;
+                e->avgGuesses = 0.0;
+                e->winRate    = 0.0;
             }
             i = i + 1;
         }
     }
+    return 0;
 }
 
-/* swap_entries:
- *   Swaps two leaderboard entries used by the sort function.
- *   PARAMETERS:
- *     a, b - pointers to the two entries to be swapped
- *   SIDE EFFECTS:
- *     Modifies the contents of *a and *b.
+/* compare_entries:
+ *   Leaderboard order: more wins, then higher win rate, then fewer
+ *   average guesses, then username (case-insensitive, then exact) so
+ *   the order never depends on where a player first appears.
+ *   Ratios are compared by cross-multiplying, which keeps ties exact.
+ *   RETURNS:
+ *     Negative if a ranks above b, positive if below, 0 if identical.
+ */
+
+static int compare_entries(const struct LeaderboardEntry *a, const struct LeaderboardEntry *b) {
+    long long lhs, rhs;
+    int cmp;
+
+    if (a->wins != b->wins) {
+        return (a->wins > b->wins) ? -1 : 1;
+    }
+
+    lhs = (long long) a->wins * b->gamesPlayed;
+    rhs = (long long) b->wins * a->gamesPlayed;
+    if (lhs != rhs) {
+        return (lhs > rhs) ? -1 : 1;
+    }
+
+    lhs = (long long) a->totalGuesses * b->gamesPlayed;
+    rhs = (long long) b->totalGuesses * a->gamesPlayed;
+    if (lhs != rhs) {
+        return (lhs < rhs) ? -1 : 1;
+    }
+
+    cmp = strcasecmp(a->username, b->username);
+    if (cmp != 0) {
+        return cmp;
+    }
+    return strcmp(a->username, b->username);
+}
+
+/* qsort_entries:
+ *   qsort adaptor for compare_entries.
  */
 
-static void swap_entries(struct LeaderboardEntry *a, struct LeaderboardEntry *b) {
-    struct LeaderboardEntry temp;
+static int qsort_entries(const void *a, const void *b) {
+    return compare_entries(a, b);
+}
+
+/* sift_down:
+ *   Restores the min-heap property from position i downwards. The heap
+ *   holds entry indices and its root is the lowest ranked player kept.
+ */
+
+static void sift_down(const struct LeaderboardEntry *entries, int *heap, int size, int i) {
+    while (1) {
+        int left = 2 * i + 1;
+        int right = left + 1;
+        int worst = i;
+        int temp;
+
+        if (left < size && compare_entries(&entries[heap[left]], &entries[heap[worst]]) > 0) {
+            worst = left;
+        }
+        if (right < size && compare_entries(&entries[heap[right]], &entries[heap[worst]]) > 0) {
+            worst = right;
+        }
+        if (worst == i) {
+            return;
+        }
 
-    temp = *a;  
-    *a   = *b;
-    *b   = temp;
+        temp = heap[i];
+        heap[i] = heap[worst];
+        heap[worst] = temp;
+        i = worst;
+    }
 }
 
-/* sort_by_wins:
- *   Sorts the entries in descending order of wins using selection sort.
+/* select_top:
+ *   Moves the 'limit' best players to the front of the array, in order,
+ *   using a bounded heap so only 'limit' players are ever held aside.
  *   PARAMETERS:
  *     entries - array of LeaderboardEntry
  *     count   - number of valid entries in the array
- *   SIDE EFFECTS:
- *     Reorders the entries array so that players with more wins appear first.
+ *     limit   - how many players to keep (0 < limit < count)
+ *   RETURNS:
+ *     0 on success, 1 if memory ran out.
  */
 
-static void sort_by_wins(struct LeaderboardEntry *entries, int count) {
-    int i = 0;
+static int select_top(struct LeaderboardEntry *entries, int count, int limit) {
+    struct LeaderboardEntry *top;
+    int *heap;
+    int size = 0;
+    int i;
 
-    while (i < count - 1) {
-        int j = i + 1;
-        int best = i;
+    heap = malloc(sizeof(int) * (size_t) limit);
+    top = malloc(sizeof(struct LeaderboardEntry) * (size_t) limit);
+    if (heap == NULL || top == NULL) {
+        free(heap);
+        free(top);
+        return 1;
+    }
 
-        while (j < count) {
-            if (entries[j].wins > entries[best].wins) {
-                best = j;
+    for (i = 0; i < count; i++) {
+        if (size < limit) {
+            // Sift the new player up from the bottom
+            int child = size;
+
+            heap[size] = i;
+            size = size + 1;
+            while (child > 0) {
+                int parent = (child - 1) / 2;
+                int temp;
+
+                if (compare_entries(&entries[heap[child]], &entries[heap[parent]]) <= 0) {
+                    break;
+                }
+                temp = heap[child];
+                heap[child] = heap[parent];
+                heap[parent] = temp;
+                child = parent;
             }
-            j = j + 1;
-        }
-
-        if (best != i) {
-            swap_entries(&entries[i], &entries[best]);
+        } else if (compare_entries(&entries[i], &entries[heap[0]]) < 0) {
+            // Better than the weakest kept player: replace it
+            heap[0] = i;
+            sift_down(entries, heap, size, 0);
         }
+    }
 
-        i = i + 1;
+    for (i = 0; i < size; i++) {
+        top[i] = entries[heap[i]];
     }
+    qsort(top, (size_t) size, sizeof(struct LeaderboardEntry), qsort_entries);
+    memcpy(entries, top, sizeof(struct LeaderboardEntry) * (size_t) size);
+
+    free(heap);
+    free(top);
+    return 0;
 }
 
 /* print_leaderboard:
@@ -250,20 +795,69 @@ static void print_leaderboard(const struct LeaderboardEntry *entries, int count)
     printf(COLOR_MAGENTA "-----------------------------------------------------------------\n" COLOR_RESET);
 }
 
-/* GetLeaderboard:
+/* ReadLeaderboardTop:
+ *   Builds the leaderboard from history and ranks it, without printing.
+ *   PARAMETERS:
+ *     limit   - how many players to rank (every player when limit <= 0)
+ *     entries - set to the ranked players; the caller frees it
+ *   RETURNS:
+ *     The number of ranked players, or -1 if memory ran out.
+ */
+
+int ReadLeaderboardTop(int limit, struct LeaderboardEntry **entries) {
+    PROFILE_SCOPE(PROFILE_LEADERBOARD);
+    struct PlayerTable table;
+    int shown;
+
+    *entries = NULL;
+    if (build_leaderboard(&table) != 0) {
+        free(table.entries);
+        free(table.slots);
+        return -1;
+    }
+
+    // The index is not needed once every line has been counted
+    free(table.slots);
+    table.slots = NULL;
+
+    shown = table.count;
+    if (limit > 0 && limit < table.count && select_top(table.entries, table.count, limit) == 0) {
+        shown = limit;
+    } else {
+        qsort(table.entries, (size_t) table.count, sizeof(struct LeaderboardEntry), qsort_entries);
+    }
+
+    *entries = table.entries;
+    return shown;
+}
+
+/* GetLeaderboardTop:
  *   Public function that is called from wordex.c
- *   Builds the leaderboard from history, sorts by wins, and prints it.
+ *   Builds the leaderboard from history, ranks it, and prints the best
+ *   'limit' players (every player when limit <= 0).
  *   SIDE EFFECTS:
- *    Prints "No games in history." if the history file is empty or missing.
- *    Otherwise it prints the full leaderboard table to stdout.
+ *    Prints an empty table if the history file is empty or missing.
+ *    Otherwise it prints the leaderboard table to stdout.
  */
 
-void GetLeaderboard(void) {
-    struct LeaderboardEntry entries[MAX_USERS];
-    int count;
+void GetLeaderboardTop(int limit) {
+    struct LeaderboardEntry *entries;
+    int shown = ReadLeaderboardTop(limit, &entries);
 
-    build_leaderboard(entries, &count);
+    if (shown < 0) {
+        fprintf(stderr, "Error: Not enough memory to build the leaderboard.\n");
+        return;
+    }
 
-    sort_by_wins(entries, count);
-    print_leaderboard(entries, count);
+    print_leaderboard(entries, shown);
+    free(entries);
+}
+
+/* GetLeaderboard:
+ *   Public function that is called from wordex.c
+ *   Prints the full leaderboard with every player ranked.
+ */
+
+void GetLeaderboard(void) {
+    GetLeaderboardTop(0);
 }
@@ -0,0 +1,357 @@
+/* libwordex.c
+ *
+ * The Wordex engine behind an explicit context.
+ *
+ * FUNCTIONALITY:
+ *  - wxOpen / wxClose: fix the data directory and word list for the
+ *    process, open the account store and start the result log once
+ *  - wxNewGame / wxGuess / wxHint: games in caller-owned GameStates,
+ *    answers drawn from the caller's random state
+ *  - wxLogin / wxRegister: accounts, with the password hashing done
+ *    outside the context's lock so logins on many threads overlap
+ *  - wxSaveGame / wxStats / wxLeaderboard / wxHistory: results through
+ *    the result log, and queries that wait for it to catch up
+ *
+ * The statistics, leaderboard and history modules keep per-process
+ * caches, so their queries take one process-wide lock, as the server's do.
+ * For the same reason the data directory and word list are per process:
+ * wxOpen refuses a context that names a different one than those in use.
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#include <string.h>
+#include <ctype.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include "../headerFiles/libwordex.h"
+#include "../headerFiles/authentication.h"
+#include "../headerFiles/account_store.h"
+#include "../headerFiles/kdf.h"
+#include "../headerFiles/data_dir.h"
+#include "../headerFiles/profile.h"
+#include "../headerFiles/random.h"
+
+/* Longest username wxRegister accepts (history.txt keeps names this short) */
+#define WX_NAME_MAX  (NAME_MAX_LEN - 1)
+
+/* WxContext: one open engine */
+struct WxContext {
+    AccountStore    accounts;
+    int             accountsOpen;
+    pthread_mutex_t accountLock;   // AccountStore is not safe to share unlocked
+};
+
+static pthread_mutex_t openLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t dataLock = PTHREAD_MUTEX_INITIALIZER;
+static int logStarted = 0;
+static char *openDictPath = NULL;   // the word list a context asked for
+
+static const char *const statusMessages[] = {
+    "ok",
+    "internal error",
+    "guesses are 5-letter words",
+    "not in the word list",
+    "the game is over",
+    "the game is not over",
+    "unknown user",
+    "wrong password",
+    "usernames are letters, digits, '_', '-' or '.' (at most 31)",
+    "password too weak",
+    "username taken"
+};
+
+/* valid_username: 1 to WX_NAME_MAX letters, digits, '_', '-' or '.' */
+static int valid_username(const char *name) {
+    size_t length = strlen(name);
+    size_t i;
+
+    if (length == 0 || length > WX_NAME_MAX) {
+        return 0;
+    }
+    for (i = 0; i < length; i++) {
+        if (!isalnum((unsigned char) name[i]) && name[i] != '_' && name[i] != '-' && name[i] != '.') {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/*
+ * choose_dictionary:
+ *   Makes 'path' the process's word list, or checks it is the one already
+ *   in use; NULL keeps whatever list is in use.
+ *
+ * RETURNS:
+ *   0 on success, 1 on a conflict or if the list cannot be loaded.
+ */
+
+static int choose_dictionary(const char *path) {
+    const Dictionary *dict;
+
+    if (path != NULL && (openDictPath == NULL || strcmp(path, openDictPath) != 0)) {
+        char *copy = strdup(path);
+
+        if (copy == NULL || setDictionaryPath(copy) != 0) {
+            free(copy);
+            return 1;
+        }
+        free(openDictPath);
+        openDictPath = copy;
+    }
+
+    dict = getDictionary();
+    return (dict == NULL || dict->count == 0);
+}
+
+/*
+ * wxOpen:
+ *   Settles the process-wide parts (data directory, word list, result
+ *   log) under one lock, then opens this context's account store.
+ *
+ * RETURNS:
+ *   The context, or NULL.
+ */
+
+WxContext *wxOpen(const WxConfig *config) {
+    const char *dir = (config != NULL) ? config->dataDir : NULL;
+    const char *dictPath = (config != NULL) ? config->dictPath : NULL;
+    WxContext *ctx;
+
+    pthread_mutex_lock(&openLock);
+    if ((dir != NULL && setDataDir(dir) != 0) || choose_dictionary(dictPath) != 0) {
+        pthread_mutex_unlock(&openLock);
+        return NULL;
+    }
+    if (!logStarted) {
+        // Replays stopped processes' logs. If this process's log cannot be
+        // started, wxSaveGame writes each game to the files itself, one
+        // caller at a time, and returns once they have it
+        resultLogOpen();
+        logStarted = 1;
+    }
+    pthread_mutex_unlock(&openLock);
+
+    ctx = calloc(1, sizeof(WxContext));
+    if (ctx == NULL) {
+        return NULL;
+    }
+    pthread_mutex_init(&ctx->accountLock, NULL);
+    ctx->accountsOpen = (accountStoreOpen(&ctx->accounts) == 0);
+    return ctx;
+}
+
+/* wxClose: waits for saved games to reach the files, then frees the context */
+void wxClose(WxContext *ctx) {
+    if (ctx == NULL) {
+        return;
+    }
+    resultLogSync();
+    if (ctx->accountsOpen) {
+        accountStoreClose(&ctx->accounts);
+    }
+    pthread_mutex_destroy(&ctx->accountLock);
+    free(ctx);
+}
+
+/* wxStatusMessage: the description of a status */
+const char *wxStatusMessage(WxStatus status) {
+    if ((int) status < 0 || (size_t) status >= sizeof(statusMessages) / sizeof(statusMessages[0])) {
+        return "unknown status";
+    }
+    return statusMessages[status];
+}
+
+/* wxSeed: mixes the clock, the pid and a counter so threads seeded together differ */
+uint64_t wxSeed(void) {
+    static uint64_t calls = 0;
+    struct timespec now;
+    uint64_t seed;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    seed = ((uint64_t) now.tv_sec * 1000000000ull + (uint64_t) now.tv_nsec) ^
+           ((uint64_t) getpid() << 32) ^
+           (__atomic_add_fetch(&calls, 1, __ATOMIC_RELAXED) * 0x9E3779B97F4A7C15ull);
+    return seed != 0 ? seed : 0x9E3779B97F4A7C15ull;
+}
+
+/*
+ * wxLogin:
+ *   Looks the account up under the lock, checks the password without it
+ *   and stores an upgraded hash if the work factor went up.
+ *
+ * RETURNS:
+ *   WX_OK, WX_UNKNOWN_USER, WX_WRONG_PASSWORD or WX_ERROR.
+ */
+
+WxStatus wxLogin(WxContext *ctx, const char *username, const char *password) {
+    char stored[ACCOUNT_HASH_MAX];
+    char upgraded[KDF_HASH_MAX];
+    int found;
+
+    if (!ctx->accountsOpen) {
+        return WX_ERROR;
+    }
+    pthread_mutex_lock(&ctx->accountLock);
+    found = (accountStoreFind(&ctx->accounts, username, stored) == 0);
+    pthread_mutex_unlock(&ctx->accountLock);
+
+    if (!found) {
+        return WX_UNKNOWN_USER;
+    }
+    if (verifyPassword(password, stored) != 0) {
+        return WX_WRONG_PASSWORD;
+    }
+
+    if (kdfNeedsUpgrade(stored) && hashPassword((char *) password, upgraded) == 0) {
+        pthread_mutex_lock(&ctx->accountLock);
+        accountStoreUpdate(&ctx->accounts, username, upgraded);
+        pthread_mutex_unlock(&ctx->accountLock);
+    }
+    return WX_OK;
+}
+
+/*
+ * wxRegister:
+ *   Validates, hashes outside the lock, then adds the account; a name
+ *   taken meanwhile by another thread is caught by accountStoreAdd.
+ *
+ * RETURNS:
+ *   A WxStatus.
+ */
+
+WxStatus wxRegister(WxContext *ctx, const char *username, const char *password) {
+    char hash[KDF_HASH_MAX];
+    int taken, failed;
+
+    if (!valid_username(username)) {
+        return WX_BAD_USERNAME;
+    }
+    if (passwordProblem(password) != NULL) {
+        return WX_WEAK_PASSWORD;
+    }
+    if (!ctx->accountsOpen) {
+        return WX_ERROR;
+    }
+
+    pthread_mutex_lock(&ctx->accountLock);
+    taken = (accountStoreFind(&ctx->accounts, username, NULL) == 0);
+    pthread_mutex_unlock(&ctx->accountLock);
+    if (taken) {
+        return WX_USERNAME_TAKEN;
+    }
+
+    if (hashPassword((char *) password, hash) != 0) {
+        return WX_ERROR;
+    }
+
+    pthread_mutex_lock(&ctx->accountLock);
+    failed = accountStoreAdd(&ctx->accounts, username, hash);
+    pthread_mutex_unlock(&ctx->accountLock);
+    return failed ? WX_USERNAME_TAKEN : WX_OK;
+}
+
+/* wxNewGame: starts a game with a random answer */
+WxStatus wxNewGame(WxContext *ctx, uint64_t *rng, GameState *game) {
+    PROFILE_SCOPE(PROFILE_RANDOM_WORD);
+    const Dictionary *dict = getDictionary();
+    char answer[6];
+
+    (void) ctx;
+    if (dict == NULL || dict->count == 0) {
+        return WX_ERROR;
+    }
+
+#ifdef TESTING
+    (void) rng;
+    strcpy(answer, "banes");
+#else
+    dictionaryWordAt(dict, (int) (nextRandom(rng) % (uint64_t) dict->count), answer);
+#endif
+    gameStateInit(game, answer);
+    return WX_OK;
+}
+
+/* wxGuess: checks and scores one guess */
+WxStatus wxGuess(GameState *game, const char *word, uint8_t *pattern) {
+    char guess[6];
+    int result;
+
+    if (gameStateOver(game)) {
+        return WX_GAME_OVER;
+    }
+    result = checkGuess(word, guess);
+    if (result == GUESS_BAD_LENGTH) {
+        return WX_BAD_WORD;
+    }
+    if (result == GUESS_NOT_A_WORD) {
+        return WX_NOT_IN_LIST;
+    }
+
+    *pattern = gameStateSubmit(game, guess);
+    return WX_OK;
+}
+
+/* wxHint: the best next guess, computed on the calling thread */
+WxStatus wxHint(const GameState *game, Hint *hint) {
+    if (gameStateOver(game)) {
+        return WX_GAME_OVER;
+    }
+    return bestGuess(getDictionary(), game, 1, hint) == 0 ? WX_OK : WX_ERROR;
+}
+
+/* wxSaveGame: hands a finished game to the result log */
+WxStatus wxSaveGame(WxContext *ctx, const char *username, const GameState *game,
+                    ResultLogDone done, void *context) {
+    (void) ctx;
+    if (!gameStateOver(game)) {
+        return WX_GAME_NOT_OVER;
+    }
+    if (resultLogAppend(username, game->answerWord, game->guessCount, game->won, time(NULL),
+                        done, context) != 0) {
+        return WX_ERROR;
+    }
+    return WX_OK;
+}
+
+/* wxStats: a player's statistics once the result log has caught up */
+WxStatus wxStats(WxContext *ctx, const char *username, Stats *stats) {
+    (void) ctx;
+    resultLogSync();
+
+    pthread_mutex_lock(&dataLock);
+    if (loadStats(username, stats) != 0) {
+        memset(stats, 0, sizeof(*stats));
+        snprintf(stats->username, sizeof(stats->username), "%s", username);
+    }
+    pthread_mutex_unlock(&dataLock);
+    return WX_OK;
+}
+
+/* wxLeaderboard: the ranking once the result log has caught up */
+int wxLeaderboard(WxContext *ctx, int limit, struct LeaderboardEntry **entries) {
+    int shown;
+
+    (void) ctx;
+    resultLogSync();
+
+    pthread_mutex_lock(&dataLock);
+    shown = ReadLeaderboardTop(limit, entries);
+    pthread_mutex_unlock(&dataLock);
+    return shown;
+}
+
+/* wxHistory: a page of games once the result log has caught up */
+long wxHistory(WxContext *ctx, long offset, long limit, struct GameResult *out) {
+    long shown;
+
+    (void) ctx;
+    resultLogSync();
+
+    pthread_mutex_lock(&dataLock);
+    shown = ReadHistoryPage(offset, limit, out);
+    pthread_mutex_unlock(&dataLock);
+    return shown;
+}
@@ -0,0 +1,269 @@
+/* patterns.c
+ *
+ * Precomputed guess x answer pattern matrix for the Wordex game.
+ *
+ * FUNCTIONALITY:
+ *  - buildPatternMatrix: scores every pair of dictionary words in parallel
+ *    (one band of guess rows per thread) and writes patterns.bin
+ *  - openPatternMatrix / getPatternMatrix: map the file read-only and make
+ *    sure it matches the current dictionary before trusting it
+ *  - patternAt: one memory load per query, or an on-the-fly scoreGuess when
+ *    no up-to-date matrix is available
+ *
+ * FILE FORMAT:
+ *   PatternFileHeader padded to PATTERNS_HEADER bytes, then one byte per
+ *   (guess, answer) pair in row-major order.
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#include <string.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "../headerFiles/patterns.h"
+#include "../headerFiles/data_dir.h"
+
+/* Shared matrix state, loaded once on first use */
+static PatternMatrix sharedMatrix;
+static pthread_once_t sharedOnce = PTHREAD_ONCE_INIT;
+static int sharedOk = 0;
+
+/* BuildJob:
+ *   One worker's share of the matrix: rows [firstRow, lastRow).
+ */
+struct BuildJob {
+    const uint32_t *words;
+    int             count;
+    int             firstRow;
+    int             lastRow;
+    uint8_t        *cells;
+};
+
+/*
+ * build_rows:
+ *   Thread entry point. Each row is one guess scored against every answer
+ *   with the batch kernel.
+ */
+
+static void *build_rows(void *arg) {
+    struct BuildJob *job = arg;
+    int row;
+
+    for (row = job->firstRow; row < job->lastRow; row++) {
+        scoreBatch(job->words[row], job->words, (size_t) job->count,
+                   job->cells + (size_t) row * job->count);
+    }
+    return NULL;
+}
+
+/*
+ * buildPatternMatrix:
+ *   Computes the whole matrix into memory, then writes it to a temporary
+ *   file that is renamed over 'path' so readers never see a partial file.
+ *
+ * PARAMETERS:
+ *   dict    - dictionary to score
+ *   path    - output file
+ *   threads - worker count (values < 1 mean one per online CPU)
+ *
+ * RETURNS:
+ *   0 on success, 1 on failure.
+ */
+
+int buildPatternMatrix(const Dictionary *dict, const char *path, int threads) {
+    size_t cellCount = (size_t) dict->count * dict->count;
+    unsigned char header[PATTERNS_HEADER];
+    PatternFileHeader info;
+    struct BuildJob *jobs;
+    pthread_t *tids;
+    uint32_t *words;
+    uint8_t *cells;
+    char tmpPath[512];
+    FILE *fp;
+    int created, i, ok;
+
+    if (threads < 1) {
+        threads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+        if (threads < 1) {
+            threads = 1;
+        }
+    }
+    if (threads > dict->count && dict->count > 0) {
+        threads = dict->count;
+    }
+
+    words = malloc(sizeof(uint32_t) * (dict->count > 0 ? dict->count : 1));
+    cells = malloc(cellCount > 0 ? cellCount : 1);
+    jobs = calloc((size_t) threads, sizeof(struct BuildJob));
+    tids = calloc((size_t) threads, sizeof(pthread_t));
+
+    if (words == NULL || cells == NULL || jobs == NULL || tids == NULL) {
+        free(words);
+        free(cells);
+        free(jobs);
+        free(tids);
+        return 1;
+    }
+
+    for (i = 0; i < dict->count; i++) {
+        words[i] = dictionaryPackedAt(dict, i);
+    }
+
+    // Split the rows into equal bands, one per thread
+    for (i = 0; i < threads; i++) {
+        jobs[i].words = words;
+        jobs[i].count = dict->count;
+        jobs[i].cells = cells;
+        jobs[i].firstRow = (int) ((long) dict->count * i / threads);
+        jobs[i].lastRow = (int) ((long) dict->count * (i + 1) / threads);
+    }
+    for (created = 0; created < threads; created++) {
+        if (pthread_create(&tids[created], NULL, build_rows, &jobs[created]) != 0) {
+            break;
+        }
+    }
+    // Bands no thread could be started for are built here
+    for (i = created; i < threads; i++) {
+        build_rows(&jobs[i]);
+    }
+    for (i = 0; i < created; i++) {
+        pthread_join(tids[i], NULL);
+    }
+
+    memset(header, 0, sizeof(header));
+    memset(&info, 0, sizeof(info));
+    memcpy(info.magic, PATTERNS_MAGIC, sizeof(PATTERNS_MAGIC));
+    info.version = PATTERNS_VERSION;
+    info.wordCount = (uint32_t) dict->count;
+    info.dictHash = dictionaryHash(dict);
+    memcpy(header, &info, sizeof(info));
+
+    snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", path);
+    fp = fopen(tmpPath, "wb");
+    ok = (fp != NULL);
+
+    if (ok) {
+        ok = fwrite(header, 1, sizeof(header), fp) == sizeof(header) &&
+             fwrite(cells, 1, cellCount, fp) == cellCount;
+        ok = (fclose(fp) == 0) && ok;
+    }
+    if (ok) {
+        ok = (rename(tmpPath, path) == 0);
+    } else {
+        remove(tmpPath);
+    }
+
+    free(words);
+    free(cells);
+    free(jobs);
+    free(tids);
+    return ok ? 0 : 1;
+}
+
+/*
+ * openPatternMatrix:
+ *   Maps a pattern file and validates its header against dict.
+ *
+ * RETURNS:
+ *   0 if the matrix can be used, 1 if it is missing or malformed,
+ *   2 if it was built from a different dictionary.
+ */
+
+int openPatternMatrix(const char *path, const Dictionary *dict, PatternMatrix *pm) {
+    PatternFileHeader info;
+    struct stat st;
+    size_t expected;
+    void *map;
+    int fd;
+
+    memset(pm, 0, sizeof(*pm));
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return 1;
+    }
+    if (fstat(fd, &st) != 0 || (size_t) st.st_size < PATTERNS_HEADER) {
+        close(fd);
+        return 1;
+    }
+
+    map = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return 1;
+    }
+
+    memcpy(&info, map, sizeof(info));
+    expected = PATTERNS_HEADER + (size_t) info.wordCount * info.wordCount;
+
+    if (memcmp(info.magic, PATTERNS_MAGIC, sizeof(PATTERNS_MAGIC)) != 0 ||
+        info.version != PATTERNS_VERSION || (size_t) st.st_size != expected) {
+        munmap(map, (size_t) st.st_size);
+        return 1;
+    }
+
+    // Cheap count check first, then the full hash of the word list
+    if ((int) info.wordCount != dict->count || info.dictHash != dictionaryHash(dict)) {
+        munmap(map, (size_t) st.st_size);
+        return 2;
+    }
+
+    pm->map = map;
+    pm->mapSize = (size_t) st.st_size;
+    pm->cells = (const uint8_t *) map + PATTERNS_HEADER;
+    pm->count = dict->count;
+    return 0;
+}
+
+/*
+ * closePatternMatrix:
+ *   Unmaps the file and clears pm.
+ */
+
+void closePatternMatrix(PatternMatrix *pm) {
+    if (pm->map != NULL) {
+        munmap(pm->map, pm->mapSize);
+    }
+    memset(pm, 0, sizeof(*pm));
+}
+
+/* load_shared_matrix: pthread_once callback that maps PATTERNS_FILE */
+static void load_shared_matrix(void) {
+    const Dictionary *dict = getDictionary();
+
+    sharedOk = (dict != NULL && openPatternMatrix(dataPath(PATTERNS_FILE), dict, &sharedMatrix) == 0);
+}
+
+/*
+ * getPatternMatrix:
+ *   Shared matrix for the shared dictionary. A missing or stale file is not
+ *   an error: callers simply fall back to scoring on the fly.
+ */
+
+const PatternMatrix *getPatternMatrix(void) {
+    pthread_once(&sharedOnce, load_shared_matrix);
+
+    if (!sharedOk) {
+        return NULL;
+    }
+    return &sharedMatrix;
+}
+
+/*
+ * patternAt:
+ *   Pattern for two dictionary indices. Uses the shared matrix only when it
+ *   was built for this exact dictionary.
+ */
+
+uint8_t patternAt(const Dictionary *dict, int guess, int answer) {
+    const PatternMatrix *pm = getPatternMatrix();
+
+    if (pm != NULL && dict == getDictionary()) {
+        return pm->cells[(size_t) guess * pm->count + answer];
+    }
+    return scoreGuess(dictionaryPackedAt(dict, guess), dictionaryPackedAt(dict, answer));
+}
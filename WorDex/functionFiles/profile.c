@@ -0,0 +1,442 @@
+/* profile.c
+ *
+ * Hot-path profiler and trace recorder for the Wordex game and server.
+ *
+ * FUNCTIONALITY:
+ *  - profileEnable: turns recording on (the --profile option) and prints
+ *    the report at exit
+ *  - PROFILE_SCOPE / profileRecord: time a call with the monotonic clock
+ *    (clock_gettime is served from the vDSO, so a call costs a few tens of
+ *    nanoseconds) and add it to a log-linear histogram owned by the calling
+ *    thread, so recording takes no lock and shares no cache lines
+ *  - profileReport: merges every thread's histograms and prints the call
+ *    count, p50, p90, p99, max and total time of each point
+ *  - traceEnable / TRACE_SCOPE: with --trace, every PROFILE_SCOPE and
+ *    TRACE_SCOPE also appends a span to a ring buffer owned by the calling
+ *    thread; only that thread writes it, publishing each span with a
+ *    release store of the ring's head, so recording takes no lock
+ *  - traceWrite: at exit, writes every thread's spans as Chrome
+ *    trace-event JSON, one complete ("X") event per span
+ *
+ * A thread's histograms and ring are allocated on its first recorded call
+ * and kept on a list until exit, so calls made by threads that have
+ * already finished still count.
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include "../headerFiles/profile.h"
+
+const char *const profilePointNames[PROFILE_POINTS] = {
+    "setRandomWordAndCount",
+    "validateGuess",
+    "printHint",
+    "interface",
+    "logGame",
+    "updateStats",
+    "loadStats",
+    "resultLogCommit",
+    "leaderboard",
+    "history",
+    "accountStoreFind",
+    "passwordHash"
+};
+
+/* ThreadProfile: one thread's histograms and spans, linked from threadProfiles */
+struct ThreadProfile {
+    ProfileHistogram      points[PROFILE_POINTS];
+    TraceEvent           *ring;    // TRACE_RING_EVENTS spans, allocated with the first one
+    uint64_t              head;    // spans ever recorded; ring[head % size] is next
+    int                   tid;
+    struct ThreadProfile *next;
+};
+
+#ifdef WORDEX_PROFILE
+static int profiling = 0;
+static int tracing = 0;
+static const char *tracePath = NULL;
+#endif
+static const char *traceProcess = NULL;
+static uint64_t traceOrigin = 0;   // when tracing started; span times are relative to it
+static struct ThreadProfile *threadProfiles = NULL;
+static pthread_mutex_t threadProfilesLock = PTHREAD_MUTEX_INITIALIZER;
+static __thread struct ThreadProfile *threadProfile = NULL;
+
+#ifdef WORDEX_PROFILE
+/* now_ns: monotonic clock in nanoseconds */
+static uint64_t now_ns(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ull + (uint64_t) ts.tv_nsec;
+}
+#endif
+
+/*
+ * bucket_of:
+ *   Values below 16 get a bucket each; above that every power of two is
+ *   split into 16 buckets by the 4 bits below the leading one.
+ *
+ * RETURNS:
+ *   The bucket index, 0 .. PROFILE_BUCKETS - 1.
+ */
+
+static int bucket_of(uint64_t value) {
+    int top;
+
+    if (value < (1u << PROFILE_SUB_BITS)) {
+        return (int) value;
+    }
+    top = 63 - __builtin_clzll(value);
+    return ((top - PROFILE_SUB_BITS + 1) << PROFILE_SUB_BITS) +
+           (int) ((value >> (top - PROFILE_SUB_BITS)) & ((1u << PROFILE_SUB_BITS) - 1));
+}
+
+/* bucket_middle: a value in the middle of bucket 'index' */
+static uint64_t bucket_middle(int index) {
+    int top, sub;
+    uint64_t low;
+
+    if (index < (1 << PROFILE_SUB_BITS)) {
+        return (uint64_t) index;
+    }
+    top = (index >> PROFILE_SUB_BITS) + PROFILE_SUB_BITS - 1;
+    sub = index & ((1 << PROFILE_SUB_BITS) - 1);
+    low = (uint64_t) ((1 << PROFILE_SUB_BITS) + sub) << (top - PROFILE_SUB_BITS);
+    return low + ((1ull << (top - PROFILE_SUB_BITS)) >> 1);
+}
+
+/*
+ * thread_profile:
+ *   This thread's histograms, allocated and put on the list the first time.
+ *
+ * RETURNS:
+ *   The histograms, or NULL if memory ran out.
+ */
+
+static struct ThreadProfile *thread_profile(void) {
+    if (threadProfile == NULL) {
+        threadProfile = calloc(1, sizeof(struct ThreadProfile));
+        if (threadProfile == NULL) {
+            return NULL;
+        }
+        threadProfile->tid = (int) syscall(SYS_gettid);
+        pthread_mutex_lock(&threadProfilesLock);
+        threadProfile->next = threadProfiles;
+        threadProfiles = threadProfile;
+        pthread_mutex_unlock(&threadProfilesLock);
+    }
+    return threadProfile;
+}
+
+#ifdef WORDEX_PROFILE
+
+/*
+ * trace_record:
+ *   Appends a span to this thread's ring, over its oldest span once the
+ *   ring is full. The head is stored with release ordering after the span,
+ *   so traceWrite never reads a half-written one.
+ */
+
+static void trace_record(const char *name, uint64_t start, uint64_t end) {
+    struct ThreadProfile *tp = thread_profile();
+    TraceEvent *event;
+
+    if (tp == NULL) {
+        return;
+    }
+    if (tp->ring == NULL) {
+        tp->ring = malloc(sizeof(TraceEvent) * TRACE_RING_EVENTS);
+        if (tp->ring == NULL) {
+            return;
+        }
+    }
+
+    event = &tp->ring[tp->head & (TRACE_RING_EVENTS - 1)];
+    event->name = name;
+    event->start = start;
+    event->duration = end - start;
+    __atomic_store_n(&tp->head, tp->head + 1, __ATOMIC_RELEASE);
+}
+
+/* profileStart: the time a scope starts, 0 while nothing records */
+uint64_t profileStart(void) {
+    return (profiling || tracing) ? now_ns() : 0;
+}
+
+/* profileScopeEnd: cleanup handler of PROFILE_SCOPE */
+void profileScopeEnd(ProfileScope *scope) {
+    uint64_t end;
+
+    if (scope->start == 0) {
+        return;
+    }
+    end = now_ns();
+    if (profiling) {
+        profileRecord(scope->point, end - scope->start);
+    }
+    if (tracing) {
+        trace_record(profilePointNames[scope->point], scope->start, end);
+    }
+}
+
+/* traceStart: the time a span starts, 0 while tracing is off */
+uint64_t traceStart(void) {
+    return tracing ? now_ns() : 0;
+}
+
+/* traceSpan: records the span from 'start' to now */
+void traceSpan(const char *name, uint64_t start) {
+    if (start != 0) {
+        trace_record(name, start, now_ns());
+    }
+}
+
+/* traceScopeEnd: cleanup handler of TRACE_SCOPE */
+void traceScopeEnd(TraceScope *scope) {
+    traceSpan(scope->name, scope->start);
+}
+
+#endif
+
+/* profileHistogramAdd: adds one value to a histogram its caller owns */
+void profileHistogramAdd(ProfileHistogram *histogram, uint64_t nanoseconds) {
+    histogram->count = histogram->count + 1;
+    histogram->total = histogram->total + nanoseconds;
+    if (nanoseconds > histogram->max) {
+        histogram->max = nanoseconds;
+    }
+    histogram->buckets[bucket_of(nanoseconds)]++;
+}
+
+/* profileHistogramMerge: adds every value of 'from' to 'into' */
+void profileHistogramMerge(ProfileHistogram *into, const ProfileHistogram *from) {
+    int b;
+
+    into->count += from->count;
+    into->total += from->total;
+    if (from->max > into->max) {
+        into->max = from->max;
+    }
+    for (b = 0; b < PROFILE_BUCKETS; b++) {
+        into->buckets[b] += from->buckets[b];
+    }
+}
+
+/*
+ * profileRecord:
+ *   Adds one call to this thread's histogram for 'point'. Only this thread
+ *   writes it, so no lock or atomic is needed.
+ */
+
+void profileRecord(ProfilePoint point, uint64_t nanoseconds) {
+    struct ThreadProfile *tp = thread_profile();
+
+    if (tp != NULL) {
+        profileHistogramAdd(&tp->points[point], nanoseconds);
+    }
+}
+
+/*
+ * profileMerge:
+ *   Adds up the histograms of every thread that recorded anything.
+ */
+
+void profileMerge(ProfilePoint point, ProfileHistogram *out) {
+    struct ThreadProfile *tp;
+
+    memset(out, 0, sizeof(*out));
+
+    pthread_mutex_lock(&threadProfilesLock);
+    for (tp = threadProfiles; tp != NULL; tp = tp->next) {
+        profileHistogramMerge(out, &tp->points[point]);
+    }
+    pthread_mutex_unlock(&threadProfilesLock);
+}
+
+/*
+ * profilePercentile:
+ *   Walks the buckets until 'percent' of the calls are covered.
+ *
+ * RETURNS:
+ *   The middle of that bucket, never more than the largest call.
+ */
+
+uint64_t profilePercentile(const ProfileHistogram *histogram, double percent) {
+    uint64_t wanted, seen = 0;
+    int b;
+
+    if (histogram->count == 0) {
+        return 0;
+    }
+    wanted = (uint64_t) ((double) histogram->count * percent / 100.0 + 0.5);
+    if (wanted < 1) {
+        wanted = 1;
+    }
+
+    for (b = 0; b < PROFILE_BUCKETS; b++) {
+        seen += histogram->buckets[b];
+        if (seen >= wanted) {
+            uint64_t value = bucket_middle(b);
+
+            return value < histogram->max ? value : histogram->max;
+        }
+    }
+    return histogram->max;
+}
+
+/*
+ * profileReport:
+ *   One line per point that was called, times in microseconds.
+ */
+
+void profileReport(FILE *out) {
+    ProfileHistogram *h = malloc(sizeof(ProfileHistogram));
+    int point;
+
+    if (h == NULL) {
+        return;
+    }
+
+    fprintf(out, "\nProfile (microseconds)\n");
+    fprintf(out, "%-22s %10s %10s %10s %10s %10s %12s\n",
+            "Function", "Calls", "p50", "p90", "p99", "Max", "Total");
+    for (point = 0; point < PROFILE_POINTS; point++) {
+        profileMerge((ProfilePoint) point, h);
+        if (h->count == 0) {
+            continue;
+        }
+        fprintf(out, "%-22s %10llu %10.1f %10.1f %10.1f %10.1f %12.1f\n",
+                profilePointNames[point], (unsigned long long) h->count,
+                profilePercentile(h, 50) / 1e3, profilePercentile(h, 90) / 1e3,
+                profilePercentile(h, 99) / 1e3, h->max / 1e3, h->total / 1e3);
+    }
+    free(h);
+}
+
+#ifdef WORDEX_PROFILE
+/* report_at_exit: atexit handler installed by profileEnable */
+static void report_at_exit(void) {
+    profileReport(stderr);
+}
+#endif
+
+/*
+ * traceWrite:
+ *   Writes a process name, a thread name for the main thread and one
+ *   complete event per span still in the rings, times in microseconds
+ *   since tracing started. Meant for exit, when the other threads are done;
+ *   a thread still running only adds spans the file may miss.
+ *
+ * RETURNS:
+ *   0 on success, 1 if the file could not be written.
+ */
+
+int traceWrite(const char *path) {
+    struct ThreadProfile *tp;
+    FILE *out = fopen(path, "w");
+    int pid = (int) getpid();
+    long written = 0, lost = 0;
+
+    if (out == NULL) {
+        fprintf(stderr, "Error: cannot write trace %s\n", path);
+        return 1;
+    }
+
+    fprintf(out, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    fprintf(out, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,"
+                 "\"args\":{\"name\":\"%s\"}},\n", pid, pid, traceProcess != NULL ? traceProcess : "wordex");
+    fprintf(out, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,"
+                 "\"args\":{\"name\":\"main\"}}", pid, pid);
+
+    pthread_mutex_lock(&threadProfilesLock);
+    for (tp = threadProfiles; tp != NULL; tp = tp->next) {
+        uint64_t head = __atomic_load_n(&tp->head, __ATOMIC_ACQUIRE);
+        uint64_t i = (head > TRACE_RING_EVENTS) ? head - TRACE_RING_EVENTS : 0;
+
+        lost += (long) i;
+        for (; i < head; i++) {
+            const TraceEvent *event = &tp->ring[i & (TRACE_RING_EVENTS - 1)];
+
+            fprintf(out, ",\n{\"name\":\"%s\",\"cat\":\"wordex\",\"ph\":\"X\",\"pid\":%d,\"tid\":%d,"
+                         "\"ts\":%.3f,\"dur\":%.3f}",
+                    event->name, pid, tp->tid,
+                    (double) (event->start - traceOrigin) / 1e3, (double) event->duration / 1e3);
+            written++;
+        }
+    }
+    pthread_mutex_unlock(&threadProfilesLock);
+
+    fprintf(out, "\n]}\n");
+    if (fclose(out) != 0) {
+        fprintf(stderr, "Error: cannot write trace %s\n", path);
+        return 1;
+    }
+
+    fprintf(stderr, "Trace: %ld spans written to %s", written, path);
+    if (lost > 0) {
+        fprintf(stderr, " (%ld older spans were overwritten)", lost);
+    }
+    fprintf(stderr, "\n");
+    return 0;
+}
+
+#ifdef WORDEX_PROFILE
+/* trace_at_exit: atexit handler installed by traceEnable */
+static void trace_at_exit(void) {
+    traceWrite(tracePath);
+}
+#endif
+
+/*
+ * traceEnable:
+ *   Turns span recording on. Called once, from main, before any thread
+ *   is started.
+ *
+ * RETURNS:
+ *   0, or 1 if TRACE_SCOPE was compiled out.
+ */
+
+int traceEnable(const char *path, const char *process) {
+#ifdef WORDEX_PROFILE
+    if (!tracing) {
+        tracePath = path;
+        traceProcess = process;
+        traceOrigin = now_ns();
+        tracing = 1;
+        atexit(trace_at_exit);
+    }
+    return 0;
+#else
+    (void) path;
+    (void) process;
+    return 1;
+#endif
+}
+
+/*
+ * profileEnable:
+ *   Turns recording on. Called once, from main.
+ *
+ * RETURNS:
+ *   0, or 1 if PROFILE_SCOPE was compiled out.
+ */
+
+int profileEnable(void) {
+#ifdef WORDEX_PROFILE
+    if (!profiling) {
+        profiling = 1;
+        atexit(report_at_exit);
+    }
+    return 0;
+#else
+    return 1;
+#endif
+}
@@ -0,0 +1,909 @@
+/* protocol.c
+ *
+ * JSON-lines protocol for bots and scripted clients (--protocol jsonl).
+ *
+ * FUNCTIONALITY:
+ *  - parse_command: reads one flat JSON object (string, number, true,
+ *    false and null values) in place, with no allocation
+ *  - the commands: login, register, new_game, guess, hint, stats,
+ *    leaderboard, history and quit, each a call into libwordex; nothing
+ *    is drawn and nothing sleeps
+ *  - responses are built in one buffer and written when the input runs
+ *    dry (or PROTOCOL_FLUSH_BYTES are waiting), so a client that sends
+ *    many commands at once gets its answers with a few large writes
+ *  - finished games go to the result log without waiting; before a flush
+ *    every game in it is waited for at once, so a batch of games costs
+ *    one sync, and each game's last response says whether it was saved
+ *
+ * See headerFiles/protocol.h for the commands and responses.
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#include <string.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <ctype.h>
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "../headerFiles/protocol.h"
+#include "../headerFiles/authentication.h"
+#include "../headerFiles/file_io.h"
+
+/* Field: one member of a command; numbers and literals are copied to 'scalar' */
+struct Field {
+    const char *key;
+    const char *value;
+    int         isString;
+    char        scalar[32];
+};
+
+/* Command: a parsed line */
+struct Command {
+    struct Field fields[PROTOCOL_FIELDS];
+    int          count;
+    const char  *cmd;      // the "cmd" value, NULL if missing
+    const struct Field *id;
+};
+
+/* Saved:
+ *   The last response of a finished game, waiting for the result log.
+ *   Both versions are in the output buffer, the saved one at
+ *   [okStart, okEnd) and the failed one at [okEnd, end).
+ */
+struct Saved {
+    size_t okStart;
+    size_t okEnd;
+    size_t end;
+    int    status;
+};
+
+/* Protocol: the session and its pending output */
+struct Protocol {
+    int           outFd;
+    int           writeFailed;
+    WxContext    *ctx;
+    char          username[MAX_USERNAME];
+    int           loggedIn;
+    int           playing;
+    GameState     game;
+    uint64_t      rng;
+
+    char         *out;
+    size_t        outLength;
+    size_t        outCapacity;
+
+    struct Saved *saved;          // guarded by lock: the commit thread sets status
+    int           savedCount;
+    int           savedCapacity;
+    int           savedDone;
+    pthread_mutex_t lock;
+    pthread_cond_t  savedCond;
+};
+
+/* ---------------------------------------------------------------------
+ * Parsing
+ * ------------------------------------------------------------------- */
+
+/* skip_space: the first character at or after p that is not blank */
+static char *skip_space(char *p) {
+    while (*p == ' ' || *p == '\t' || *p == '\r') {
+        p++;
+    }
+    return p;
+}
+
+/* put_utf8: writes code point c (below 0x10000) as UTF-8; returns the byte count */
+static int put_utf8(char *w, unsigned c) {
+    if (c < 0x80) {
+        w[0] = (char) c;
+        return 1;
+    }
+    if (c < 0x800) {
+        w[0] = (char) (0xc0 | (c >> 6));
+        w[1] = (char) (0x80 | (c & 0x3f));
+        return 2;
+    }
+    w[0] = (char) (0xe0 | (c >> 12));
+    w[1] = (char) (0x80 | ((c >> 6) & 0x3f));
+    w[2] = (char) (0x80 | (c & 0x3f));
+    return 3;
+}
+
+/*
+ * parse_string:
+ *   Decodes the string starting at the quote at p in place (escapes are
+ *   never shorter than what they stand for) and NUL-terminates it.
+ *
+ * RETURNS:
+ *   The character after the closing quote, or NULL if the string is
+ *   malformed. *out is set to the decoded string.
+ */
+
+static char *parse_string(char *p, const char **out) {
+    char *start = p + 1;
+    char *w = start;
+
+    p = start;
+    while (*p != '"') {
+        unsigned char c = (unsigned char) *p;
+
+        if (c == '\0' || c < 0x20) {
+            return NULL;
+        }
+        if (c != '\\') {
+            *w++ = *p++;
+            continue;
+        }
+
+        p++;
+        switch (*p) {
+        case '"': case '\\': case '/': *w++ = *p; break;
+        case 'b': *w++ = '\b'; break;
+        case 'f': *w++ = '\f'; break;
+        case 'n': *w++ = '\n'; break;
+        case 'r': *w++ = '\r'; break;
+        case 't': *w++ = '\t'; break;
+        case 'u': {
+            unsigned code = 0;
+            int i;
+
+            for (i = 1; i <= 4; i++) {
+                if (!isxdigit((unsigned char) p[i])) {
+                    return NULL;
+                }
+                code = code * 16 + (unsigned) (isdigit((unsigned char) p[i]) ? p[i] - '0'
+                                                 : tolower((unsigned char) p[i]) - 'a' + 10);
+            }
+            if (code == 0 || (code >= 0xd800 && code <= 0xdfff)) {
+                return NULL;   // no NULs, and no surrogate pairs
+            }
+            w += put_utf8(w, code);
+            p += 4;
+            break;
+        }
+        default:
+            return NULL;
+        }
+        p++;
+    }
+
+    *w = '\0';
+    *out = start;
+    return p + 1;
+}
+
+/*
+ * skip_digits:
+ *   Steps over a run of decimal digits.
+ *
+ * RETURNS:
+ *   The first character after them.
+ */
+
+static const char *skip_digits(const char *p) {
+    while (isdigit((unsigned char) *p)) {
+        p++;
+    }
+    return p;
+}
+
+/*
+ * json_number:
+ *   Checks 'text' against the JSON number grammar,
+ *   -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?, so the replies that
+ *   echo it back stay valid JSON (no hex, inf, nan or leading '+').
+ *
+ * RETURNS:
+ *   1 if all of 'text' is such a number, 0 otherwise.
+ */
+
+static int json_number(const char *text) {
+    const char *p = text;
+
+    if (*p == '-') {
+        p++;
+    }
+    if (*p == '0') {
+        p++;
+    } else if (isdigit((unsigned char) *p)) {
+        p = skip_digits(p);
+    } else {
+        return 0;
+    }
+    if (*p == '.') {
+        if (!isdigit((unsigned char) p[1])) {
+            return 0;
+        }
+        p = skip_digits(p + 1);
+    }
+    if (*p == 'e' || *p == 'E') {
+        p++;
+        if (*p == '+' || *p == '-') {
+            p++;
+        }
+        if (!isdigit((unsigned char) *p)) {
+            return 0;
+        }
+        p = skip_digits(p);
+    }
+    return *p == '\0';
+}
+
+/*
+ * parse_scalar:
+ *   Copies a number, true, false or null at p into field->scalar.
+ *
+ * RETURNS:
+ *   The character after it, or NULL if it is none of those.
+ */
+
+static char *parse_scalar(char *p, struct Field *field) {
+    size_t length = 0;
+
+    while (isalnum((unsigned char) p[length]) || p[length] == '-' || p[length] == '+' || p[length] == '.') {
+        length++;
+    }
+    if (length == 0 || length >= sizeof(field->scalar)) {
+        return NULL;
+    }
+    memcpy(field->scalar, p, length);
+    field->scalar[length] = '\0';
+
+    if (strcmp(field->scalar, "true") != 0 && strcmp(field->scalar, "false") != 0 &&
+        strcmp(field->scalar, "null") != 0 && !json_number(field->scalar)) {
+        return NULL;
+    }
+    field->value = field->scalar;
+    field->isString = 0;
+    return p + length;
+}
+
+/*
+ * parse_command:
+ *   Reads a flat JSON object from 'line', which it modifies. Nested
+ *   objects and arrays are not accepted; no command uses them.
+ *
+ * RETURNS:
+ *   0 on success, 1 if the line is not such an object.
+ */
+
+static int parse_command(char *line, struct Command *command) {
+    char *p = skip_space(line);
+    int i;
+
+    memset(command, 0, sizeof(*command));
+    if (*p != '{') {
+        return 1;
+    }
+    p = skip_space(p + 1);
+
+    while (*p != '}') {
+        struct Field *field;
+
+        if (*p != '"' || command->count == PROTOCOL_FIELDS) {
+            return 1;
+        }
+        field = &command->fields[command->count];
+        p = parse_string(p, &field->key);
+        if (p == NULL) {
+            return 1;
+        }
+        p = skip_space(p);
+        if (*p != ':') {
+            return 1;
+        }
+        p = skip_space(p + 1);
+
+        if (*p == '"') {
+            p = parse_string(p, &field->value);
+            field->isString = 1;
+        } else {
+            p = parse_scalar(p, field);
+        }
+        if (p == NULL) {
+            return 1;
+        }
+        command->count++;
+
+        p = skip_space(p);
+        if (*p == ',') {
+            p = skip_space(p + 1);
+            if (*p == '}') {
+                return 1;   // no trailing commas
+            }
+        } else if (*p != '}') {
+            return 1;
+        }
+    }
+    if (*skip_space(p + 1) != '\0') {
+        return 1;
+    }
+
+    for (i = command->count - 1; i >= 0; i--) {
+        if (strcmp(command->fields[i].key, "cmd") == 0 && command->fields[i].isString) {
+            command->cmd = command->fields[i].value;
+        } else if (strcmp(command->fields[i].key, "id") == 0) {
+            command->id = &command->fields[i];
+        }
+    }
+    return 0;
+}
+
+/* string_field: the string value of 'key', or NULL */
+static const char *string_field(const struct Command *command, const char *key) {
+    int i;
+
+    for (i = 0; i < command->count; i++) {
+        if (strcmp(command->fields[i].key, key) == 0) {
+            return command->fields[i].isString ? command->fields[i].value : NULL;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * number_field:
+ *   Reads whole number 'key' in [low, high], or 'fallback' if it is absent.
+ *
+ * RETURNS:
+ *   0 on success, 1 if it is present but not such a number.
+ */
+
+static int number_field(const struct Command *command, const char *key, long low, long high,
+                        long fallback, long *value) {
+    char *end;
+    int i;
+
+    *value = fallback;
+    for (i = 0; i < command->count; i++) {
+        if (strcmp(command->fields[i].key, key) == 0) {
+            if (command->fields[i].isString) {
+                return 1;
+            }
+            *value = strtol(command->fields[i].value, &end, 10);
+            return (*end != '\0' || *value < low || *value > high);
+        }
+    }
+    return 0;
+}
+
+/* ---------------------------------------------------------------------
+ * Output
+ * ------------------------------------------------------------------- */
+
+/* put_bytes: appends raw bytes to the pending output */
+static void put_bytes(struct Protocol *p, const char *bytes, size_t length) {
+    if (p->outLength + length > p->outCapacity) {
+        size_t capacity = p->outCapacity > 0 ? p->outCapacity : PROTOCOL_FLUSH_BYTES;
+        char *grown;
+
+        while (capacity < p->outLength + length) {
+            capacity = capacity * 2;
+        }
+        grown = realloc(p->out, capacity);
+        if (grown == NULL) {
+            p->writeFailed = 1;
+            return;
+        }
+        p->out = grown;
+        p->outCapacity = capacity;
+    }
+    memcpy(p->out + p->outLength, bytes, length);
+    p->outLength = p->outLength + length;
+}
+
+/* put: appends printf-formatted text */
+static void put(struct Protocol *p, const char *format, ...) {
+    char text[512];
+    va_list args;
+    int length;
+
+    va_start(args, format);
+    length = vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+
+    if (length > 0) {
+        put_bytes(p, text, (size_t) length < sizeof(text) ? (size_t) length : sizeof(text) - 1);
+    }
+}
+
+/* put_string: appends s as a JSON string */
+static void put_string(struct Protocol *p, const char *s) {
+    put_bytes(p, "\"", 1);
+    for (; *s != '\0'; s++) {
+        unsigned char c = (unsigned char) *s;
+
+        if (c == '"' || c == '\\') {
+            char escaped[2] = {'\\', (char) c};
+
+            put_bytes(p, escaped, 2);
+        } else if (c < 0x20) {
+            put(p, "\\u%04x", c);
+        } else {
+            put_bytes(p, s, 1);
+        }
+    }
+    put_bytes(p, "\"", 1);
+}
+
+/* begin: the start of a response, up to the fields particular to the command */
+static void begin(struct Protocol *p, const struct Command *command, int ok) {
+    put(p, "{\"ok\":%s", ok ? "true" : "false");
+    if (command != NULL && command->cmd != NULL) {
+        put(p, ",\"cmd\":");
+        put_string(p, command->cmd);
+    }
+    if (command != NULL && command->id != NULL) {
+        put(p, ",\"id\":");
+        if (command->id->isString) {
+            put_string(p, command->id->value);
+        } else {
+            put(p, "%s", command->id->value);
+        }
+    }
+}
+
+/* fail: a whole error response */
+static void fail(struct Protocol *p, const struct Command *command, const char *message) {
+    begin(p, command, 0);
+    put(p, ",\"error\":");
+    put_string(p, message);
+    put(p, "}\n");
+}
+
+/* game_saved: the result log's callback; status goes to the game's Saved entry */
+static void game_saved(void *context, int status) {
+    struct Protocol *p = context;
+
+    pthread_mutex_lock(&p->lock);
+    p->saved[p->savedDone].status = status;
+    p->savedDone = p->savedDone + 1;
+    pthread_cond_signal(&p->savedCond);
+    pthread_mutex_unlock(&p->lock);
+}
+
+/*
+ * flush_output:
+ *   Waits until every game finished since the last flush is saved (the
+ *   result log commits them together), then writes the pending output
+ *   with each game's last response in its saved or failed version.
+ */
+
+static void flush_output(struct Protocol *p) {
+    size_t at = 0;
+    int i;
+
+    pthread_mutex_lock(&p->lock);
+    while (p->savedDone < p->savedCount) {
+        pthread_cond_wait(&p->savedCond, &p->lock);
+    }
+    pthread_mutex_unlock(&p->lock);
+
+    for (i = 0; i < p->savedCount && !p->writeFailed; i++) {
+        const struct Saved *s = &p->saved[i];
+
+        if (writeAll(p->outFd, p->out + at, s->okStart - at) != 0 ||
+            (s->status == 0 ? writeAll(p->outFd, p->out + s->okStart, s->okEnd - s->okStart)
+                            : writeAll(p->outFd, p->out + s->okEnd, s->end - s->okEnd)) != 0) {
+            p->writeFailed = 1;
+        }
+        at = s->end;
+    }
+    if (!p->writeFailed && writeAll(p->outFd, p->out + at, p->outLength - at) != 0) {
+        p->writeFailed = 1;
+    }
+
+    p->outLength = 0;
+    p->savedCount = 0;
+    p->savedDone = 0;
+}
+
+/* ---------------------------------------------------------------------
+ * Commands
+ * ------------------------------------------------------------------- */
+
+/* command_login: checks the password and upgrades an outdated hash */
+static void command_login(struct Protocol *p, const struct Command *command) {
+    const char *user = string_field(command, "user");
+    const char *password = string_field(command, "password");
+    WxStatus status;
+
+    if (p->loggedIn) {
+        fail(p, command, "already logged in");
+    } else if (user == NULL || password == NULL) {
+        fail(p, command, "login needs \"user\" and \"password\"");
+    } else if ((status = wxLogin(p->ctx, user, password)) != WX_OK) {
+        fail(p, command, wxStatusMessage(status));
+    } else {
+        snprintf(p->username, sizeof(p->username), "%s", user);
+        p->loggedIn = 1;
+        begin(p, command, 1);
+        put(p, ",\"user\":");
+        put_string(p, p->username);
+        put(p, "}\n");
+    }
+}
+
+/* command_register: creates an account and logs in to it */
+static void command_register(struct Protocol *p, const struct Command *command) {
+    const char *user = string_field(command, "user");
+    const char *password = string_field(command, "password");
+    WxStatus status;
+
+    if (p->loggedIn) {
+        fail(p, command, "already logged in");
+    } else if (user == NULL || password == NULL) {
+        fail(p, command, "register needs \"user\" and \"password\"");
+    } else if ((status = wxRegister(p->ctx, user, password)) != WX_OK) {
+        // Say which password rule was missed, not just that one was
+        fail(p, command, status == WX_WEAK_PASSWORD ? passwordProblem(password) : wxStatusMessage(status));
+    } else {
+        snprintf(p->username, sizeof(p->username), "%s", user);
+        p->loggedIn = 1;
+        begin(p, command, 1);
+        put(p, ",\"user\":");
+        put_string(p, p->username);
+        put(p, "}\n");
+    }
+}
+
+/* command_new_game: starts a round with a random answer */
+static void command_new_game(struct Protocol *p, const struct Command *command) {
+    if (p->playing) {
+        fail(p, command, "finish the current game first");
+        return;
+    }
+    if (wxNewGame(p->ctx, &p->rng, &p->game) != WX_OK) {
+        fail(p, command, "no word list");
+        return;
+    }
+    p->playing = 1;
+
+    begin(p, command, 1);
+    put(p, ",\"guesses_left\":%d}\n", MAX_GUESSES);
+}
+
+/* put_keys: the letters whose keyboard colour is 'color', as a JSON string */
+static void put_keys(struct Protocol *p, int color) {
+    char letters[27];
+    int count = 0;
+    char c;
+
+    for (c = 'a'; c <= 'z'; c++) {
+        uint32_t bit = letterBit(c);
+        int shown = (p->game.keysGreen & bit) ? DIGIT_GREEN
+                  : (p->game.keysYellow & bit) ? DIGIT_YELLOW
+                  : (p->game.keysGray & bit) ? DIGIT_GRAY : -1;
+
+        if (shown == color) {
+            letters[count++] = c;
+        }
+    }
+    letters[count] = '\0';
+    put_string(p, letters);
+}
+
+/* put_guess: a guess response without its closing brace, for a given status */
+static void put_guess(struct Protocol *p, const struct Command *command, const char *pattern,
+                      uint8_t code, const char *status) {
+    begin(p, command, 1);
+    put(p, ",\"word\":\"%s\",\"pattern\":\"%s\",\"code\":%u,\"guesses\":%d,\"guesses_left\":%d,\"status\":\"%s\"",
+        p->game.guessWords[p->game.guessCount - 1], pattern, code, p->game.guessCount,
+        MAX_GUESSES - p->game.guessCount, status);
+    if (strcmp(status, "playing") != 0) {
+        put(p, ",\"answer\":\"%s\"", p->game.answerWord);
+    }
+    put(p, ",\"keyboard\":{\"green\":");
+    put_keys(p, DIGIT_GREEN);
+    put(p, ",\"yellow\":");
+    put_keys(p, DIGIT_YELLOW);
+    put(p, ",\"gray\":");
+    put_keys(p, DIGIT_GRAY);
+    put(p, "}");
+}
+
+/*
+ * command_guess:
+ *   Scores a guess. The last guess of a game sends the game to the result
+ *   log and leaves two versions of its response in the output; the flush
+ *   picks one once the log says whether the game was saved.
+ */
+
+static void command_guess(struct Protocol *p, const struct Command *command) {
+    const char *given = string_field(command, "word");
+    const char *status;
+    struct Saved *saved;
+    WxStatus result;
+    char pattern[6];
+    uint8_t code;
+    int i;
+
+    if (!p->playing) {
+        fail(p, command, "no game in progress, send new_game");
+        return;
+    }
+    result = (given == NULL) ? WX_BAD_WORD : wxGuess(&p->game, given, &code);
+    if (result != WX_OK) {
+        fail(p, command, wxStatusMessage(result));
+        return;
+    }
+
+    for (i = 0; i < 5; i++) {
+        int digit = patternDigit(code, i);
+
+        pattern[i] = digit == DIGIT_GREEN ? 'G' : (digit == DIGIT_YELLOW ? 'Y' : '.');
+    }
+    pattern[5] = '\0';
+
+    if (!gameStateOver(&p->game)) {
+        put_guess(p, command, pattern, code, "playing");
+        put(p, "}\n");
+        return;
+    }
+
+    p->playing = 0;
+    status = p->game.won ? "won" : "lost";
+
+    pthread_mutex_lock(&p->lock);
+    if (p->savedCount == p->savedCapacity) {
+        int capacity = p->savedCapacity > 0 ? p->savedCapacity * 2 : 64;
+        struct Saved *grown = realloc(p->saved, sizeof(struct Saved) * (size_t) capacity);
+
+        if (grown == NULL) {
+            pthread_mutex_unlock(&p->lock);
+            fail(p, command, "could not record the game");
+            return;
+        }
+        p->saved = grown;
+        p->savedCapacity = capacity;
+    }
+    saved = &p->saved[p->savedCount];
+    saved->okStart = p->outLength;
+    put_guess(p, command, pattern, code, status);
+    put(p, "}\n");
+    saved->okEnd = p->outLength;
+    put_guess(p, command, pattern, code, status);
+    put(p, ",\"error\":\"could not record the game\"}\n");
+    saved->end = p->outLength;
+    p->savedCount = p->savedCount + 1;
+    pthread_mutex_unlock(&p->lock);
+
+    wxSaveGame(p->ctx, p->username, &p->game, game_saved, p);
+}
+
+/* command_hint: the highest-information next guess */
+static void command_hint(struct Protocol *p, const struct Command *command) {
+    Hint hint;
+
+    if (!p->playing) {
+        fail(p, command, "no game in progress, send new_game");
+    } else if (wxHint(&p->game, &hint) != WX_OK) {
+        fail(p, command, "no hint available");
+    } else {
+        begin(p, command, 1);
+        put(p, ",\"word\":\"%s\",\"candidates\":%d}\n", hint.word, hint.candidates);
+    }
+}
+
+/* command_stats: the player's statistics */
+static void command_stats(struct Protocol *p, const struct Command *command) {
+    Stats stats;
+
+    wxStats(p->ctx, p->username, &stats);
+    begin(p, command, 1);
+    put(p, ",\"games\":%d,\"wins\":%d,\"losses\":%d,\"streak\":%d,\"best_streak\":%d,\"guesses\":%d,"
+           "\"distribution\":[%d,%d,%d,%d,%d,%d]}\n",
+        stats.gamesPlayed, stats.wins, stats.losses, stats.currentStreak, stats.maxStreak,
+        stats.totalGuesses, stats.winsByGuess[0], stats.winsByGuess[1], stats.winsByGuess[2],
+        stats.winsByGuess[3], stats.winsByGuess[4], stats.winsByGuess[5]);
+}
+
+/* command_leaderboard: the best "limit" players */
+static void command_leaderboard(struct Protocol *p, const struct Command *command) {
+    struct LeaderboardEntry *entries;
+    long limit;
+    int shown, i;
+
+    if (number_field(command, "limit", 1, PROTOCOL_ROWS_MAX, PROTOCOL_LEADERS, &limit) != 0) {
+        fail(p, command, "limit must be 1-100");
+        return;
+    }
+
+    shown = wxLeaderboard(p->ctx, (int) limit, &entries);
+    if (shown < 0) {
+        fail(p, command, "out of memory");
+        return;
+    }
+
+    begin(p, command, 1);
+    put(p, ",\"players\":[");
+    for (i = 0; i < shown; i++) {
+        put(p, "%s{\"rank\":%d,\"user\":", i > 0 ? "," : "", i + 1);
+        put_string(p, entries[i].username);
+        put(p, ",\"games\":%d,\"wins\":%d,\"losses\":%d,\"win_rate\":%.4f,\"avg_guesses\":%.2f}",
+            entries[i].gamesPlayed, entries[i].wins, entries[i].losses,
+            entries[i].winRate, entries[i].avgGuesses);
+    }
+    put(p, "]}\n");
+    free(entries);
+}
+
+/* command_history: "limit" games, newest first, after skipping "offset" */
+static void command_history(struct Protocol *p, const struct Command *command) {
+    struct GameResult games[PROTOCOL_ROWS_MAX];
+    long limit, offset, shown, i;
+
+    if (number_field(command, "limit", 1, PROTOCOL_ROWS_MAX, PROTOCOL_HISTORY_ROWS, &limit) != 0 ||
+        number_field(command, "offset", 0, 1L << 40, 0, &offset) != 0) {
+        fail(p, command, "limit must be 1-100 and offset 0 or more");
+        return;
+    }
+
+    shown = wxHistory(p->ctx, offset, limit, games);
+
+    begin(p, command, 1);
+    put(p, ",\"games\":[");
+    for (i = 0; i < shown; i++) {
+        put(p, "%s{\"user\":", i > 0 ? "," : "");
+        put_string(p, games[i].username);
+        put(p, ",\"word\":");
+        put_string(p, games[i].word);
+        put(p, ",\"guesses\":%d,\"won\":%s,\"time\":", games[i].guesses, games[i].won ? "true" : "false");
+        put_string(p, games[i].timestamp);
+        put(p, "}");
+    }
+    put(p, "]}\n");
+}
+
+/*
+ * handle_line:
+ *   Parses and answers one command.
+ *
+ * RETURNS:
+ *   1 after "quit", 0 otherwise.
+ */
+
+static int handle_line(struct Protocol *p, char *line) {
+    struct Command command;
+
+    if (*skip_space(line) == '\0') {
+        return 0;
+    }
+    if (parse_command(line, &command) != 0) {
+        fail(p, NULL, "invalid JSON object");
+        return 0;
+    }
+    if (command.cmd == NULL) {
+        fail(p, &command, "missing \"cmd\"");
+        return 0;
+    }
+
+    if (strcmp(command.cmd, "quit") == 0) {
+        begin(p, &command, 1);
+        put(p, "}\n");
+        return 1;
+    } else if (strcmp(command.cmd, "login") == 0) {
+        command_login(p, &command);
+    } else if (strcmp(command.cmd, "register") == 0) {
+        command_register(p, &command);
+    } else if (strcmp(command.cmd, "leaderboard") == 0) {
+        command_leaderboard(p, &command);
+    } else if (strcmp(command.cmd, "history") == 0) {
+        command_history(p, &command);
+    } else if (strcmp(command.cmd, "new_game") != 0 && strcmp(command.cmd, "guess") != 0 &&
+               strcmp(command.cmd, "hint") != 0 && strcmp(command.cmd, "stats") != 0) {
+        fail(p, &command, "unknown command");
+    } else if (!p->loggedIn) {
+        fail(p, &command, "log in first");
+    } else if (strcmp(command.cmd, "new_game") == 0) {
+        command_new_game(p, &command);
+    } else if (strcmp(command.cmd, "guess") == 0) {
+        command_guess(p, &command);
+    } else if (strcmp(command.cmd, "hint") == 0) {
+        command_hint(p, &command);
+    } else {
+        command_stats(p, &command);
+    }
+    return 0;
+}
+
+/* input_waiting: 1 if inFd can be read without blocking */
+static int input_waiting(int fd) {
+    struct pollfd pfd;
+
+    pfd.fd = fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    return poll(&pfd, 1, 0) > 0;
+}
+
+/*
+ * runProtocol:
+ *   Reads commands in chunks of up to PROTOCOL_READ_BYTES and answers every
+ *   complete line. Output is flushed only when no more input is waiting,
+ *   or PROTOCOL_FLUSH_BYTES are pending, so scripted clients that send
+ *   ahead get batched writes and batched result log syncs.
+ *
+ * RETURNS:
+ *   0, or 1 if output could not be written.
+ */
+
+int runProtocol(WxContext *ctx, int inFd, int outFd) {
+    struct Protocol *p = calloc(1, sizeof(struct Protocol));
+    char *in = malloc(PROTOCOL_READ_BYTES);
+    size_t have = 0;
+    int skipping = 0;   // discarding the rest of an over-long line
+    int quit = 0;
+    int failed;
+
+    if (p == NULL || in == NULL) {
+        fprintf(stderr, "Error: out of memory\n");
+        free(p);
+        free(in);
+        return 1;
+    }
+
+    p->ctx = ctx;
+    p->outFd = outFd;
+    p->rng = wxSeed();
+    pthread_mutex_init(&p->lock, NULL);
+    pthread_cond_init(&p->savedCond, NULL);
+
+    while (!quit && !p->writeFailed) {
+        ssize_t got = read(inFd, in + have, PROTOCOL_READ_BYTES - 1 - have);
+        size_t start = 0;
+        char *newline;
+
+        if (got < 0 && errno == EINTR) {
+            continue;
+        }
+        if (got <= 0) {
+            // A last command without a newline still counts
+            if (have > 0 && !skipping) {
+                in[have] = '\0';
+                handle_line(p, in);
+            }
+            break;
+        }
+        have = have + (size_t) got;
+
+        while (!quit && (newline = memchr(in + start, '\n', have - start)) != NULL) {
+            *newline = '\0';
+            if (skipping) {
+                skipping = 0;
+            } else if ((size_t) (newline - (in + start)) >= PROTOCOL_LINE_MAX) {
+                fail(p, NULL, "command too long");
+            } else {
+                quit = handle_line(p, in + start);
+            }
+            start = (size_t) (newline - in) + 1;
+        }
+
+        memmove(in, in + start, have - start);
+        have = have - start;
+        if (have >= PROTOCOL_LINE_MAX && !skipping) {
+            fail(p, NULL, "command too long");
+            skipping = 1;
+        }
+        if (skipping) {
+            have = 0;
+        }
+
+        if (quit || p->outLength >= PROTOCOL_FLUSH_BYTES || !input_waiting(inFd)) {
+            flush_output(p);
+        }
+    }
+
+    flush_output(p);
+    failed = p->writeFailed;
+
+    free(p->out);
+    free(p->saved);
+    free(p);
+    free(in);
+    return failed;
+}
@@ -0,0 +1,190 @@
+/* record_parser.c
+ *
+ * The tokenizer shared by every reader of history.txt and stats.txt.
+ *
+ * FUNCTIONALITY:
+ *  - recordNextField: the next whitespace-separated field of a line, as a
+ *    view into the caller's buffer
+ *  - recordFieldInt / recordFieldLong / recordFieldCopy: the field as a
+ *    number or a bounded string
+ *  - recordReadGame / recordParseGame: one history game record
+ *
+ * It replaces the sscanf formats the history, leaderboard and statistics
+ * modules each kept. Unlike sscanf it needs no NUL-terminated copy of the
+ * line, does not look at the locale, and a field too long for its
+ * destination (or a number with anything after it) makes the line bad
+ * instead of spilling into the next field.
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#include <string.h>
+#include <limits.h>
+#include <errno.h>
+#include "../headerFiles/record_parser.h"
+
+/* Digits that always fit in a long without checking for overflow */
+#define FAST_DIGITS 18
+
+/* is_blank: the characters isspace accepts in the C locale */
+static int is_blank(char c) {
+    return c == ' ' || (unsigned char) (c - '\t') <= (unsigned char) ('\r' - '\t');
+}
+
+/* recordCursorInit: a cursor over [text, text + length) */
+void recordCursorInit(RecordCursor *cursor, const char *text, size_t length) {
+    cursor->next = text;
+    cursor->end = text + length;
+}
+
+/* recordNextField: skips blanks, then takes everything up to the next blank */
+int recordNextField(RecordCursor *cursor, RecordField *field) {
+    const char *p = cursor->next;
+    const char *end = cursor->end;
+    const char *start;
+
+    while (p < end && is_blank(*p)) {
+        p++;
+    }
+    if (p == end) {
+        cursor->next = p;
+        return 0;
+    }
+
+    start = p;
+    while (p < end && !is_blank(*p)) {
+        p++;
+    }
+    field->text = start;
+    field->length = (size_t) (p - start);
+    cursor->next = p;
+    return 1;
+}
+
+/*
+ * slow_long:
+ *   strtol on a copy, for fields with more digits than the fast path
+ *   takes (leading zeros, or a value near the limits).
+ *
+ * RETURNS:
+ *   0 on success, 1 if the field is not a number that fits in a long.
+ */
+
+static int slow_long(RecordField field, long *out) {
+    char copy[64];
+    char *stop;
+    long value;
+
+    if (field.length >= sizeof(copy)) {
+        return 1;
+    }
+    memcpy(copy, field.text, field.length);
+    copy[field.length] = '\0';
+
+    errno = 0;
+    value = strtol(copy, &stop, 10);
+    if (errno != 0 || *stop != '\0' || stop == copy) {
+        return 1;
+    }
+    *out = value;
+    return 0;
+}
+
+/*
+ * recordFieldLong:
+ *   Accumulates up to FAST_DIGITS digits directly; longer fields go
+ *   through strtol.
+ *
+ * RETURNS:
+ *   0 on success, 1 if the field is not a number.
+ */
+
+int recordFieldLong(RecordField field, long *out) {
+    const char *p = field.text;
+    const char *end = field.text + field.length;
+    int negative = 0;
+    long value = 0;
+
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = (*p == '-');
+        p++;
+    }
+    if (p == end) {
+        return 1;
+    }
+    if (end - p > FAST_DIGITS) {
+        return slow_long(field, out);
+    }
+
+    while (p < end) {
+        unsigned digit = (unsigned) (*p - '0');
+
+        if (digit > 9) {
+            return 1;
+        }
+        value = value * 10 + (long) digit;
+        p++;
+    }
+    *out = negative ? -value : value;
+    return 0;
+}
+
+/* recordFieldInt: recordFieldLong limited to the range of an int */
+int recordFieldInt(RecordField field, int *out) {
+    long value;
+
+    if (recordFieldLong(field, &value) != 0 || value < INT_MIN || value > INT_MAX) {
+        return 1;
+    }
+    *out = (int) value;
+    return 0;
+}
+
+/* recordFieldCopy: the field as a NUL-terminated string, if it fits */
+int recordFieldCopy(RecordField field, char *out, size_t size) {
+    if (field.length >= size) {
+        return 1;
+    }
+    memcpy(out, field.text, field.length);
+    out[field.length] = '\0';
+    return 0;
+}
+
+/* recordNextInt: the next field as an int */
+int recordNextInt(RecordCursor *cursor, int *out) {
+    RecordField field;
+
+    return recordNextField(cursor, &field) && recordFieldInt(field, out) == 0;
+}
+
+/* recordNextLong: the next field as a long */
+int recordNextLong(RecordCursor *cursor, long *out) {
+    RecordField field;
+
+    return recordNextField(cursor, &field) && recordFieldLong(field, out) == 0;
+}
+
+/* recordNextString: the next field copied into out[size] */
+int recordNextString(RecordCursor *cursor, char *out, size_t size) {
+    RecordField field;
+
+    return recordNextField(cursor, &field) && recordFieldCopy(field, out, size) == 0;
+}
+
+/* recordReadGame: username, word, guesses, won and timestamp, in that order */
+int recordReadGame(RecordCursor *cursor, struct GameResult *r) {
+    return recordNextString(cursor, r->username, NAME_MAX_LEN) &&
+           recordNextString(cursor, r->word, WORD_MAX_LEN) &&
+           recordNextInt(cursor, &r->guesses) &&
+           recordNextInt(cursor, &r->won) &&
+           recordNextString(cursor, r->timestamp, TIME_MAX_LEN);
+}
+
+/* recordParseGame: recordReadGame over one line */
+int recordParseGame(const char *text, size_t length, struct GameResult *r) {
+    RecordCursor cursor;
+
+    recordCursorInit(&cursor, text, length);
+    return recordReadGame(&cursor, r);
+}
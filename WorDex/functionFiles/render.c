@@ -0,0 +1,333 @@
+/* render.c
+ *
+ * Frame renderer for the Wordex game board.
+ *
+ * FUNCTIONALITY:
+ *  - rendererDraw: lays the board and keyboard out as a grid of cells,
+ *    turns it into bytes in a preallocated buffer and sends them with a
+ *    single write(2)
+ *  - in RENDER_ANSI mode only cells that differ from the frame on screen
+ *    are sent, each run after a cursor move; the first frame (and any
+ *    frame on a terminal too short to keep it in place, or after enough
+ *    prompts and messages to scroll it) clears the screen with ANSI codes
+ *    instead of running clear(1)
+ *  - in RENDER_PLAIN mode every frame is sent in full, byte for byte what
+ *    the old printf-based board printed
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include "../headerFiles/render.h"
+#include "../headerFiles/file_io.h"
+
+#define ANSI_CLEAR       "\033[H\033[2J\033[3J"
+#define COLOR_GREEN      32
+#define COLOR_YELLOW     33
+#define COLOR_GRAY       90
+
+/* Keyboard rows, and how far each is indented */
+static const char *keyboardRows[] = {"qwertyuiop", "asdfghjkl", "zxcvbnm"};
+static const char *keyboardIndent[] = {"║    ", "║      ", "║         "};
+static const char *keyboardEnd[] = {"   ║", "     ║", "          ║"};
+
+/* The game's stdout renderer */
+static Renderer screen;
+static int screenReady = 0;
+
+/*
+ * put_text:
+ *   Appends UTF-8 text to a frame line, one cell per character.
+ */
+
+static void put_text(Frame *f, int row, const char *text, uint8_t color) {
+    const unsigned char *p = (const unsigned char *) text;
+
+    while (*p != '\0' && f->width[row] < FRAME_COLS) {
+        FrameCell *cell = &f->cells[row][f->width[row]];
+        uint8_t length = (*p >= 0xe0) ? 3 : (*p >= 0xc0 ? 2 : 1);
+
+        memset(cell, 0, sizeof(*cell));
+        memcpy(cell->glyph, p, length);
+        cell->length = length;
+        cell->color = color;
+        f->width[row]++;
+        p = p + length;
+    }
+}
+
+/* put_letter: appends one upper-case letter in a colour */
+static void put_letter(Frame *f, int row, char letter, uint8_t color) {
+    char text[2];
+
+    text[0] = (char) toupper((unsigned char) letter);
+    text[1] = '\0';
+    put_text(f, row, text, color);
+}
+
+/* letter_color: a keyboard letter's colour from the game's masks */
+static uint8_t letter_color(const GameState *game, char letter) {
+    uint32_t bit = letterBit(letter);
+
+    if (game->keysGreen & bit) {
+        return COLOR_GREEN;
+    }
+    if (game->keysYellow & bit) {
+        return COLOR_YELLOW;
+    }
+    return (game->keysGray & bit) ? COLOR_GRAY : 0;
+}
+
+/*
+ * build_frame:
+ *   Lays out the board (guesses coloured by their stored patterns) and
+ *   the keyboard (coloured by the game's masks). Only reads the game.
+ */
+
+static void build_frame(Frame *f, const GameState *game) {
+    int row, col, i;
+
+    memset(f, 0, sizeof(*f));
+
+    put_text(f, 1, "╔═══════════════════════════════════════════════╗", 0);
+    put_text(f, 2, "║                    WORDEX                     ║", 0);
+    put_text(f, 3, "╠═══════════════════════════════════════════════╣", 0);
+
+    for (row = 0; row < MAX_GUESSES; row++) {
+        put_text(f, 4 + row, "║       ", 0);
+
+        for (col = 0; col < 5; col++) {
+            if (row < game->guessCount) {
+                int digit = patternDigit(game->patterns[row], col);
+                uint8_t color = digit == DIGIT_GREEN ? COLOR_GREEN
+                              : (digit == DIGIT_YELLOW ? COLOR_YELLOW : COLOR_GRAY);
+
+                put_letter(f, 4 + row, game->guessWords[row][col], color);
+            } else {
+                put_text(f, 4 + row, "_", 0);
+            }
+            put_text(f, 4 + row, "       ", 0);
+        }
+        put_text(f, 4 + row, "║", 0);
+    }
+    put_text(f, 10, "╚═══════════════════════════════════════════════╝", 0);
+
+    put_text(f, 13, "╔═══════════════════════════════════════════════╗", 0);
+    put_text(f, 14, "║              KEYBOARD STATUS                  ║", 0);
+    put_text(f, 15, "╠═══════════════════════════════════════════════╣", 0);
+
+    for (row = 0; row < 3; row++) {
+        put_text(f, 16 + row, keyboardIndent[row], 0);
+        for (i = 0; keyboardRows[row][i] != '\0'; i++) {
+            put_text(f, 16 + row, " ", 0);
+            put_letter(f, 16 + row, keyboardRows[row][i], letter_color(game, keyboardRows[row][i]));
+            put_text(f, 16 + row, "  ", 0);
+        }
+        put_text(f, 16 + row, keyboardEnd[row], 0);
+    }
+    put_text(f, 19, "╚═══════════════════════════════════════════════╝", 0);
+}
+
+/*
+ * put_cell:
+ *   Appends one cell's bytes at out + length: a coloured cell is wrapped
+ *   in its own SGR code and a reset, exactly as the old board printed it.
+ *
+ * RETURNS:
+ *   The new length.
+ */
+
+static size_t put_cell(char *out, size_t length, const FrameCell *cell) {
+    if (cell->color != 0) {
+        length += (size_t) sprintf(out + length, "\033[%um", cell->color);
+    }
+    memcpy(out + length, cell->glyph, cell->length);
+    length = length + cell->length;
+    if (cell->color != 0) {
+        memcpy(out + length, "\033[0m", 4);
+        length = length + 4;
+    }
+    return length;
+}
+
+/* put_full: every line of the next frame, each ended by a newline */
+static size_t put_full(const Renderer *r, char *out, size_t length) {
+    int row, col;
+
+    for (row = 0; row < FRAME_ROWS; row++) {
+        for (col = 0; col < r->next.width[row]; col++) {
+            length = put_cell(out, length, &r->next.cells[row][col]);
+        }
+        out[length++] = '\n';
+    }
+    return length;
+}
+
+/* same_cell: 1 if cell (row, col) looks the same in both frames (a missing cell is a blank) */
+static int same_cell(const Renderer *r, int row, int col) {
+    static const FrameCell blank = {" ", 1, 0};
+    const FrameCell *a = col < r->shown.width[row] ? &r->shown.cells[row][col] : &blank;
+    const FrameCell *b = col < r->next.width[row] ? &r->next.cells[row][col] : &blank;
+
+    return a->length == b->length && a->color == b->color && memcmp(a->glyph, b->glyph, a->length) == 0;
+}
+
+/*
+ * put_diff:
+ *   The cells that changed since the frame on screen: a cursor move to
+ *   the start of each run of changed cells, then the cells. The cursor is
+ *   left below the frame, with the prompts and messages printed since the
+ *   last frame erased.
+ *
+ * RETURNS:
+ *   The new length.
+ */
+
+static size_t put_diff(const Renderer *r, char *out, size_t length) {
+    static const FrameCell blank = {" ", 1, 0};
+    int row, col;
+
+    for (row = 0; row < FRAME_ROWS; row++) {
+        int width = r->shown.width[row] > r->next.width[row] ? r->shown.width[row] : r->next.width[row];
+
+        col = 0;
+        while (col < width) {
+            if (same_cell(r, row, col)) {
+                col++;
+                continue;
+            }
+            length += (size_t) sprintf(out + length, "\033[%d;%dH", row + 1, col + 1);
+            while (col < width && !same_cell(r, row, col)) {
+                length = put_cell(out, length,
+                                  col < r->next.width[row] ? &r->next.cells[row][col] : &blank);
+                col++;
+            }
+        }
+    }
+    length += (size_t) sprintf(out + length, "\033[%d;1H\033[J", FRAME_ROWS + 1);
+    return length;
+}
+
+/*
+ * in_place:
+ *   1 if the frame on screen still starts at the top row: the terminal is
+ *   big enough to keep a frame in place, and the lines printed under it
+ *   (the cursor sits on the line after them) have not scrolled it up.
+ */
+
+static int in_place(const Renderer *r) {
+    struct winsize size;
+
+    if (ioctl(r->fd, TIOCGWINSZ, &size) != 0) {
+        return 0;
+    }
+    return size.ws_row >= FRAME_ROWS + RENDER_SPARE_ROWS && size.ws_col >= FRAME_COLS &&
+           FRAME_ROWS + r->linesBelow < size.ws_row;
+}
+
+/* write_frame: sends a frame with one write (after anything printf still holds) */
+static void write_frame(int fd, const char *bytes, size_t length) {
+    if (fd == STDOUT_FILENO) {
+        fflush(stdout);
+    }
+    writeAll(fd, bytes, length);
+}
+
+/* rendererInit: nothing is on screen yet */
+void rendererInit(Renderer *r, int fd, int mode) {
+    memset(r, 0, sizeof(*r));
+    r->fd = fd;
+    r->mode = mode;
+}
+
+/* rendererNoteLine: a line too wide for the terminal wraps onto several */
+void rendererNoteLine(Renderer *r, int width) {
+    struct winsize size;
+    int columns = FRAME_COLS;
+
+    if (r->mode != RENDER_ANSI) {
+        return;
+    }
+    if (ioctl(r->fd, TIOCGWINSZ, &size) == 0 && size.ws_col > 0) {
+        columns = size.ws_col;
+    }
+    r->linesBelow = r->linesBelow + (width > columns ? (width + columns - 1) / columns : 1);
+}
+
+/* rendererInvalidate: forget what the screen shows */
+void rendererInvalidate(Renderer *r) {
+    r->shownValid = 0;
+}
+
+/*
+ * rendererDraw:
+ *   Builds the frame for 'game' and sends it: in full in RENDER_PLAIN mode
+ *   or when nothing valid is on screen, otherwise just the changes.
+ *
+ * RETURNS:
+ *   The number of bytes written.
+ */
+
+size_t rendererDraw(Renderer *r, const GameState *game) {
+    static const GameState empty;
+    size_t length = 0;
+
+    build_frame(&r->next, game != NULL ? game : &empty);
+
+    if (r->mode == RENDER_PLAIN) {
+        length = put_full(r, r->out, 0);
+    } else if (!r->shownValid || !in_place(r)) {
+        memcpy(r->out, ANSI_CLEAR, strlen(ANSI_CLEAR));
+        length = put_full(r, r->out, strlen(ANSI_CLEAR));
+    } else {
+        length = put_diff(r, r->out, 0);
+    }
+
+    write_frame(r->fd, r->out, length);
+    r->shown = r->next;
+    r->shownValid = (r->mode == RENDER_ANSI);
+    r->linesBelow = 0;
+    r->frames = r->frames + 1;
+    r->bytes = r->bytes + (long) length;
+    return length;
+}
+
+/* rendererClear: an empty screen, so the next frame is drawn in full */
+void rendererClear(Renderer *r) {
+    if (r->mode == RENDER_ANSI) {
+        write_frame(r->fd, ANSI_CLEAR, strlen(ANSI_CLEAR));
+    }
+    r->shownValid = 0;
+}
+
+/* screen_renderer: the stdout renderer, set up on first use */
+static Renderer *screen_renderer(void) {
+    if (!screenReady) {
+#ifdef TESTING
+        rendererInit(&screen, STDOUT_FILENO, RENDER_PLAIN);
+#else
+        rendererInit(&screen, STDOUT_FILENO, isatty(STDOUT_FILENO) ? RENDER_ANSI : RENDER_PLAIN);
+#endif
+        screenReady = 1;
+    }
+    return &screen;
+}
+
+void renderScreen(const GameState *game) {
+    rendererDraw(screen_renderer(), game);
+}
+
+void renderScreenReset(void) {
+    rendererInvalidate(screen_renderer());
+}
+
+void renderScreenNoteLine(int width) {
+    rendererNoteLine(screen_renderer(), width);
+}
+
+void clearScreen(void) {
+    rendererClear(screen_renderer());
+}
@@ -0,0 +1,824 @@
+/* result_log.c
+ *
+ * Write-ahead log for finished games.
+ *
+ * FUNCTIONALITY:
+ *  - resultLogAppend: queues a finished game; a commit thread writes every
+ *    game queued since its last sync in one write and makes them durable
+ *    with one fdatasync, then tells each caller
+ *  - an apply thread adds the committed games to the history and
+ *    statistics files (logGames, updateStatsBatch) and records how far it
+ *    got in the log's header
+ *  - resultLogOpen / replayResultLogs: on startup, games a stopped process
+ *    committed but never applied are applied from its log
+ *  - resultLogSync: lets a reader wait for the files to catch up
+ *
+ * A game is acknowledged only once it is in a synced log, so no
+ * acknowledged game is lost if the process or the machine stops. While one
+ * batch is being synced the next one fills up, so under load a single sync
+ * covers as many games as finished meanwhile.
+ *
+ * The header also keeps the sequence of the last game each of the two
+ * files has, moved right after each write, so replay skips what already
+ * reached a file: a batch whose history write worked but whose stats
+ * write failed replays into the statistics only. Once applying fails the
+ * apply thread stops and leaves the rest to the replay. Only a crash
+ * between a write and its mark applies that part again.
+ *
+ * File layout: a 64-byte ResultLogHeader, then 80-byte ResultRecords in
+ * commit order. Each record has a checksum, so a torn write at the end is
+ * recognised and ignored (it was never acknowledged).
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include "../headerFiles/result_log.h"
+#include "../headerFiles/profile.h"
+#include "../headerFiles/data_dir.h"
+#include "../headerFiles/file_io.h"
+
+/* ResultLogHeader: 'applied' is how many bytes of the file (header
+ * included) are already in the history and statistics files;
+ * historySequence / statsSequence the last game each file has */
+typedef struct {
+    char     magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+    uint64_t applied;
+    uint64_t historySequence;
+    uint64_t statsSequence;
+    uint64_t reserved[3];
+} ResultLogHeader;
+
+/* ResultRecord: one finished game */
+typedef struct {
+    uint32_t checksum;      // FNV-1a of the rest of the record
+    uint8_t  guesses;
+    uint8_t  won;
+    uint16_t reserved;
+    uint64_t sequence;      // numbered from 1 in each log
+    int64_t  when;          // when the game ended
+    char     username[MAX_USERNAME];
+    char     word[WORD_MAX_LEN];
+} ResultRecord;
+
+/* ApplyMarks: the header's historySequence and statsSequence */
+typedef struct {
+    uint64_t history;
+    uint64_t stats;
+} ApplyMarks;
+
+/* Waiter: who to tell once a queued game is committed. done == NULL means
+ * a caller blocked in resultLogAppend; context is then its SyncWait. */
+typedef struct {
+    ResultLogDone done;
+    void         *context;
+} Waiter;
+
+typedef struct {
+    int finished;
+    int status;
+} SyncWait;
+
+/* The process's log. 'lock' guards everything but the file itself, which
+ * only the commit thread appends to and only the apply thread's header
+ * updates touch. */
+static struct {
+    int             open;
+    int             fd;
+    char            path[DATA_DIR_MAX + 64];
+    uint64_t        end;             // bytes of the file committed so far
+    uint64_t        applied;         // bytes of the file applied so far
+    int             applyFailed;     // stop applying; keep the log for a later replay
+    ApplyMarks      marks;           // only the apply thread touches these
+
+    ResultRecord   *pending;         // games waiting for the next commit
+    Waiter         *waiters;
+    int             pendingCount;
+    int             pendingCapacity;
+
+    ResultRecord   *unapplied;       // committed, not yet in the files
+    int             unappliedCount;
+    int             unappliedCapacity;
+
+    uint64_t        appended;        // sequence of the last game queued
+    uint64_t        settled;         // every game up to here is applied or failed
+    uint64_t        failedThrough;   // last game whose commit failed
+    int             committing;
+    int             applying;
+    int             stopCommitter;
+    int             stopApplier;
+    long            games;
+    long            commits;
+
+    pthread_mutex_t lock;
+    pthread_cond_t  commitWake;
+    pthread_cond_t  applyWake;
+    pthread_cond_t  progress;        // a batch was committed or applied
+    pthread_t       committer;
+    pthread_t       applier;
+} wal = {
+    .fd         = -1,
+    .lock       = PTHREAD_MUTEX_INITIALIZER,
+    .commitWake = PTHREAD_COND_INITIALIZER,
+    .applyWake  = PTHREAD_COND_INITIALIZER,
+    .progress   = PTHREAD_COND_INITIALIZER
+};
+
+/* Serialises the games written straight to the files while no log is open */
+static pthread_mutex_t directLock = PTHREAD_MUTEX_INITIALIZER;
+
+/* checksum_record: FNV-1a over everything after the checksum field */
+static uint32_t checksum_record(const ResultRecord *record) {
+    const unsigned char *bytes = (const unsigned char *) record + sizeof(record->checksum);
+    size_t length = sizeof(*record) - sizeof(record->checksum);
+    uint32_t h = 2166136261u;
+    size_t i;
+
+    for (i = 0; i < length; i++) {
+        h = (h ^ bytes[i]) * 16777619u;
+    }
+    return h;
+}
+
+/* sync_directory: makes a file created, renamed or removed in the log directory stick */
+static void sync_directory(void) {
+    int fd = open(dataDir(), O_RDONLY | O_DIRECTORY);
+
+    if (fd >= 0) {
+        fsync(fd);
+        close(fd);
+    }
+}
+
+/* mark_header: writes one 64-bit header field and syncs it; returns 0 or 1 on error */
+static int mark_header(int fd, size_t field, uint64_t value) {
+    return writeAt(fd, &value, sizeof(value), (off_t) field) != 0 || fdatasync(fd) != 0;
+}
+
+/* mark_applied: records in the header that the first 'applied' bytes are in the files */
+static int mark_applied(int fd, uint64_t applied) {
+    return mark_header(fd, offsetof(ResultLogHeader, applied), applied);
+}
+
+/* first_after: index of the first of 'count' records past 'sequence' (records are in order) */
+static int first_after(const ResultRecord *records, int count, uint64_t sequence) {
+    int i = 0;
+
+    while (i < count && records[i].sequence <= sequence) {
+        i++;
+    }
+    return i;
+}
+
+/*
+ * apply_records:
+ *   Adds committed games to the history and statistics files, a batch of
+ *   RESULT_LOG_APPLY_MAX at a time. With a log (fd >= 0) each file only
+ *   gets the games past its mark, and the mark is moved in the header as
+ *   soon as the file has them. Without one (fd < 0) marks is not used.
+ *
+ * RETURNS:
+ *   0 on success, 1 at the first write that failed.
+ */
+
+static int apply_records(int fd, ApplyMarks *marks, const ResultRecord *records, int count) {
+    struct GameResult games[RESULT_LOG_APPLY_MAX];
+    StatsUpdate updates[RESULT_LOG_APPLY_MAX];
+    time_t times[RESULT_LOG_APPLY_MAX];
+    int first, i;
+
+    for (first = 0; first < count; first += RESULT_LOG_APPLY_MAX) {
+        int n = count - first < RESULT_LOG_APPLY_MAX ? count - first : RESULT_LOG_APPLY_MAX;
+        uint64_t last;
+
+        for (i = 0; i < n; i++) {
+            const ResultRecord *r = &records[first + i];
+
+            memset(&games[i], 0, sizeof(games[i]));
+            strncpy(games[i].username, r->username, NAME_MAX_LEN - 1);
+            memcpy(games[i].word, r->word, sizeof(games[i].word));
+            games[i].guesses = r->guesses;
+            games[i].won     = r->won;
+            times[i]         = (time_t) r->when;
+
+            updates[i].username   = r->username;
+            updates[i].won        = r->won;
+            updates[i].guessCount = r->guesses;
+            updates[i].timePlayed = (long) r->when;
+        }
+        last = records[first + n - 1].sequence;
+
+        i = fd >= 0 ? first_after(records + first, n, marks->history) : 0;
+        if (i < n) {
+            if (logGames(games + i, times + i, n - i) != 0 ||
+                (fd >= 0 && mark_header(fd, offsetof(ResultLogHeader, historySequence), last) != 0)) {
+                return 1;
+            }
+            if (fd >= 0) {
+                marks->history = last;
+            }
+        }
+
+        i = fd >= 0 ? first_after(records + first, n, marks->stats) : 0;
+        if (i < n) {
+            if (updateStatsBatch(updates + i, n - i) != 0 ||
+                (fd >= 0 && mark_header(fd, offsetof(ResultLogHeader, statsSequence), last) != 0)) {
+                return 1;
+            }
+            if (fd >= 0) {
+                marks->stats = last;
+            }
+        }
+    }
+    return 0;
+}
+
+/* settle: every game up to 'sequence' is now applied (or will never be) */
+static void settle(uint64_t sequence) {
+    if (sequence > wal.settled) {
+        wal.settled = sequence;
+    }
+}
+
+/* grow_pending: makes room for one more queued game (and its waiter); returns 0 or 1 */
+static int grow_pending(void) {
+    int wanted = wal.pendingCapacity > 0 ? wal.pendingCapacity * 2 : 256;
+    ResultRecord *records;
+    Waiter *waiters;
+
+    if (wal.pendingCount < wal.pendingCapacity) {
+        return 0;
+    }
+    records = realloc(wal.pending, sizeof(ResultRecord) * (size_t) wanted);
+    if (records == NULL) {
+        return 1;
+    }
+    wal.pending = records;
+    waiters = realloc(wal.waiters, sizeof(Waiter) * (size_t) wanted);
+    if (waiters == NULL) {
+        return 1;
+    }
+    wal.waiters = waiters;
+    wal.pendingCapacity = wanted;
+    return 0;
+}
+
+/* grow_unapplied: makes room for 'count' more committed games; returns 0 or 1 */
+static int grow_unapplied(int count) {
+    int wanted = wal.unappliedCapacity > 0 ? wal.unappliedCapacity : 256;
+    ResultRecord *records;
+
+    if (wal.unappliedCount + count <= wal.unappliedCapacity) {
+        return 0;
+    }
+    while (wanted < wal.unappliedCount + count) {
+        wanted = wanted * 2;
+    }
+    records = realloc(wal.unapplied, sizeof(ResultRecord) * (size_t) wanted);
+    if (records == NULL) {
+        return 1;
+    }
+    wal.unapplied = records;
+    wal.unappliedCapacity = wanted;
+    return 0;
+}
+
+/*
+ * commit_main:
+ *   The commit thread. Takes every queued game, appends them with one
+ *   write, syncs once, then wakes or calls back everyone in the batch.
+ */
+
+static void *commit_main(void *arg) {
+    ResultRecord *batch = NULL;
+    Waiter *waiters = NULL;
+    int capacity = 0;
+
+    (void) arg;
+    pthread_mutex_lock(&wal.lock);
+
+    for (;;) {
+        size_t bytes;
+        int count, failed, i;
+
+        while (wal.pendingCount == 0 && !wal.stopCommitter) {
+            pthread_cond_wait(&wal.commitWake, &wal.lock);
+        }
+        if (wal.pendingCount == 0) {
+            break;
+        }
+
+        // Swap queues: games finishing during the sync form the next batch
+        {
+            ResultRecord *records = wal.pending;
+            Waiter *who = wal.waiters;
+            int size = wal.pendingCapacity;
+
+            wal.pending = batch;
+            wal.waiters = waiters;
+            wal.pendingCapacity = capacity;
+            batch = records;
+            waiters = who;
+            capacity = size;
+        }
+        count = wal.pendingCount;
+        wal.pendingCount = 0;
+        wal.committing = 1;
+        pthread_mutex_unlock(&wal.lock);
+
+        bytes = sizeof(ResultRecord) * (size_t) count;
+        {
+            PROFILE_SCOPE(PROFILE_RESULT_COMMIT);
+            failed = (writeAt(wal.fd, batch, bytes, (off_t) wal.end) != 0 || fdatasync(wal.fd) != 0);
+        }
+        if (failed && ftruncate(wal.fd, (off_t) wal.end) != 0) {
+            // Whatever made it to disk fails its checksum or sits past a
+            // shorter, valid tail; nobody was told it was saved either way
+        }
+
+        pthread_mutex_lock(&wal.lock);
+        wal.committing = 0;
+        if (!failed) {
+            wal.end = wal.end + bytes;
+            wal.games = wal.games + count;
+            wal.commits = wal.commits + 1;
+            if (grow_unapplied(count) == 0) {
+                memcpy(wal.unapplied + wal.unappliedCount, batch, bytes);
+                wal.unappliedCount = wal.unappliedCount + count;
+                pthread_cond_signal(&wal.applyWake);
+            } else {
+                // Safe in the log: the next start applies them
+                wal.applyFailed = 1;
+                settle(batch[count - 1].sequence);
+            }
+        } else {
+            wal.failedThrough = batch[count - 1].sequence;
+            if (wal.unappliedCount == 0 && !wal.applying) {
+                settle(wal.failedThrough);
+            }
+        }
+
+        for (i = 0; i < count; i++) {
+            if (waiters[i].done == NULL) {
+                SyncWait *wait = waiters[i].context;
+
+                wait->finished = 1;
+                wait->status = failed;
+            }
+        }
+        pthread_cond_broadcast(&wal.progress);
+        pthread_mutex_unlock(&wal.lock);
+
+        for (i = 0; i < count; i++) {
+            if (waiters[i].done != NULL) {
+                waiters[i].done(waiters[i].context, failed);
+            }
+        }
+        pthread_mutex_lock(&wal.lock);
+    }
+
+    pthread_mutex_unlock(&wal.lock);
+    free(batch);
+    free(waiters);
+    return NULL;
+}
+
+/*
+ * compact:
+ *   Empties a fully applied log once it has grown large. Called with the
+ *   lock held while no commit is in progress. The file is cut before the
+ *   header is reset, so a crash in between never replays old games.
+ */
+
+static void compact(void) {
+    if (wal.applyFailed || wal.committing || wal.pendingCount > 0 ||
+        wal.applied != wal.end || wal.end < (uint64_t) RESULT_LOG_COMPACT_BYTES) {
+        return;
+    }
+    if (ftruncate(wal.fd, (off_t) sizeof(ResultLogHeader)) == 0 &&
+        mark_applied(wal.fd, sizeof(ResultLogHeader)) == 0) {
+        wal.end = sizeof(ResultLogHeader);
+        wal.applied = sizeof(ResultLogHeader);
+    }
+}
+
+/*
+ * apply_main:
+ *   The apply thread. Adds committed games to the files in commit order,
+ *   then moves the header's applied mark past them.
+ */
+
+static void *apply_main(void *arg) {
+    ResultRecord *batch = NULL;
+    int capacity = 0;
+
+    (void) arg;
+    pthread_mutex_lock(&wal.lock);
+
+    for (;;) {
+        uint64_t applied;
+        int count, failed;
+
+        while (wal.unappliedCount == 0 && !wal.stopApplier) {
+            pthread_cond_wait(&wal.applyWake, &wal.lock);
+        }
+        if (wal.unappliedCount == 0) {
+            break;
+        }
+
+        {
+            ResultRecord *records = wal.unapplied;
+            int size = wal.unappliedCapacity;
+
+            wal.unapplied = batch;
+            wal.unappliedCapacity = capacity;
+            batch = records;
+            capacity = size;
+        }
+        count = wal.unappliedCount;
+        wal.unappliedCount = 0;
+        wal.applying = 1;
+        applied = wal.applied + sizeof(ResultRecord) * (uint64_t) count;
+        failed = wal.applyFailed;
+        pthread_mutex_unlock(&wal.lock);
+
+        // After a failure nothing more is applied: the applied mark stays
+        // put and the next start replays the rest past the file marks
+        if (!failed) {
+            failed = apply_records(wal.fd, &wal.marks, batch, count);
+            if (failed) {
+                fprintf(stderr, "Warning: could not update the history or statistics files; "
+                                "the games stay in the result log for the next start\n");
+            }
+        }
+        if (!failed) {
+            failed = mark_applied(wal.fd, applied);
+        }
+
+        pthread_mutex_lock(&wal.lock);
+        wal.applyFailed = wal.applyFailed || failed;
+        wal.applying = 0;
+        wal.applied = applied;
+        settle(batch[count - 1].sequence);
+        if (wal.unappliedCount == 0) {
+            settle(wal.failedThrough);
+        }
+        compact();
+        pthread_cond_broadcast(&wal.progress);
+    }
+
+    pthread_mutex_unlock(&wal.lock);
+    free(batch);
+    return NULL;
+}
+
+/*
+ * replay_log:
+ *   Applies what one stopped process's log still holds and removes it.
+ *   The owner of a log keeps it locked, so a log that cannot be locked
+ *   belongs to a running process and is skipped.
+ *
+ * RETURNS:
+ *   The number of games replayed.
+ */
+
+static long replay_log(const char *path) {
+    ResultRecord records[RESULT_LOG_APPLY_MAX];
+    ResultLogHeader header;
+    ApplyMarks marks;
+    struct stat held, named;
+    uint64_t offset;
+    long replayed = 0;
+    int failed = 0;
+    int fd = open(path, O_RDWR | O_CLOEXEC);
+
+    if (fd < 0) {
+        return 0;
+    }
+    if (flock(fd, LOCK_EX | LOCK_NB) != 0) {
+        close(fd);
+        return 0;
+    }
+
+    // Another process may have replayed and removed it while we opened it
+    if (fstat(fd, &held) != 0 || stat(path, &named) != 0 ||
+        held.st_dev != named.st_dev || held.st_ino != named.st_ino) {
+        close(fd);
+        return 0;
+    }
+
+    if (pread(fd, &header, sizeof(header), 0) != (ssize_t) sizeof(header) ||
+        memcmp(header.magic, RESULT_LOG_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != RESULT_LOG_VERSION || header.recordSize != sizeof(ResultRecord)) {
+        fprintf(stderr, "Warning: %s is not a result log; left in place\n", path);
+        close(fd);
+        return 0;
+    }
+
+    marks.history = header.historySequence;
+    marks.stats = header.statsSequence;
+    offset = header.applied;
+    while (!failed) {
+        ssize_t got = pread(fd, records, sizeof(records), (off_t) offset);
+        int count = got > 0 ? (int) ((size_t) got / sizeof(ResultRecord)) : 0;
+        int valid = 0;
+
+        // Stop at the first torn record: nothing after it was acknowledged
+        while (valid < count && records[valid].checksum == checksum_record(&records[valid])) {
+            valid++;
+        }
+        if (valid == 0) {
+            break;
+        }
+
+        failed = apply_records(fd, &marks, records, valid);
+        if (!failed) {
+            offset = offset + sizeof(ResultRecord) * (uint64_t) valid;
+            failed = mark_applied(fd, offset);
+            replayed = replayed + valid;
+        }
+        if (valid < count) {
+            break;
+        }
+    }
+
+    if (!failed) {
+        unlink(path);
+        sync_directory();
+    }
+    close(fd);
+    return replayed;
+}
+
+/*
+ * replayResultLogs:
+ *   Looks for results.<pid>.wal files other than this process's own.
+ *
+ * RETURNS:
+ *   The number of games replayed.
+ */
+
+long replayResultLogs(void) {
+    size_t prefix = strlen(RESULT_LOG_PREFIX);
+    size_t suffix = strlen(RESULT_LOG_SUFFIX);
+    struct dirent *entry;
+    long replayed = 0;
+    DIR *dir = opendir(dataDir());
+
+    if (dir == NULL) {
+        return 0;
+    }
+    while ((entry = readdir(dir)) != NULL) {
+        size_t length = strlen(entry->d_name);
+        char path[DATA_DIR_MAX + 256];
+
+        if (length <= prefix + suffix ||
+            strncmp(entry->d_name, RESULT_LOG_PREFIX, prefix) != 0 ||
+            strcmp(entry->d_name + length - suffix, RESULT_LOG_SUFFIX) != 0) {
+            continue;
+        }
+        snprintf(path, sizeof(path), "%s/%s", dataDir(), entry->d_name);
+        if (wal.open && strcmp(path, wal.path) == 0) {
+            continue;
+        }
+        replayed = replayed + replay_log(path);
+    }
+    closedir(dir);
+    return replayed;
+}
+
+/*
+ * resultLogOpen:
+ *   The new log is written and locked under a temporary name and only
+ *   then renamed into place, so a replaying process never mistakes it for
+ *   the log of a stopped one.
+ *
+ * RETURNS:
+ *   0 on success, 1 on failure.
+ */
+
+int resultLogOpen(void) {
+    static int registered = 0;
+    ResultLogHeader header;
+    char temporary[sizeof(wal.path) + 4];
+    int fd, started;
+
+    if (wal.open) {
+        return 0;
+    }
+
+    // A process with our pid may have left a log behind: it goes first
+    replayResultLogs();
+
+    snprintf(wal.path, sizeof(wal.path), "%s/%s%ld%s", dataDir(), RESULT_LOG_PREFIX,
+             (long) getpid(), RESULT_LOG_SUFFIX);
+    snprintf(temporary, sizeof(temporary), "%s.tmp", wal.path);
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, RESULT_LOG_MAGIC, sizeof(header.magic));
+    header.version    = RESULT_LOG_VERSION;
+    header.recordSize = sizeof(ResultRecord);
+    header.applied    = sizeof(header);
+
+    fd = open(temporary, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0 || flock(fd, LOCK_EX) != 0 ||
+        writeAt(fd, &header, sizeof(header), 0) != 0 || fdatasync(fd) != 0 ||
+        rename(temporary, wal.path) != 0) {
+        fprintf(stderr, "Error: cannot create %s: %s\n", wal.path, strerror(errno));
+        if (fd >= 0) {
+            close(fd);
+        }
+        unlink(temporary);
+        return 1;
+    }
+    sync_directory();
+
+    pthread_mutex_lock(&wal.lock);
+    wal.fd            = fd;
+    wal.end           = sizeof(header);
+    wal.applied       = sizeof(header);
+    wal.applyFailed   = 0;
+    wal.marks.history = 0;
+    wal.marks.stats   = 0;
+    wal.appended      = 0;
+    wal.settled       = 0;
+    wal.failedThrough = 0;
+    wal.stopCommitter = 0;
+    wal.stopApplier   = 0;
+    wal.games         = 0;
+    wal.commits       = 0;
+    pthread_mutex_unlock(&wal.lock);
+
+    // Open only once both threads run, so nobody waits on a missing one
+    started = (pthread_create(&wal.committer, NULL, commit_main, NULL) == 0);
+    if (started && pthread_create(&wal.applier, NULL, apply_main, NULL) != 0) {
+        pthread_mutex_lock(&wal.lock);
+        wal.stopCommitter = 1;
+        pthread_cond_signal(&wal.commitWake);
+        pthread_mutex_unlock(&wal.lock);
+        pthread_join(wal.committer, NULL);
+        started = 0;
+    }
+    if (!started) {
+        fprintf(stderr, "Error: cannot start the result log threads\n");
+        pthread_mutex_lock(&wal.lock);
+        wal.fd = -1;
+        pthread_mutex_unlock(&wal.lock);
+        close(fd);
+        unlink(wal.path);
+        sync_directory();
+        return 1;
+    }
+    pthread_mutex_lock(&wal.lock);
+    wal.open = 1;
+    pthread_mutex_unlock(&wal.lock);
+
+    if (!registered) {
+        atexit(resultLogClose);
+        registered = 1;
+    }
+    return 0;
+}
+
+/*
+ * resultLogAppend:
+ *   Queues one game for the commit thread.
+ *
+ * RETURNS:
+ *   0 once committed (or queued, with a callback), 1 on failure.
+ */
+
+int resultLogAppend(const char *username, const char *word, int guesses, int won, time_t when,
+                    ResultLogDone done, void *context) {
+    ResultRecord record;
+    SyncWait wait = { 0, 0 };
+    int status = 0;
+
+    memset(&record, 0, sizeof(record));
+    snprintf(record.username, sizeof(record.username), "%s", username);
+    snprintf(record.word, sizeof(record.word), "%s", word);
+    record.guesses = (uint8_t) guesses;
+    record.won     = (uint8_t) (won != 0);
+    record.when    = (int64_t) when;
+
+    pthread_mutex_lock(&wal.lock);
+
+    if (!wal.open) {
+        // No log: straight to the files, like before there was one, one
+        // caller at a time as the apply thread would
+        pthread_mutex_unlock(&wal.lock);
+        pthread_mutex_lock(&directLock);
+        status = apply_records(-1, NULL, &record, 1);
+        pthread_mutex_unlock(&directLock);
+        if (done != NULL) {
+            done(context, status);
+            return 0;
+        }
+        return status;
+    }
+
+    if (grow_pending() != 0) {
+        pthread_mutex_unlock(&wal.lock);
+        if (done != NULL) {
+            done(context, 1);
+            return 0;
+        }
+        return 1;
+    }
+
+    wal.appended = wal.appended + 1;
+    record.sequence = wal.appended;
+    record.checksum = checksum_record(&record);
+
+    wal.pending[wal.pendingCount] = record;
+    wal.waiters[wal.pendingCount].done = done;
+    wal.waiters[wal.pendingCount].context = done != NULL ? context : &wait;
+    wal.pendingCount = wal.pendingCount + 1;
+    pthread_cond_signal(&wal.commitWake);
+
+    if (done == NULL) {
+        while (!wait.finished) {
+            pthread_cond_wait(&wal.progress, &wal.lock);
+        }
+        status = wait.status;
+    }
+    pthread_mutex_unlock(&wal.lock);
+    return status;
+}
+
+/* resultLogSync: waits for the apply thread to catch up with the games queued so far */
+void resultLogSync(void) {
+    uint64_t target;
+
+    pthread_mutex_lock(&wal.lock);
+    target = wal.appended;
+    while (wal.open && wal.settled < target) {
+        pthread_cond_wait(&wal.progress, &wal.lock);
+    }
+    pthread_mutex_unlock(&wal.lock);
+}
+
+/*
+ * resultLogClose:
+ *   Stops the commit thread once the queue is empty, then the apply
+ *   thread once everything committed is applied. The log is removed
+ *   unless applying failed, in which case the next start replays it.
+ */
+
+void resultLogClose(void) {
+    pthread_mutex_lock(&wal.lock);
+    if (!wal.open) {
+        pthread_mutex_unlock(&wal.lock);
+        return;
+    }
+    wal.stopCommitter = 1;
+    pthread_cond_signal(&wal.commitWake);
+    pthread_mutex_unlock(&wal.lock);
+    pthread_join(wal.committer, NULL);
+
+    pthread_mutex_lock(&wal.lock);
+    wal.stopApplier = 1;
+    pthread_cond_signal(&wal.applyWake);
+    pthread_mutex_unlock(&wal.lock);
+    pthread_join(wal.applier, NULL);
+
+    pthread_mutex_lock(&wal.lock);
+    if (!wal.applyFailed) {
+        unlink(wal.path);
+        sync_directory();
+    }
+    close(wal.fd);
+    wal.fd = -1;
+    wal.open = 0;
+
+    free(wal.pending);
+    free(wal.waiters);
+    free(wal.unapplied);
+    wal.pending = NULL;
+    wal.waiters = NULL;
+    wal.unapplied = NULL;
+    wal.pendingCapacity = 0;
+    wal.unappliedCapacity = 0;
+    pthread_cond_broadcast(&wal.progress);
+    pthread_mutex_unlock(&wal.lock);
+}
+
+/* resultLogCounters: games committed and syncs taken since resultLogOpen */
+void resultLogCounters(long *games, long *commits) {
+    pthread_mutex_lock(&wal.lock);
+    *games = wal.games;
+    *commits = wal.commits;
+    pthread_mutex_unlock(&wal.lock);
+}
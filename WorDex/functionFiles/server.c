@@ -0,0 +1,1421 @@
+/* server.c
+ *
+ * Multi-session game server for the Wordex game (wordexd).
+ *
+ * FUNCTIONALITY:
+ *  - parseServerArgs: reads the listening address, thread counts and limits
+ *  - runServer: accepts connections on a TCP or Unix socket and runs every
+ *    player's session in non-blocking epoll event loops, speaking the line
+ *    protocol described in server.h
+ *
+ * Each event loop thread owns its sessions: the connection, login state,
+ * the GameState of the round being played and the pending input and output
+ * bytes, so no session state lives in globals. With TCP every loop has its
+ * own listening socket bound with SO_REUSEPORT and the kernel spreads new
+ * connections over them; a Unix socket is shared, woken with EPOLLEXCLUSIVE.
+ *
+ * Nothing slow runs on a loop thread: password hashing (PBKDF2 takes tens
+ * of milliseconds on purpose), hints and the STATS, LEADERBOARD and
+ * HISTORY queries (which wait for the result log, then read the files) go
+ * to a pool of worker threads, and the finished job is handed back to its
+ * loop through an eventfd. While a session waits for a job it reads no
+ * further commands, so replies always come back in order. Games,
+ * statistics, the leaderboard and the history use the same modules as the
+ * terminal game. A finished game goes to the
+ * result log, which syncs every game finished meanwhile at once; its GUESS
+ * reply is sent when the log says the game is on disk, the same way as a
+ * worker's job comes back.
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#define _GNU_SOURCE     // accept4
+#include <string.h>
+#include <strings.h>
+#include <limits.h>
+#include <errno.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include "../headerFiles/server.h"
+#include "../headerFiles/authentication.h"
+#include "../headerFiles/account_store.h"
+#include "../headerFiles/kdf.h"
+#include "../headerFiles/game_logic.h"
+#include "../headerFiles/hint.h"
+#include "../headerFiles/history.h"
+#include "../headerFiles/leaderboard.h"
+#include "../headerFiles/result_log.h"
+#include "../headerFiles/profile.h"
+#include "../headerFiles/statistics.h"
+#include "../headerFiles/data_dir.h"
+#include "../headerFiles/random.h"
+
+/* Events handled per epoll_wait, and how often loops look for a shutdown */
+#define SERVER_EVENTS       256
+#define SERVER_TICK_MS      500
+
+/* Longest username the server accepts (history.txt keeps names this short) */
+#define SERVER_NAME_MAX     (NAME_MAX_LEN - 1)
+
+/* Session states */
+enum {
+    SESSION_GUEST,       // connected, not logged in
+    SESSION_WAITING,     // a job is running for it on a worker thread
+    SESSION_PLAYER       // logged in
+};
+
+/* Work done off the event loops */
+enum {
+    JOB_LOGIN,           // verify a password (and re-hash it if outdated)
+    JOB_REGISTER,        // hash a new account's password
+    JOB_HINT,            // best next guess for a game in progress
+    JOB_RESULT,          // a finished game, waiting for the result log
+    JOB_STATS,           // the player's statistics
+    JOB_LEADERBOARD,     // the top 'limit' players
+    JOB_HISTORY          // 'limit' games from 'offset', newest first
+};
+
+/* Session:
+ *   One connection and everything the game needs to know about it.
+ */
+struct Session {
+    int       fd;
+    uint64_t  id;                   // unique for the server's lifetime
+    int       state;
+    int       stateAfterJob;        // state to return to if a job fails
+    int       closing;              // close once the output is flushed
+    uint32_t  events;               // epoll events currently registered
+    char      username[MAX_USERNAME];
+    int       playing;
+    GameState game;
+
+    char      in[SERVER_LINE_MAX];  // bytes received, not yet a full command
+    size_t    inLength;
+    char     *out;                  // replies not yet written to the socket
+    size_t    outLength;
+    size_t    outSent;
+    size_t    outCapacity;
+};
+
+struct EventLoop;
+
+/* Job:
+ *   A request for a worker thread and, once run, its result.
+ */
+struct Job {
+    int               type;
+    struct EventLoop *loop;
+    int               fd;
+    uint64_t          sessionId;
+    char              username[MAX_USERNAME];
+    char              password[SERVER_LINE_MAX];
+    char              stored[KDF_HASH_MAX];   // JOB_LOGIN: the account's hash
+    GameState         game;                   // JOB_HINT: the game so far, JOB_RESULT: the game
+    char              pattern[6];             // JOB_RESULT: the last guess's feedback
+    long              limit;                  // JOB_LEADERBOARD, JOB_HISTORY: rows wanted
+    long              offset;                 // JOB_HISTORY: newest games skipped
+
+    int               failed;
+    char              hash[KDF_HASH_MAX];     // new hash to store, or ""
+    Hint              hint;
+    Stats             stats;                  // JOB_STATS: zero if the player has none
+    struct LeaderboardEntry *leaders;         // JOB_LEADERBOARD: 'rows' entries
+    struct GameResult *games;                 // JOB_HISTORY: 'rows' games
+    long              rows;
+    struct Job       *next;
+};
+
+/* EventLoop:
+ *   One epoll loop thread and the sessions it owns (indexed by fd).
+ */
+struct EventLoop {
+    int               id;
+    int               epollFd;
+    int               listenFd;
+    int               ownsListenFd;
+    int               wakeFd;               // eventfd: finished jobs are waiting
+    struct Session  **sessions;
+    int               sessionSlots;
+    AccountStore      accounts;
+    int               accountsOpen;
+    uint64_t          rng;
+    pthread_mutex_t   doneLock;
+    struct Job       *done;                 // finished jobs, newest first
+    pthread_t         thread;
+};
+
+/* Shared by all loops and workers */
+static const ServerOptions *serverOptions;
+static const Dictionary *dictionary;
+static volatile sig_atomic_t stopRequested = 0;
+static long sessionCount = 0;
+static uint64_t nextSessionId = 1;
+
+static pthread_mutex_t jobLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t jobReady = PTHREAD_COND_INITIALIZER;
+static struct Job *jobHead = NULL;
+static struct Job *jobTail = NULL;
+static int workersStopping = 0;
+
+/* Serialises reads of the history, statistics and leaderboard files */
+static pthread_mutex_t dataLock = PTHREAD_MUTEX_INITIALIZER;
+
+/* on_signal: SIGINT / SIGTERM ask every loop to stop */
+static void on_signal(int signal) {
+    (void) signal;
+    stopRequested = 1;
+}
+
+/* ---------------------------------------------------------------------
+ * Worker threads
+ * ------------------------------------------------------------------- */
+
+/*
+ * run_query:
+ *   STATS, LEADERBOARD and HISTORY: waits for games still on their way
+ *   from the result log, then reads the files.
+ */
+
+static void run_query(struct Job *job) {
+    resultLogSync();
+    pthread_mutex_lock(&dataLock);
+
+    if (job->type == JOB_STATS) {
+        if (loadStats(job->username, &job->stats) != 0) {
+            memset(&job->stats, 0, sizeof(job->stats));
+        }
+    } else if (job->type == JOB_LEADERBOARD) {
+        job->rows = ReadLeaderboardTop((int) job->limit, &job->leaders);
+        job->failed = (job->rows < 0);
+    } else {
+        job->games = malloc(sizeof(struct GameResult) * (size_t) job->limit);
+        job->failed = (job->games == NULL);
+        if (!job->failed) {
+            job->rows = ReadHistoryPage(job->offset, job->limit, job->games);
+        }
+    }
+
+    pthread_mutex_unlock(&dataLock);
+}
+
+/*
+ * run_job:
+ *   The slow part of a job, on a worker thread. Touches only the job.
+ */
+
+static void run_job(struct Job *job) {
+    job->hash[0] = '\0';
+
+    if (job->type == JOB_STATS || job->type == JOB_LEADERBOARD || job->type == JOB_HISTORY) {
+        run_query(job);
+    } else if (job->type == JOB_LOGIN) {
+        job->failed = (verifyPassword(job->password, job->stored) != 0);
+        if (!job->failed && kdfNeedsUpgrade(job->stored) &&
+            hashPassword(job->password, job->hash) != 0) {
+            job->hash[0] = '\0';
+        }
+    } else if (job->type == JOB_REGISTER) {
+        job->failed = (hashPassword(job->password, job->hash) != 0);
+    } else {
+        job->failed = (bestGuess(dictionary, &job->game, 1, &job->hint) != 0);
+    }
+
+    // The plain-text password is not needed any more
+    memset(job->password, 0, sizeof(job->password));
+}
+
+/* job_done: hands a finished job back to the loop that owns its session */
+static void job_done(struct Job *job) {
+    struct EventLoop *loop = job->loop;   // the job may be freed as soon as it is listed
+    uint64_t one = 1;
+
+    pthread_mutex_lock(&loop->doneLock);
+    job->next = loop->done;
+    loop->done = job;
+    pthread_mutex_unlock(&loop->doneLock);
+
+    if (write(loop->wakeFd, &one, sizeof(one)) != sizeof(one)) {
+        // The counter is already non-zero: the loop will look anyway
+    }
+}
+
+/* result_committed: the result log's callback for a JOB_RESULT */
+static void result_committed(void *context, int status) {
+    struct Job *job = context;
+
+    job->failed = status;
+    job_done(job);
+}
+
+/*
+ * worker_main:
+ *   Runs queued jobs and hands each back to the loop that owns its session.
+ */
+
+static void *worker_main(void *arg) {
+    (void) arg;
+
+    for (;;) {
+        struct Job *job;
+
+        pthread_mutex_lock(&jobLock);
+        while (jobHead == NULL && !workersStopping) {
+            pthread_cond_wait(&jobReady, &jobLock);
+        }
+        if (jobHead == NULL) {
+            pthread_mutex_unlock(&jobLock);
+            return NULL;
+        }
+        job = jobHead;
+        jobHead = job->next;
+        if (jobHead == NULL) {
+            jobTail = NULL;
+        }
+        pthread_mutex_unlock(&jobLock);
+
+        run_job(job);
+        job_done(job);
+    }
+}
+
+/* free_job: a job and the rows it read */
+static void free_job(struct Job *job) {
+    free(job->leaders);
+    free(job->games);
+    free(job);
+}
+
+/* submit_job: queues a job for the workers */
+static void submit_job(struct Job *job) {
+    job->next = NULL;
+
+    pthread_mutex_lock(&jobLock);
+    if (jobTail != NULL) {
+        jobTail->next = job;
+    } else {
+        jobHead = job;
+    }
+    jobTail = job;
+    pthread_cond_signal(&jobReady);
+    pthread_mutex_unlock(&jobLock);
+}
+
+/* ---------------------------------------------------------------------
+ * Sessions
+ * ------------------------------------------------------------------- */
+
+/*
+ * reply:
+ *   Appends a formatted line to the session's output buffer.
+ */
+
+static void reply(struct Session *s, const char *format, ...) {
+    va_list args;
+    int length;
+
+    for (;;) {
+        size_t room = s->outCapacity - s->outLength;
+
+        va_start(args, format);
+        length = vsnprintf(s->out + s->outLength, room, format, args);
+        va_end(args);
+
+        if (length < 0) {
+            return;
+        }
+        if ((size_t) length < room) {
+            s->outLength = s->outLength + (size_t) length;
+            return;
+        }
+
+        {
+            size_t capacity = s->outCapacity > 0 ? s->outCapacity * 2 : 1024;
+            char *grown;
+
+            while (capacity - s->outLength <= (size_t) length) {
+                capacity = capacity * 2;
+            }
+            grown = realloc(s->out, capacity);
+            if (grown == NULL) {
+                s->closing = 1;
+                return;
+            }
+            s->out = grown;
+            s->outCapacity = capacity;
+        }
+    }
+}
+
+/*
+ * update_events:
+ *   Registers the events the session needs now: input unless it is waiting
+ *   for a job or closing, output while replies are pending.
+ */
+
+static void update_events(struct EventLoop *loop, struct Session *s) {
+    struct epoll_event ev;
+    uint32_t events = 0;
+
+    if (s->state != SESSION_WAITING && !s->closing) {
+        events |= EPOLLIN;
+    }
+    if (s->outSent < s->outLength) {
+        events |= EPOLLOUT;
+    }
+    if (events == s->events) {
+        return;
+    }
+
+    ev.events = events;
+    ev.data.fd = s->fd;
+    epoll_ctl(loop->epollFd, EPOLL_CTL_MOD, s->fd, &ev);
+    s->events = events;
+}
+
+/* close_session: forgets the session; jobs still running for it are dropped */
+static void close_session(struct EventLoop *loop, struct Session *s) {
+    epoll_ctl(loop->epollFd, EPOLL_CTL_DEL, s->fd, NULL);
+    close(s->fd);
+    loop->sessions[s->fd] = NULL;
+    free(s->out);
+    free(s);
+    __atomic_sub_fetch(&sessionCount, 1, __ATOMIC_RELAXED);
+}
+
+/*
+ * flush_output:
+ *   Writes as much pending output as the socket takes.
+ *
+ * RETURNS:
+ *   0 if the session is still open, 1 if it was closed.
+ */
+
+static int flush_output(struct EventLoop *loop, struct Session *s) {
+    while (s->outSent < s->outLength) {
+        ssize_t n = send(s->fd, s->out + s->outSent, s->outLength - s->outSent, MSG_NOSIGNAL);
+
+        if (n > 0) {
+            s->outSent = s->outSent + (size_t) n;
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            update_events(loop, s);
+            return 0;
+        } else {
+            close_session(loop, s);
+            return 1;
+        }
+    }
+
+    s->outSent = 0;
+    s->outLength = 0;
+    if (s->closing) {
+        close_session(loop, s);
+        return 1;
+    }
+    update_events(loop, s);
+    return 0;
+}
+
+/* ---------------------------------------------------------------------
+ * Commands
+ * ------------------------------------------------------------------- */
+
+/* valid_username: 1 to SERVER_NAME_MAX letters, digits, '_', '-' or '.' */
+static int valid_username(const char *name) {
+    size_t length = strlen(name);
+    size_t i;
+
+    if (length == 0 || length > SERVER_NAME_MAX) {
+        return 0;
+    }
+    for (i = 0; i < length; i++) {
+        if (!isalnum((unsigned char) name[i]) && name[i] != '_' && name[i] != '-' && name[i] != '.') {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* parse_count: a number in 1..SERVER_ROWS_MAX, or 'fallback' if absent */
+static int parse_count(const char *text, int fallback, int *count) {
+    char *end;
+    long value;
+
+    if (text == NULL) {
+        *count = fallback;
+        return 0;
+    }
+    value = strtol(text, &end, 10);
+    if (*end != '\0' || value < 1 || value > SERVER_ROWS_MAX) {
+        return 1;
+    }
+    *count = (int) value;
+    return 0;
+}
+
+/*
+ * new_job:
+ *   A job for session s. Returns NULL (after replying) if memory ran out.
+ */
+
+static struct Job *new_job(struct EventLoop *loop, struct Session *s, int type) {
+    struct Job *job = calloc(1, sizeof(struct Job));
+
+    if (job == NULL) {
+        reply(s, "ERR server busy\n");
+        return NULL;
+    }
+    job->type = type;
+    job->loop = loop;
+    job->fd = s->fd;
+    job->sessionId = s->id;
+    return job;
+}
+
+/*
+ * start_job:
+ *   Hands a login, registration or hint to the workers. The session reads
+ *   no more commands until the job comes back.
+ */
+
+static void start_job(struct EventLoop *loop, struct Session *s, int type, const char *username,
+                      const char *password, const char *stored) {
+    struct Job *job = new_job(loop, s, type);
+
+    if (job == NULL) {
+        return;
+    }
+
+    if (username != NULL) {
+        snprintf(job->username, sizeof(job->username), "%s", username);
+    }
+    if (password != NULL) {
+        snprintf(job->password, sizeof(job->password), "%s", password);
+    }
+    if (stored != NULL) {
+        snprintf(job->stored, sizeof(job->stored), "%s", stored);
+    }
+    if (type == JOB_HINT) {
+        job->game = s->game;
+    }
+
+    s->stateAfterJob = s->state;
+    s->state = SESSION_WAITING;
+    submit_job(job);
+}
+
+/* command_login: LOGIN user password */
+static void command_login(struct EventLoop *loop, struct Session *s, char **args, int count) {
+    char stored[ACCOUNT_HASH_MAX];
+
+    if (s->state == SESSION_PLAYER) {
+        reply(s, "ERR already logged in\n");
+    } else if (count != 3) {
+        reply(s, "ERR usage: LOGIN user password\n");
+    } else if (!loop->accountsOpen || accountStoreFind(&loop->accounts, args[1], stored) != 0) {
+        reply(s, "ERR unknown user\n");
+    } else {
+        start_job(loop, s, JOB_LOGIN, args[1], args[2], stored);
+    }
+}
+
+/* command_register: REGISTER user password */
+static void command_register(struct EventLoop *loop, struct Session *s, char **args, int count) {
+    const char *problem;
+
+    if (s->state == SESSION_PLAYER) {
+        reply(s, "ERR already logged in\n");
+    } else if (count != 3) {
+        reply(s, "ERR usage: REGISTER user password\n");
+    } else if (!valid_username(args[1])) {
+        reply(s, "ERR usernames are 1-%d letters, digits, '_', '-' or '.'\n", SERVER_NAME_MAX);
+    } else if ((problem = passwordProblem(args[2])) != NULL) {
+        reply(s, "ERR %s\n", problem);
+    } else if (!loop->accountsOpen || accountStoreFind(&loop->accounts, args[1], NULL) == 0) {
+        reply(s, "ERR username taken\n");
+    } else {
+        start_job(loop, s, JOB_REGISTER, args[1], args[2], NULL);
+    }
+}
+
+/* command_new: NEW starts a round with a random answer */
+static void command_new(struct EventLoop *loop, struct Session *s) {
+    TRACE_SCOPE("NEW");
+    char answer[6];
+
+    if (s->playing) {
+        reply(s, "ERR finish the current game first\n");
+        return;
+    }
+    dictionaryWordAt(dictionary, (int) (nextRandom(&loop->rng) % (uint64_t) dictionary->count), answer);
+    gameStateInit(&s->game, answer);
+    s->playing = 1;
+    reply(s, "OK new %d\n", MAX_GUESSES);
+}
+
+/* command_guess: GUESS word scores one guess and records finished games */
+static void command_guess(struct EventLoop *loop, struct Session *s, char **args, int count) {
+    TRACE_SCOPE("GUESS");
+    struct Job *job;
+    char word[6];
+    char pattern[6];
+    uint8_t code;
+    int i;
+
+    if (!s->playing) {
+        reply(s, "ERR no game in progress, send NEW\n");
+        return;
+    }
+    if (count != 2 || strlen(args[1]) != 5) {
+        reply(s, "ERR guesses are 5-letter words\n");
+        return;
+    }
+    for (i = 0; i < 5; i++) {
+        if (!isalpha((unsigned char) args[1][i])) {
+            reply(s, "ERR guesses are 5-letter words\n");
+            return;
+        }
+        word[i] = (char) tolower((unsigned char) args[1][i]);
+    }
+    word[5] = '\0';
+
+    if (!dictionaryContains(dictionary, packWord(word))) {
+        reply(s, "ERR %s is not in the word list\n", word);
+        return;
+    }
+
+    code = gameStateSubmit(&s->game, word);
+    for (i = 0; i < 5; i++) {
+        int digit = patternDigit(code, i);
+
+        pattern[i] = digit == DIGIT_GREEN ? 'G' : (digit == DIGIT_YELLOW ? 'Y' : '.');
+    }
+    pattern[5] = '\0';
+
+    if (!gameStateOver(&s->game)) {
+        reply(s, "OK %s %d\n", pattern, MAX_GUESSES - s->game.guessCount);
+        return;
+    }
+
+    // Record the finished round; the reply waits until it is on disk
+    s->playing = 0;
+    job = new_job(loop, s, JOB_RESULT);
+    if (job == NULL) {
+        return;
+    }
+    job->game = s->game;
+    memcpy(job->pattern, pattern, sizeof(job->pattern));
+    s->stateAfterJob = s->state;
+    s->state = SESSION_WAITING;
+    resultLogAppend(s->username, s->game.answerWord, s->game.guessCount, s->game.won, time(NULL),
+                    result_committed, job);
+}
+
+/*
+ * start_query:
+ *   Hands STATS, LEADERBOARD or HISTORY to the workers, like start_job.
+ */
+
+static void start_query(struct EventLoop *loop, struct Session *s, int type, long limit, long offset) {
+    struct Job *job = new_job(loop, s, type);
+
+    if (job == NULL) {
+        return;
+    }
+    snprintf(job->username, sizeof(job->username), "%s", s->username);
+    job->limit = limit;
+    job->offset = offset;
+
+    s->stateAfterJob = s->state;
+    s->state = SESSION_WAITING;
+    submit_job(job);
+}
+
+/* command_stats: STATS */
+static void command_stats(struct EventLoop *loop, struct Session *s) {
+    TRACE_SCOPE("STATS");
+
+    start_query(loop, s, JOB_STATS, 0, 0);
+}
+
+/* command_leaderboard: LEADERBOARD [N] */
+static void command_leaderboard(struct EventLoop *loop, struct Session *s, char **args, int count) {
+    TRACE_SCOPE("LEADERBOARD");
+    int limit;
+
+    if (count > 2 || parse_count(count > 1 ? args[1] : NULL, SERVER_LEADERS, &limit) != 0) {
+        reply(s, "ERR usage: LEADERBOARD [1-%d]\n", SERVER_ROWS_MAX);
+        return;
+    }
+    start_query(loop, s, JOB_LEADERBOARD, limit, 0);
+}
+
+/* command_history: HISTORY [N [OFFSET]] */
+static void command_history(struct EventLoop *loop, struct Session *s, char **args, int count) {
+    TRACE_SCOPE("HISTORY");
+    long offset = 0;
+    int limit;
+
+    if (count > 3 || parse_count(count > 1 ? args[1] : NULL, SERVER_HISTORY_ROWS, &limit) != 0 ||
+        (count > 2 && (sscanf(args[2], "%ld", &offset) != 1 || offset < 0))) {
+        reply(s, "ERR usage: HISTORY [1-%d [OFFSET]]\n", SERVER_ROWS_MAX);
+        return;
+    }
+    start_query(loop, s, JOB_HISTORY, limit, offset);
+}
+
+/*
+ * handle_command:
+ *   Runs one command line and queues its reply.
+ */
+
+static void handle_command(struct EventLoop *loop, struct Session *s, char *line) {
+    char *args[4];
+    char *save = NULL;
+    char *token;
+    int count = 0;
+
+    for (token = strtok_r(line, " \t", &save); token != NULL; token = strtok_r(NULL, " \t", &save)) {
+        if (count == 4) {
+            reply(s, "ERR too many arguments\n");
+            return;
+        }
+        args[count] = token;
+        count = count + 1;
+    }
+    if (count == 0) {
+        return;
+    }
+
+    if (strcasecmp(args[0], "PING") == 0) {
+        reply(s, "OK pong\n");
+    } else if (strcasecmp(args[0], "QUIT") == 0) {
+        reply(s, "OK bye\n");
+        s->closing = 1;
+    } else if (strcasecmp(args[0], "LOGIN") == 0) {
+        command_login(loop, s, args, count);
+    } else if (strcasecmp(args[0], "REGISTER") == 0) {
+        command_register(loop, s, args, count);
+    } else if (strcasecmp(args[0], "LEADERBOARD") == 0) {
+        command_leaderboard(loop, s, args, count);
+    } else if (strcasecmp(args[0], "HISTORY") == 0) {
+        command_history(loop, s, args, count);
+    } else if (strcasecmp(args[0], "NEW") != 0 && strcasecmp(args[0], "GUESS") != 0 &&
+               strcasecmp(args[0], "HINT") != 0 && strcasecmp(args[0], "STATS") != 0) {
+        reply(s, "ERR unknown command %s\n", args[0]);
+    } else if (s->state != SESSION_PLAYER) {
+        reply(s, "ERR log in first\n");
+    } else if (strcasecmp(args[0], "NEW") == 0) {
+        command_new(loop, s);
+    } else if (strcasecmp(args[0], "GUESS") == 0) {
+        command_guess(loop, s, args, count);
+    } else if (strcasecmp(args[0], "STATS") == 0) {
+        command_stats(loop, s);
+    } else if (!s->playing) {
+        reply(s, "ERR no game in progress, send NEW\n");
+    } else {
+        start_job(loop, s, JOB_HINT, NULL, NULL, NULL);
+    }
+}
+
+/*
+ * process_input:
+ *   Runs every complete line in the input buffer, stopping while the
+ *   session waits for a job.
+ */
+
+static void process_input(struct EventLoop *loop, struct Session *s) {
+    size_t start = 0;
+
+    while (s->state != SESSION_WAITING && !s->closing) {
+        char *newline = memchr(s->in + start, '\n', s->inLength - start);
+        size_t length;
+
+        if (newline == NULL) {
+            break;
+        }
+        length = (size_t) (newline - (s->in + start));
+        *newline = '\0';
+        if (length > 0 && s->in[start + length - 1] == '\r') {
+            s->in[start + length - 1] = '\0';
+        }
+        handle_command(loop, s, s->in + start);
+        start = start + length + 1;
+    }
+
+    memmove(s->in, s->in + start, s->inLength - start);
+    s->inLength = s->inLength - start;
+}
+
+/*
+ * on_readable:
+ *   Reads what the client sent and runs the complete commands.
+ */
+
+static void on_readable(struct EventLoop *loop, struct Session *s) {
+    while (s->state != SESSION_WAITING && !s->closing) {
+        ssize_t n;
+
+        if (s->inLength == sizeof(s->in)) {
+            reply(s, "ERR line too long\n");
+            s->closing = 1;
+            break;
+        }
+
+        n = read(s->fd, s->in + s->inLength, sizeof(s->in) - s->inLength);
+        if (n > 0) {
+            s->inLength = s->inLength + (size_t) n;
+            process_input(loop, s);
+        } else if (n == 0) {
+            close_session(loop, s);
+            return;
+        } else if (errno == EINTR) {
+            continue;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        } else {
+            close_session(loop, s);
+            return;
+        }
+    }
+    flush_output(loop, s);
+}
+
+/*
+ * finish_job:
+ *   Back on the session's loop: applies a job's result and replies.
+ */
+
+static void finish_job(struct EventLoop *loop, struct Session *s, const struct Job *job) {
+    s->state = s->stateAfterJob;
+
+    if (job->type == JOB_LOGIN) {
+        if (job->failed) {
+            reply(s, "ERR wrong password\n");
+            return;
+        }
+        // Outdated hashes are replaced now that the password is known
+        if (job->hash[0] != '\0') {
+            accountStoreUpdate(&loop->accounts, job->username, job->hash);
+        }
+        snprintf(s->username, sizeof(s->username), "%s", job->username);
+        s->state = SESSION_PLAYER;
+        reply(s, "OK welcome %s\n", s->username);
+    } else if (job->type == JOB_REGISTER) {
+        if (job->failed) {
+            reply(s, "ERR could not hash the password\n");
+        } else if (accountStoreAdd(&loop->accounts, job->username, job->hash) != 0) {
+            reply(s, "ERR username taken\n");
+        } else {
+            snprintf(s->username, sizeof(s->username), "%s", job->username);
+            s->state = SESSION_PLAYER;
+            reply(s, "OK registered %s\n", s->username);
+        }
+    } else if (job->type == JOB_STATS) {
+        const Stats *stats = &job->stats;
+
+        reply(s, "OK games=%d wins=%d losses=%d streak=%d best=%d guesses=%d dist=%d,%d,%d,%d,%d,%d\n",
+              stats->gamesPlayed, stats->wins, stats->losses, stats->currentStreak, stats->maxStreak,
+              stats->totalGuesses, stats->winsByGuess[0], stats->winsByGuess[1], stats->winsByGuess[2],
+              stats->winsByGuess[3], stats->winsByGuess[4], stats->winsByGuess[5]);
+    } else if (job->type == JOB_LEADERBOARD) {
+        const struct LeaderboardEntry *entries = job->leaders;
+        long i;
+
+        if (job->failed) {
+            reply(s, "ERR server busy\n");
+            return;
+        }
+        reply(s, "OK %ld\n", job->rows);
+        for (i = 0; i < job->rows; i++) {
+            reply(s, "%ld %s %d %d %d %.2f %.2f\n", i + 1, entries[i].username, entries[i].gamesPlayed,
+                  entries[i].wins, entries[i].losses, entries[i].winRate * 100.0, entries[i].avgGuesses);
+        }
+    } else if (job->type == JOB_HISTORY) {
+        const struct GameResult *games = job->games;
+        long i;
+
+        if (job->failed) {
+            reply(s, "ERR server busy\n");
+            return;
+        }
+        reply(s, "OK %ld\n", job->rows);
+        for (i = 0; i < job->rows; i++) {
+            reply(s, "%s %s %d %s %s\n", games[i].username, games[i].word, games[i].guesses,
+                  games[i].won ? "WIN" : "LOSS", games[i].timestamp);
+        }
+    } else if (job->type == JOB_RESULT) {
+        if (job->failed) {
+            reply(s, "ERR could not record the game\n");
+        } else if (job->game.won) {
+            reply(s, "OK %s 0 WIN\n", job->pattern);
+        } else {
+            reply(s, "OK %s 0 LOSS %s\n", job->pattern, job->game.answerWord);
+        }
+    } else if (job->failed) {
+        reply(s, "ERR no hint available\n");
+    } else {
+        reply(s, "OK hint %s %d\n", job->hint.word, job->hint.candidates);
+    }
+}
+
+/*
+ * on_jobs_done:
+ *   Takes the loop's finished jobs, oldest first, and resumes their sessions.
+ */
+
+static void on_jobs_done(struct EventLoop *loop) {
+    struct Job *done;
+    struct Job *ordered = NULL;
+    uint64_t value;
+
+    if (read(loop->wakeFd, &value, sizeof(value)) != sizeof(value)) {
+        // Spurious wake-up: the list below may simply be empty
+    }
+
+    pthread_mutex_lock(&loop->doneLock);
+    done = loop->done;
+    loop->done = NULL;
+    pthread_mutex_unlock(&loop->doneLock);
+
+    while (done != NULL) {
+        struct Job *next = done->next;
+
+        done->next = ordered;
+        ordered = done;
+        done = next;
+    }
+
+    while (ordered != NULL) {
+        struct Job *job = ordered;
+        struct Session *s = NULL;
+
+        ordered = job->next;
+        if (job->fd < loop->sessionSlots) {
+            s = loop->sessions[job->fd];
+        }
+
+        // The client may have disconnected while the job ran
+        if (s != NULL && s->id == job->sessionId) {
+            finish_job(loop, s, job);
+            process_input(loop, s);
+            flush_output(loop, s);
+        }
+        free_job(job);
+    }
+}
+
+/*
+ * on_accept:
+ *   Accepts every pending connection and gives each a session.
+ */
+
+static void on_accept(struct EventLoop *loop) {
+    for (;;) {
+        struct epoll_event ev;
+        struct Session *s;
+        int fd = accept4(loop->listenFd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        int one = 1;
+
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            return;   // EAGAIN, or out of descriptors until some close
+        }
+
+        if (serverOptions->maxSessions > 0 &&
+            __atomic_load_n(&sessionCount, __ATOMIC_RELAXED) >= serverOptions->maxSessions) {
+            static const char full[] = "ERR server full\n";
+
+            if (send(fd, full, sizeof(full) - 1, MSG_NOSIGNAL) < 0) {
+                // Closing anyway
+            }
+            close(fd);
+            continue;
+        }
+
+        if (fd >= loop->sessionSlots) {
+            int slots = loop->sessionSlots > 0 ? loop->sessionSlots : 1024;
+            struct Session **grown;
+
+            while (slots <= fd) {
+                slots = slots * 2;
+            }
+            grown = realloc(loop->sessions, sizeof(struct Session *) * (size_t) slots);
+            if (grown == NULL) {
+                close(fd);
+                continue;
+            }
+            memset(grown + loop->sessionSlots, 0,
+                   sizeof(struct Session *) * (size_t) (slots - loop->sessionSlots));
+            loop->sessions = grown;
+            loop->sessionSlots = slots;
+        }
+
+        s = calloc(1, sizeof(struct Session));
+        if (s == NULL) {
+            close(fd);
+            continue;
+        }
+        s->fd = fd;
+        s->id = __atomic_fetch_add(&nextSessionId, 1, __ATOMIC_RELAXED);
+        s->state = SESSION_GUEST;
+        s->events = EPOLLIN;
+
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));   // fails harmlessly on Unix sockets
+
+        ev.events = EPOLLIN;
+        ev.data.fd = fd;
+        if (epoll_ctl(loop->epollFd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+            close(fd);
+            free(s);
+            continue;
+        }
+        loop->sessions[fd] = s;
+        __atomic_add_fetch(&sessionCount, 1, __ATOMIC_RELAXED);
+    }
+}
+
+/*
+ * loop_main:
+ *   The event loop: new connections, client input and output, finished jobs.
+ */
+
+static void *loop_main(void *arg) {
+    struct EventLoop *loop = arg;
+    struct epoll_event events[SERVER_EVENTS];
+    int i;
+
+    while (!stopRequested) {
+        int n = epoll_wait(loop->epollFd, events, SERVER_EVENTS, SERVER_TICK_MS);
+
+        for (i = 0; i < n; i++) {
+            int fd = events[i].data.fd;
+            struct Session *s;
+
+            if (fd == loop->listenFd) {
+                on_accept(loop);
+                continue;
+            }
+            if (fd == loop->wakeFd) {
+                on_jobs_done(loop);
+                continue;
+            }
+
+            s = (fd < loop->sessionSlots) ? loop->sessions[fd] : NULL;
+            if (s == NULL) {
+                continue;   // closed earlier in this batch
+            }
+            if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                close_session(loop, s);
+            } else if (events[i].events & EPOLLIN) {
+                on_readable(loop, s);
+            } else if (events[i].events & EPOLLOUT) {
+                flush_output(loop, s);
+            }
+        }
+    }
+
+    for (i = 0; i < loop->sessionSlots; i++) {
+        if (loop->sessions[i] != NULL) {
+            close_session(loop, loop->sessions[i]);
+        }
+    }
+    return NULL;
+}
+
+/* ---------------------------------------------------------------------
+ * Start-up and shutdown
+ * ------------------------------------------------------------------- */
+
+/*
+ * open_listener:
+ *   A non-blocking listening socket for the configured address. TCP
+ *   sockets use SO_REUSEPORT so every loop can bind its own.
+ *
+ * RETURNS:
+ *   The socket, or -1 with a message on stderr.
+ */
+
+static int open_listener(const ServerOptions *options) {
+    int one = 1;
+    int fd;
+
+    if (options->socketPath != NULL) {
+        struct sockaddr_un addr;
+
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        if (strlen(options->socketPath) >= sizeof(addr.sun_path)) {
+            fprintf(stderr, "Error: socket path too long: %s\n", options->socketPath);
+            return -1;
+        }
+        strcpy(addr.sun_path, options->socketPath);
+        unlink(options->socketPath);
+
+        fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0 || bind(fd, (struct sockaddr *) &addr, sizeof(addr)) != 0 || listen(fd, SOMAXCONN) != 0) {
+            fprintf(stderr, "Error: cannot listen on %s: %s\n", options->socketPath, strerror(errno));
+            if (fd >= 0) {
+                close(fd);
+            }
+            return -1;
+        }
+        return fd;
+    }
+
+    {
+        struct sockaddr_in addr;
+
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons((uint16_t) options->port);
+        if (inet_pton(AF_INET, options->host, &addr.sin_addr) != 1) {
+            fprintf(stderr, "Error: not an IPv4 address: %s\n", options->host);
+            return -1;
+        }
+
+        fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0) {
+            fprintf(stderr, "Error: cannot create a socket: %s\n", strerror(errno));
+            return -1;
+        }
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one));
+        if (bind(fd, (struct sockaddr *) &addr, sizeof(addr)) != 0 || listen(fd, SOMAXCONN) != 0) {
+            fprintf(stderr, "Error: cannot listen on %s:%d: %s\n", options->host, options->port, strerror(errno));
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+}
+
+/*
+ * loop_init:
+ *   Sets up one loop: epoll, its listening socket (or the shared Unix one),
+ *   the wake-up eventfd and its handle on the account store.
+ *
+ * RETURNS:
+ *   0 on success, 1 on failure.
+ */
+
+static int loop_init(struct EventLoop *loop, int id, int sharedListenFd) {
+    struct epoll_event ev;
+
+    memset(loop, 0, sizeof(*loop));
+    loop->id = id;
+    loop->rng = ((uint64_t) time(NULL) ^ ((uint64_t) (id + 1) * 0x9E3779B97F4A7C15ull)) | 1;
+    pthread_mutex_init(&loop->doneLock, NULL);
+
+    loop->epollFd = epoll_create1(EPOLL_CLOEXEC);
+    loop->wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (loop->epollFd < 0 || loop->wakeFd < 0) {
+        return 1;
+    }
+
+    if (sharedListenFd >= 0) {
+        loop->listenFd = sharedListenFd;
+        ev.events = EPOLLIN | EPOLLEXCLUSIVE;
+    } else {
+        loop->listenFd = open_listener(serverOptions);
+        loop->ownsListenFd = 1;
+        ev.events = EPOLLIN;
+    }
+    if (loop->listenFd < 0) {
+        return 1;
+    }
+    ev.data.fd = loop->listenFd;
+    epoll_ctl(loop->epollFd, EPOLL_CTL_ADD, loop->listenFd, &ev);
+
+    ev.events = EPOLLIN;
+    ev.data.fd = loop->wakeFd;
+    epoll_ctl(loop->epollFd, EPOLL_CTL_ADD, loop->wakeFd, &ev);
+
+    loop->accountsOpen = (accountStoreOpen(&loop->accounts) == 0);
+    if (!loop->accountsOpen) {
+        fprintf(stderr, "Error: cannot open %s\n", dataPath(ACCOUNTS_FILE));
+        return 1;
+    }
+    return 0;
+}
+
+/* loop_free: releases what loop_init set up */
+static void loop_free(struct EventLoop *loop) {
+    struct Job *job = loop->done;
+
+    while (job != NULL) {
+        struct Job *next = job->next;
+
+        free_job(job);
+        job = next;
+    }
+    if (loop->accountsOpen) {
+        accountStoreClose(&loop->accounts);
+    }
+    if (loop->ownsListenFd && loop->listenFd >= 0) {
+        close(loop->listenFd);
+    }
+    if (loop->wakeFd > 0) {
+        close(loop->wakeFd);
+    }
+    if (loop->epollFd > 0) {
+        close(loop->epollFd);
+    }
+    free(loop->sessions);
+    pthread_mutex_destroy(&loop->doneLock);
+}
+
+/* cpu_count: online CPUs, at least 1 */
+static int cpu_count(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return n > 0 ? (int) n : 1;
+}
+
+/* parse_option: a whole decimal number in min..max; returns 0, or 1 if 'text' is not one */
+static int parse_option(const char *text, long min, long max, int *value) {
+    char *end;
+    long parsed;
+
+    errno = 0;
+    parsed = strtol(text, &end, 10);
+    if (end == text || *end != '\0' || errno != 0 || parsed < min || parsed > max) {
+        return 1;
+    }
+    *value = (int) parsed;
+    return 0;
+}
+
+/*
+ * parseServerArgs:
+ *   Defaults: TCP on 127.0.0.1:7777, one loop and one worker per CPU,
+ *   no session limit, textFiles for the game files, the built-in word list.
+ *
+ * RETURNS:
+ *   0 on success, 1 on a bad or missing value.
+ */
+
+int parseServerArgs(int argc, char *argv[], ServerOptions *options) {
+    int i;
+
+    options->socketPath = NULL;
+    options->host = SERVER_DEFAULT_HOST;
+    options->port = SERVER_DEFAULT_PORT;
+    options->loops = 0;
+    options->workers = 0;
+    options->maxSessions = 0;
+    options->dataDir = NULL;
+    options->dictPath = NULL;
+    options->profile = 0;
+    options->tracePath = NULL;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--socket") == 0 && i + 1 < argc) {
+            options->socketPath = argv[++i];
+        } else if (strcmp(argv[i], "--host") == 0 && i + 1 < argc) {
+            options->host = argv[++i];
+        } else if (strcmp(argv[i], "--port") == 0 && i + 1 < argc) {
+            if (parse_option(argv[++i], 1, 65535, &options->port) != 0) {
+                fprintf(stderr, "Error: --port expects a port number\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--loops") == 0 && i + 1 < argc) {
+            if (parse_option(argv[++i], 1, SERVER_THREADS_MAX, &options->loops) != 0) {
+                fprintf(stderr, "Error: --loops expects a number of threads (1 to %d)\n", SERVER_THREADS_MAX);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--workers") == 0 && i + 1 < argc) {
+            if (parse_option(argv[++i], 1, SERVER_THREADS_MAX, &options->workers) != 0) {
+                fprintf(stderr, "Error: --workers expects a number of threads (1 to %d)\n", SERVER_THREADS_MAX);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--max-sessions") == 0 && i + 1 < argc) {
+            if (parse_option(argv[++i], 1, INT_MAX, &options->maxSessions) != 0) {
+                fprintf(stderr, "Error: --max-sessions expects a positive number of sessions\n");
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--data-dir") == 0 && i + 1 < argc) {
+            options->dataDir = argv[++i];
+        } else if (strcmp(argv[i], "--dict") == 0 && i + 1 < argc) {
+            options->dictPath = argv[++i];
+        } else if (strcmp(argv[i], "--profile") == 0) {
+            options->profile = 1;
+        } else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            options->tracePath = argv[++i];
+        } else {
+            fprintf(stderr, "Error: unknown server option '%s'\n", argv[i]);
+            return 1;
+        }
+    }
+
+    if (options->loops < 1) {
+        options->loops = cpu_count();
+    }
+    if (options->workers < 1) {
+        options->workers = cpu_count();
+    }
+    return 0;
+}
+
+/*
+ * runServer:
+ *   Starts the workers and loops, waits for a signal, then shuts down.
+ *
+ * RETURNS:
+ *   0 after a clean shutdown, 1 if the server could not start.
+ */
+
+int runServer(const ServerOptions *options) {
+    struct EventLoop *loops;
+    pthread_t *workers;
+    struct sigaction action;
+    int sharedListenFd = -1;
+    long replayed, games, commits;
+    int failed = 0;
+    int started = 0;
+    int workersStarted = 0;
+    int loopsStarted = 0;
+    int threadsFailed = 0;
+    int i;
+
+    serverOptions = options;
+
+    if (options->dataDir != NULL && setDataDir(options->dataDir) != 0) {
+        fprintf(stderr, "Error: --data-dir expects a directory\n");
+        return 1;
+    }
+
+    if ((options->profile && profileEnable() != 0) ||
+        (options->tracePath != NULL && traceEnable(options->tracePath, "wordexd") != 0)) {
+        fprintf(stderr, "Error: --profile and --trace need a build with the profiler (make profile)\n");
+        return 1;
+    }
+    TRACE_BEGIN(startup);
+
+    if (options->dictPath != NULL) {
+        setDictionaryPath(options->dictPath);
+    }
+    dictionary = getDictionary();
+    if (dictionary == NULL || dictionary->count == 0) {
+        fprintf(stderr, "Error: could not load the word list\n");
+        return 1;
+    }
+    getPatternMatrix();   // map it before the first hint, not during it
+
+    // Games a previous run committed but did not apply come first
+    replayed = replayResultLogs();
+    if (replayed > 0) {
+        printf("wordexd replayed %ld game%s from earlier result logs\n", replayed, replayed == 1 ? "" : "s");
+    }
+    // Without the log finished games would be written, and synced, on a loop thread
+    if (resultLogOpen() != 0) {
+        fprintf(stderr, "Error: wordexd cannot run without its result log\n");
+        return 1;
+    }
+
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = on_signal;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    loops = calloc((size_t) options->loops, sizeof(struct EventLoop));
+    workers = calloc((size_t) options->workers, sizeof(pthread_t));
+    if (loops == NULL || workers == NULL) {
+        free(loops);
+        free(workers);
+        return 1;
+    }
+
+    // A Unix socket cannot be bound twice: the loops share one
+    if (options->socketPath != NULL) {
+        sharedListenFd = open_listener(options);
+        failed = (sharedListenFd < 0);
+    }
+
+    for (i = 0; i < options->loops && !failed; i++) {
+        failed = loop_init(&loops[i], i, sharedListenFd);
+        started = i + 1;
+    }
+
+    // Only threads that were created are joined; one that cannot be
+    // created stops the ones already running
+    while (!failed && !threadsFailed && workersStarted < options->workers) {
+        threadsFailed = (pthread_create(&workers[workersStarted], NULL, worker_main, NULL) != 0);
+        workersStarted = workersStarted + !threadsFailed;
+    }
+    while (!failed && !threadsFailed && loopsStarted < options->loops) {
+        threadsFailed = (pthread_create(&loops[loopsStarted].thread, NULL, loop_main, &loops[loopsStarted]) != 0);
+        loopsStarted = loopsStarted + !threadsFailed;
+    }
+    if (threadsFailed) {
+        fprintf(stderr, "Error: cannot start the server threads\n");
+        failed = 1;
+    }
+
+    if (failed) {
+        stopRequested = 1;
+    } else {
+        if (options->socketPath != NULL) {
+            printf("wordexd listening on %s", options->socketPath);
+        } else {
+            printf("wordexd listening on %s:%d", options->host, options->port);
+        }
+        printf(" (%d loop%s, %d worker%s)\n", options->loops, options->loops == 1 ? "" : "s",
+               options->workers, options->workers == 1 ? "" : "s");
+        TRACE_END("startup", startup);
+        fflush(stdout);
+    }
+
+    for (i = 0; i < loopsStarted; i++) {
+        pthread_join(loops[i].thread, NULL);
+    }
+    pthread_mutex_lock(&jobLock);
+    workersStopping = 1;
+    pthread_cond_broadcast(&jobReady);
+    pthread_mutex_unlock(&jobLock);
+    for (i = 0; i < workersStarted; i++) {
+        pthread_join(workers[i], NULL);
+    }
+
+    // Commit and apply what is still queued; replies to closed sessions are dropped
+    resultLogClose();
+    if (!failed) {
+        resultLogCounters(&games, &commits);
+        printf("wordexd stopped (%ld game%s recorded in %ld log sync%s)\n", games, games == 1 ? "" : "s",
+               commits, commits == 1 ? "" : "s");
+    }
+
+    for (i = 0; i < started; i++) {
+        loop_free(&loops[i]);
+    }
+    while (jobHead != NULL) {
+        struct Job *next = jobHead->next;
+
+        free_job(jobHead);
+        jobHead = next;
+    }
+    if (sharedListenFd >= 0) {
+        close(sharedListenFd);
+        unlink(options->socketPath);
+    }
+
+    free(loops);
+    free(workers);
+    return failed;
+}
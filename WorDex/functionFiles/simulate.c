@@ -0,0 +1,394 @@
+/* simulate.c
+ *
+ * Headless bulk simulation for the Wordex game.
+ *
+ * FUNCTIONALITY:
+ *  - parseSimulationArgs: reads --simulate N --threads T --strategy S --persist
+ *  - runSimulation: splits N games over T threads, at most one per game.
+ *    Every thread has its own random number generator, GameState and result
+ *    counters, and plays with the same GameState / scoring code as the
+ *    interactive game, but with no terminal, sleeps or screen clears. A
+ *    worker whose thread cannot be started plays on the calling thread.
+ *  - results go to an in-memory sink by default, or with --persist through
+ *    the result log, which commits the games finishing at the same time
+ *    with one sync and applies them to the history and stats files
+ *  - prints games/sec, the guess distribution and per-stage latency
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "../headerFiles/simulate.h"
+#include "../headerFiles/game_logic.h"
+#include "../headerFiles/hint.h"
+#include "../headerFiles/result_log.h"
+#include "../headerFiles/random.h"
+#include "../headerFiles/profile.h"
+
+/* Stages we time for every game */
+enum {
+    STAGE_SELECT,        // picking the answer
+    STAGE_CHOOSE,        // the strategy picking a guess
+    STAGE_SCORE,         // scoring the guess and narrowing candidates
+    STAGE_PERSIST,       // recording the result
+    STAGE_COUNT
+};
+
+static const char *stageNames[STAGE_COUNT] = {
+    "select answer", "choose guess", "score guess", "persist result"
+};
+
+/* SimWorker:
+ *   Everything one thread owns: inputs, RNG state and its results.
+ */
+struct SimWorker {
+    const SimulationOptions *options;
+    const Dictionary        *dict;
+    int                      id;
+    long                     games;
+    uint64_t                 rng;
+
+    long                     wins;
+    long                     byGuesses[MAX_GUESSES + 1];   // [0] counts losses
+    ProfileHistogram         stages[STAGE_COUNT];   // log-linear, like --profile's
+};
+
+/* now_ns: monotonic clock in nanoseconds */
+static uint64_t now_ns(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ull + (uint64_t) ts.tv_nsec;
+}
+
+/*
+ * greedy_pick:
+ *   Among the candidates, picks the word whose distinct letters are most
+ *   common across all candidates.
+ */
+
+static int greedy_pick(const Dictionary *dict, const int *candidates, int count) {
+    long letterCounts[27];
+    long bestScore = -1;
+    int best = candidates[0];
+    int c, i;
+
+    memset(letterCounts, 0, sizeof(letterCounts));
+    for (c = 0; c < count; c++) {
+        uint32_t packed = dictionaryPackedAt(dict, candidates[c]);
+
+        for (i = 0; i < WORD_LENGTH; i++) {
+            letterCounts[(packed >> (LETTER_BITS * i)) & 31]++;
+        }
+    }
+
+    for (c = 0; c < count; c++) {
+        uint32_t packed = dictionaryPackedAt(dict, candidates[c]);
+        uint32_t seen = 0;
+        long score = 0;
+
+        for (i = 0; i < WORD_LENGTH; i++) {
+            uint32_t letter = (packed >> (LETTER_BITS * i)) & 31;
+
+            if (!(seen & (1u << letter))) {
+                seen |= 1u << letter;
+                score += letterCounts[letter];
+            }
+        }
+        if (score > bestScore) {
+            bestScore = score;
+            best = candidates[c];
+        }
+    }
+    return best;
+}
+
+/*
+ * play_games:
+ *   Thread entry point. Plays this worker's share of the games.
+ */
+
+static void *play_games(void *arg) {
+    struct SimWorker *w = arg;
+    const Dictionary *dict = w->dict;
+    int *candidates = malloc(sizeof(int) * dict->count);
+    char username[NAME_MAX_LEN];
+    long g;
+    int i;
+
+    snprintf(username, sizeof(username), "sim%d", w->id);
+
+    for (g = 0; g < w->games && candidates != NULL; g++) {
+        GameState game;
+        char answer[6];
+        int candCount = dict->count;
+        uint64_t t0, t1;
+
+        t0 = now_ns();
+        dictionaryWordAt(dict, (int) (nextRandom(&w->rng) % (uint64_t) dict->count), answer);
+        gameStateInit(&game, answer);
+        for (i = 0; i < candCount; i++) {
+            candidates[i] = i;
+        }
+        t1 = now_ns();
+        profileHistogramAdd(&w->stages[STAGE_SELECT], t1 - t0);
+
+        while (!gameStateOver(&game)) {
+            char guess[6];
+            int pick;
+            uint8_t pattern;
+            int kept = 0;
+
+            t0 = now_ns();
+            if (w->options->strategy == STRATEGY_ENTROPY) {
+                Hint hint;
+
+                bestGuess(dict, &game, 1, &hint);
+                pick = hint.guessIndex;
+            } else if (w->options->strategy == STRATEGY_GREEDY) {
+                pick = greedy_pick(dict, candidates, candCount);
+            } else {
+                pick = candidates[nextRandom(&w->rng) % (uint64_t) candCount];
+            }
+            dictionaryWordAt(dict, pick, guess);
+            t1 = now_ns();
+            profileHistogramAdd(&w->stages[STAGE_CHOOSE], t1 - t0);
+
+            // Score once, then keep only the answers that agree with it
+            pattern = gameStateSubmit(&game, guess);
+            for (i = 0; i < candCount; i++) {
+                if (patternAt(dict, pick, candidates[i]) == pattern) {
+                    candidates[kept] = candidates[i];
+                    kept = kept + 1;
+                }
+            }
+            candCount = kept;
+            t0 = now_ns();
+            profileHistogramAdd(&w->stages[STAGE_SCORE], t0 - t1);
+        }
+
+        if (game.won) {
+            w->wins = w->wins + 1;
+            w->byGuesses[game.guessCount]++;
+        } else {
+            w->byGuesses[0]++;
+        }
+
+        t0 = now_ns();
+        if (w->options->persist) {
+            resultLogAppend(username, game.answerWord, game.guessCount, game.won, time(NULL), NULL, NULL);
+        }
+        profileHistogramAdd(&w->stages[STAGE_PERSIST], now_ns() - t0);
+    }
+
+    free(candidates);
+    return NULL;
+}
+
+/* parse_number: a whole decimal number in min..max; returns 0, or 1 if 'text' is not one */
+static int parse_number(const char *text, long min, long max, long *value) {
+    char *end;
+    long parsed;
+
+    errno = 0;
+    parsed = strtol(text, &end, 10);
+    if (end == text || *end != '\0' || errno != 0 || parsed < min || parsed > max) {
+        return 1;
+    }
+    *value = parsed;
+    return 0;
+}
+
+/*
+ * parseSimulationArgs:
+ *   --simulate N [--threads T] [--strategy random|greedy|entropy] [--persist]
+ *
+ * RETURNS:
+ *   0 on success, 1 on a bad or missing value.
+ */
+
+int parseSimulationArgs(int argc, char *argv[], SimulationOptions *options) {
+    long threads;
+    int i;
+
+    options->games = 0;
+    options->threads = 0;
+    options->strategy = STRATEGY_ENTROPY;
+    options->persist = 0;
+
+    if (argc < 3 || parse_number(argv[2], 1, LONG_MAX, &options->games) != 0) {
+        fprintf(stderr, "Error: --simulate needs a positive number of games\n");
+        return 1;
+    }
+
+    for (i = 3; i < argc; i++) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            if (parse_number(argv[++i], 1, SIMULATION_THREADS_MAX, &threads) != 0) {
+                fprintf(stderr, "Error: --threads expects a number of threads (1 to %d)\n",
+                        SIMULATION_THREADS_MAX);
+                return 1;
+            }
+            options->threads = (int) threads;
+        } else if (strcmp(argv[i], "--strategy") == 0 && i + 1 < argc) {
+            i = i + 1;
+            if (strcmp(argv[i], "random") == 0) {
+                options->strategy = STRATEGY_RANDOM;
+            } else if (strcmp(argv[i], "greedy") == 0) {
+                options->strategy = STRATEGY_GREEDY;
+            } else if (strcmp(argv[i], "entropy") == 0) {
+                options->strategy = STRATEGY_ENTROPY;
+            } else {
+                fprintf(stderr, "Error: unknown strategy '%s' (use random, greedy or entropy)\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--persist") == 0) {
+            options->persist = 1;
+        } else {
+            fprintf(stderr, "Error: unknown simulation option '%s'\n", argv[i]);
+            return 1;
+        }
+    }
+
+    if (options->threads < 1) {
+        options->threads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+        if (options->threads < 1) {
+            options->threads = 1;
+        }
+    }
+    // Every thread past one per game would have nothing to play
+    if (options->threads > options->games) {
+        options->threads = (int) options->games;
+    }
+    return 0;
+}
+
+/*
+ * runSimulation:
+ *   Starts the workers, waits for them and prints the merged report.
+ *
+ * RETURNS:
+ *   0 on success, 1 if the dictionary is unavailable or memory ran out.
+ */
+
+int runSimulation(const SimulationOptions *options) {
+    static const char *strategyNames[] = {"random", "greedy", "entropy"};
+    const Dictionary *dict = getDictionary();
+    struct SimWorker *workers;
+    struct SimWorker total;
+    pthread_t *tids;
+    uint64_t start, elapsed;
+    double seconds;
+    long played, guessSum = 0;
+    int created, running, t, s, b;
+
+    if (dict == NULL || dict->count == 0) {
+        fprintf(stderr, "Error: could not load the word list\n");
+        return 1;
+    }
+
+    workers = calloc((size_t) options->threads, sizeof(struct SimWorker));
+    tids = calloc((size_t) options->threads, sizeof(pthread_t));
+    if (workers == NULL || tids == NULL) {
+        free(workers);
+        free(tids);
+        return 1;
+    }
+
+    getPatternMatrix();   // map it once up front rather than inside the timed loop
+
+    if (options->persist && resultLogOpen() != 0) {
+        free(workers);
+        free(tids);
+        return 1;
+    }
+
+    start = now_ns();
+    for (t = 0; t < options->threads; t++) {
+        workers[t].options = options;
+        workers[t].dict = dict;
+        workers[t].id = t;
+        workers[t].games = options->games / options->threads +
+                           (t < options->games % options->threads ? 1 : 0);
+        workers[t].rng = (start ^ ((uint64_t) (t + 1) * 0x9E3779B97F4A7C15ull)) | 1;
+    }
+    for (created = 0; created < options->threads; created++) {
+        if (pthread_create(&tids[created], NULL, play_games, &workers[created]) != 0) {
+            break;
+        }
+    }
+    // Workers no thread could be started for play on this one
+    for (t = created; t < options->threads; t++) {
+        play_games(&workers[t]);
+    }
+    for (t = 0; t < created; t++) {
+        pthread_join(tids[t], NULL);
+    }
+    running = created + (created < options->threads ? 1 : 0);
+    elapsed = now_ns() - start;
+
+    // Merge every worker's counters and histograms
+    memset(&total, 0, sizeof(total));
+    for (t = 0; t < options->threads; t++) {
+        total.wins += workers[t].wins;
+        for (b = 0; b <= MAX_GUESSES; b++) {
+            total.byGuesses[b] += workers[t].byGuesses[b];
+        }
+        for (s = 0; s < STAGE_COUNT; s++) {
+            profileHistogramMerge(&total.stages[s], &workers[t].stages[s]);
+        }
+    }
+
+    played = total.wins + total.byGuesses[0];
+    seconds = (double) elapsed / 1e9;
+    for (b = 1; b <= MAX_GUESSES; b++) {
+        guessSum += b * total.byGuesses[b];
+    }
+
+    printf("\nSimulated %ld games in %.3f s on %d thread%s (strategy: %s, persistence: %s)\n",
+           played, seconds, running, running == 1 ? "" : "s",
+           strategyNames[options->strategy], options->persist ? "files" : "memory");
+    printf("Throughput: %.0f games/sec\n", seconds > 0 ? played / seconds : 0.0);
+    if (options->persist) {
+        long committed, commits;
+
+        resultLogClose();
+        resultLogCounters(&committed, &commits);
+        printf("Result log: %ld games in %ld sync%s (%.1f games per sync)\n",
+               committed, commits, commits == 1 ? "" : "s",
+               commits > 0 ? (double) committed / commits : 0.0);
+    }
+    printf("Wins: %ld (%.2f%%), average guesses per win: %.3f\n",
+           total.wins, played > 0 ? 100.0 * total.wins / played : 0.0,
+           total.wins > 0 ? (double) guessSum / total.wins : 0.0);
+
+    printf("\nGuess distribution:\n");
+    for (b = 1; b <= MAX_GUESSES; b++) {
+        printf("  %d: %ld\n", b, total.byGuesses[b]);
+    }
+    printf("  X: %ld\n", total.byGuesses[0]);
+
+    printf("\nStage latency (microseconds):\n");
+    printf("  %-16s %10s %10s %10s %10s %12s\n", "stage", "mean", "p50", "p99", "max", "samples");
+    for (s = 0; s < STAGE_COUNT; s++) {
+        const ProfileHistogram *st = &total.stages[s];
+
+        printf("  %-16s %10.2f %10.2f %10.2f %10.2f %12llu\n",
+               stageNames[s],
+               st->count > 0 ? (double) st->total / st->count / 1000.0 : 0.0,
+               profilePercentile(st, 50.0) / 1000.0,
+               profilePercentile(st, 99.0) / 1000.0,
+               (double) st->max / 1000.0,
+               (unsigned long long) st->count);
+    }
+    printf("\n");
+
+    free(workers);
+    free(tids);
+    return 0;
+}
@@ -4,174 +4,1065 @@
 * This file handles:
 *   - creating default stats for new users
 *   - loading user stats to a txt file
-*   - updating user stats after each game
+*   - updating user stats after each game, rewriting only that user's
+*     fixed-width record through a username index and a redo journal
+*   - updating many users at once (updateStatsBatch), with one journal and
+*     two syncs for the whole batch
+*   - rebuilding every user's stats from the game history (rebuildStats),
+*     scanned in parallel with per-thread tallies merged in history order
 *   - print current stats for user
 
 * Zainab Mirza
 * Date: 2025/12/03
 */
 
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "../headerFiles/statistics.h"
+#include "../headerFiles/history_scan.h"
+#include "../headerFiles/record_parser.h"
+#include "../headerFiles/profile.h"
+#include "../headerFiles/data_dir.h"
+#include "../headerFiles/file_io.h"
+#include "../headerFiles/name_hash.h"
 
 /* Statistics txt file that stores user data */
-#define STATS_FILE "textFiles/stats.txt" 
+#define STATS_FILE "stats.txt" 
+
+/* Username -> record index, and the redo journal for the records being written */
+#define STATS_INDEX_FILE   "stats.idx"
+#define STATS_JOURNAL_FILE "stats.journal"
 
 /* File format for each user (one line per user):
 
 *    <username> <wins> <losses> <total games played> <currentStreak> <maxStreak> <total guesses> <last played time> <w1> <w2> <w3> <w4> <w5> <w6>
 
 *     where: w1 to w6 —> are the amount of wins for each 1,2,3,4,5,6 guesses 
+
+*  Every line is padded to exactly STATS_RECORD_WIDTH bytes, so user N's record
+*  starts at N * STATS_RECORD_WIDTH and can be rewritten in place. Files in
+*  the older unpadded layout are converted the first time they are opened.
 */
+#define STATS_RECORD_FORMAT "%-49s %10d %10d %10d %10d %10d %10d %20ld %10d %10d %10d %10d %10d %10d\n"
+#define STATS_RECORD_WIDTH  203
 
-/* defaultStats:
-* Creates default statistics for each new user and appends to the stats file */
-int defaultStats(const char *username) {
-    FILE *file = fopen(STATS_FILE, "a");   // Open stats file in append mode
+/* Index file: a header, then an open-addressing table of slots */
+#define STATS_INDEX_MAGIC   "WXSTIDX"
+#define STATS_INDEX_VERSION 1
+#define STATS_INDEX_SLOTS   1024     // initial slot count, a power of two
+#define STATS_JOURNAL_MAGIC "WXSTJNL"
+
+/* StatsIndexHeader:
+*  Describes the stats.txt the index was built for. If the file has changed
+*  in any way the index did not see (other size, inode or modification
+*  time), the index is rebuilt from stats.txt. */
+typedef struct {
+    char     magic[8];
+    uint32_t version;
+    uint32_t recordWidth;
+    uint64_t slotCount;
+    uint64_t recordCount;
+    uint64_t statsDevice;
+    uint64_t statsInode;
+    uint64_t statsSize;
+    int64_t  statsMtimeSec;
+    int64_t  statsMtimeNsec;
+} StatsIndexHeader;
+
+/* StatsIndexSlot: one username; record == 0 marks an empty slot */
+typedef struct {
+    uint32_t hash;
+    uint32_t record;      // record index + 1
+} StatsIndexSlot;
+
+/* StatsJournal:
+*  Redo record written (and synced) before a stats line is changed, one per
+*  line of the update. If the program stops half way, the next open writes
+*  the lines again. */
+typedef struct {
+    char     magic[8];
+    uint64_t offset;
+    uint32_t checksum;
+    uint32_t length;
+    char     record[STATS_RECORD_WIDTH];
+} StatsJournal;
+
+/* StatsTally:
+*  One user's stats over a stretch of history, as rebuildStats collects
+*  them. currentStreak is the run of wins that ends the stretch and
+*  leadWins the run that starts it, so two stretches can be joined. */
+typedef struct {
+    Stats s;
+    int   leadWins;
+    char  lastPlayed[TIME_MAX_LEN];   // timestamp of the stretch's last game
+    int   saved;                      // already written by rebuildStats
+} StatsTally;
+
+/* StatsTallyTable: tallies in first-seen order, with an open-addressing index (index + 1, 0 = empty) */
+typedef struct {
+    StatsTally *tallies;
+    uint32_t    count;
+    uint32_t    capacity;
+    uint32_t   *slots;
+    uint32_t    mask;
+} StatsTallyTable;
 
-    // print default stats (all zeros)
-    fprintf(file, "%s 0 0 0 0 0 0 0 0 0 0 0 0 0\n", username);
+/* StatsStore: stats.txt plus its mapped index, locked while open */
+typedef struct {
+    int               statsFd;
+    int               indexFd;
+    StatsIndexHeader *header;
+    StatsIndexSlot   *slots;
+    size_t            mapSize;
+} StatsStore;
 
-    fclose(file);
+/* checksum_bytes: FNV-1a over a journal record, to spot a torn journal write */
+static uint32_t checksum_bytes(const char *bytes, size_t length, uint64_t offset) {
+    uint32_t h = 2166136261u ^ (uint32_t) offset ^ (uint32_t) (offset >> 32);
+    size_t i;
+
+    for (i = 0; i < length; i++) {
+        h = (h ^ (unsigned char) bytes[i]) * 16777619u;
+    }
+    return h;
+}
+
+/* format_record: writes the padded line for s; returns 0, or 1 if it does not fit */
+static int format_record(const Stats *s, char *out) {
+    char line[STATS_RECORD_WIDTH + 64];
+    int n = snprintf(line, sizeof(line), STATS_RECORD_FORMAT,
+                     s->username,
+                     s->wins, s->losses, s->gamesPlayed,
+                     s->currentStreak, s->maxStreak,
+                     s->totalGuesses, s->lastPlayed,
+                     s->winsByGuess[0], s->winsByGuess[1], s->winsByGuess[2],
+                     s->winsByGuess[3], s->winsByGuess[4], s->winsByGuess[5]);
+
+    if (n != STATS_RECORD_WIDTH) {
+        return 1;
+    }
+    memcpy(out, line, STATS_RECORD_WIDTH);
     return 0;
 }
 
+/* parse_record: reads one stats line (padded or not) of 'length' bytes; returns 0, or 1 if malformed */
+static int parse_record(const char *line, size_t length, Stats *s) {
+    RecordCursor cursor;
+    int i;
 
-/* loadStats:
-* Loads statistics for existing users from stats file into a stats struct. If user is not in the file, it returns are error */ 
-int loadStats(const char *username, Stats *s) {
+    recordCursorInit(&cursor, line, length);
+    if (!recordNextString(&cursor, s->username, MAX_USERNAME) ||
+        !recordNextInt(&cursor, &s->wins) ||
+        !recordNextInt(&cursor, &s->losses) ||
+        !recordNextInt(&cursor, &s->gamesPlayed) ||
+        !recordNextInt(&cursor, &s->currentStreak) ||
+        !recordNextInt(&cursor, &s->maxStreak) ||
+        !recordNextInt(&cursor, &s->totalGuesses) ||
+        !recordNextLong(&cursor, &s->lastPlayed)) {
+        return 1;
+    }
+    for (i = 0; i < 6; i++) {
+        if (!recordNextInt(&cursor, &s->winsByGuess[i])) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* journal_entry_valid: 1 if j is a complete, untorn journal entry */
+static int journal_entry_valid(const StatsJournal *j) {
+    return memcmp(j->magic, STATS_JOURNAL_MAGIC, sizeof(j->magic)) == 0 &&
+           j->length == STATS_RECORD_WIDTH &&
+           j->checksum == checksum_bytes(j->record, j->length, j->offset);
+}
+
+/* recover_journal:
+*  Replays the journal left by an interrupted update, then empties it.
+*  Every entry is synced before any line is touched, so if one entry is
+*  torn no line was changed and the whole journal is simply dropped. */
+static void recover_journal(int statsFd) {
+    StatsJournal j;
+    struct stat st;
+    off_t offset;
+    int fd = open(dataPath(STATS_JOURNAL_FILE), O_RDWR);
+
+    if (fd < 0) {
+        return;
+    }
 
-    FILE *file = fopen(STATS_FILE, "r");  //open file for reading
-
-    // varibles to read each value from lines in the text file 
-    char name[MAX_USERNAME];
-    int wins, losses, gamesPlayed;
-    int currentStreak, maxStreak, totalGuesses;
-    long lastPlayed;
-    int w1, w2, w3, w4, w5, w6;
-
-    // Read each line until we find the matching username
-    while (fscanf(file, "%s %d %d %d %d %d %d %ld %d %d %d %d %d %d",
-                    name, &wins, &losses, &gamesPlayed, &currentStreak, 
-                    &maxStreak, &totalGuesses, &lastPlayed, &w1, &w2, &w3,
-                    &w4, &w5, &w6) == 14) {
-
-        // check if the username in file matches 
-        if (strcmp(name, username) == 0) {
-            
-            // copy username to struct
-            strncpy(s->username, name, MAX_USERNAME - 1);
-            s->username[MAX_USERNAME - 1] = '\0';
-
-            // store all data in the struct
-            s->wins = wins;
-            s->losses = losses;
-            s->gamesPlayed = gamesPlayed;
-            s->currentStreak = currentStreak;
-            s->maxStreak = maxStreak;
-            s->totalGuesses = totalGuesses;
-            s->lastPlayed = lastPlayed;
-            s->winsByGuess[0] = w1;
-            s->winsByGuess[1] = w2;
-            s->winsByGuess[2] = w3;
-            s->winsByGuess[3] = w4;
-            s->winsByGuess[4] = w5;
-            s->winsByGuess[5] = w6;
-
-            fclose(file);
-            return 0;
-        }       
-    }
-   
-    // No matching user found
-    fclose(file);
-    return 1; // user DNE
+    if (fstat(fd, &st) == 0 && st.st_size > 0 && st.st_size % (off_t) sizeof(j) == 0) {
+        int complete = 1;
 
+        for (offset = 0; offset < st.st_size && complete; offset += (off_t) sizeof(j)) {
+            complete = (pread(fd, &j, sizeof(j), offset) == (ssize_t) sizeof(j) &&
+                        journal_entry_valid(&j));
+        }
+        for (offset = 0; offset < st.st_size && complete; offset += (off_t) sizeof(j)) {
+            complete = (pread(fd, &j, sizeof(j), offset) == (ssize_t) sizeof(j) &&
+                        writeAt(statsFd, j.record, j.length, (off_t) j.offset) == 0);
+        }
+        if (complete) {
+            fsync(statsFd);
+        }
+    }
+
+    if (ftruncate(fd, 0) == 0) {
+        fsync(fd);
+    }
+    close(fd);
 }
 
-/* updateStats:
-* updates a user's statistics after each completed game and updates the users record in the stats file. */
-int updateStats(const char *username, int won, int guessCount, long timePlayed) {
+/* index_note_stats: records stats.txt's current size and mtime in the index */
+static void index_note_stats(StatsStore *store) {
+    struct stat st;
 
-    Stats s;  // struct that holds current stats for the user
+    if (fstat(store->statsFd, &st) == 0) {
+        store->header->statsDevice    = (uint64_t) st.st_dev;
+        store->header->statsInode     = (uint64_t) st.st_ino;
+        store->header->statsSize      = (uint64_t) st.st_size;
+        store->header->statsMtimeSec  = (int64_t) st.st_mtim.tv_sec;
+        store->header->statsMtimeNsec = (int64_t) st.st_mtim.tv_nsec;
+    }
+}
 
-    // load stats for user, if user DNE, create default record and load it
-    if (loadStats(username, &s) != 0) {
-        defaultStats(username);
-        loadStats(username, &s);   // load default stats
+/* index_map: maps the index file read/write; returns 0 or 1 on error */
+static int index_map(StatsStore *store) {
+    struct stat st;
+    void *map;
+
+    if (fstat(store->indexFd, &st) != 0 || (size_t) st.st_size < sizeof(StatsIndexHeader)) {
+        return 1;
+    }
+    map = mmap(NULL, (size_t) st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, store->indexFd, 0);
+    if (map == MAP_FAILED) {
+        return 1;
+    }
+
+    store->header  = map;
+    store->slots   = (StatsIndexSlot *) ((char *) map + sizeof(StatsIndexHeader));
+    store->mapSize = (size_t) st.st_size;
+
+    if (memcmp(store->header->magic, STATS_INDEX_MAGIC, 8) != 0 ||
+        store->header->version != STATS_INDEX_VERSION ||
+        store->header->recordWidth != STATS_RECORD_WIDTH ||
+        store->mapSize != sizeof(StatsIndexHeader) + store->header->slotCount * sizeof(StatsIndexSlot)) {
+        munmap(map, store->mapSize);
+        store->header = NULL;
+        return 1;
+    }
+    return 0;
+}
+
+/* index_unmap: drops the index mapping */
+static void index_unmap(StatsStore *store) {
+    if (store->header != NULL) {
+        munmap(store->header, store->mapSize);
+        store->header = NULL;
+        store->slots = NULL;
+    }
+}
+
+/* slot_insert: places a (hash, record) pair in a table with a free slot */
+static void slot_insert(StatsIndexSlot *slots, uint64_t slotCount, uint32_t hash, uint32_t record) {
+    uint64_t i = hash & (slotCount - 1);
+
+    while (slots[i].record != 0) {
+        i = (i + 1) & (slotCount - 1);
+    }
+    slots[i].hash = hash;
+    slots[i].record = record + 1;
+}
+
+/* index_create:
+*  Writes a fresh index with 'slotCount' slots holding 'count' users
+*  (hashes[i] is user i's hash) to a temporary file, renames it over
+*  stats.idx and maps it. Returns 0 or 1 on error. */
+static int index_create(StatsStore *store, uint64_t slotCount, const uint32_t *hashes, uint64_t count) {
+    StatsIndexHeader header;
+    StatsIndexSlot *slots;
+    uint64_t i;
+    int fd;
+    int failed;
+
+    slots = calloc(slotCount, sizeof(StatsIndexSlot));
+    if (slots == NULL) {
+        return 1;
+    }
+    for (i = 0; i < count; i++) {
+        slot_insert(slots, slotCount, hashes[i], (uint32_t) i);
+    }
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, STATS_INDEX_MAGIC, 8);
+    header.version     = STATS_INDEX_VERSION;
+    header.recordWidth = STATS_RECORD_WIDTH;
+    header.slotCount   = slotCount;
+    header.recordCount = count;
+
+    fd = open(dataPath(STATS_INDEX_FILE ".tmp"), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    failed = (fd < 0 ||
+              writeAt(fd, &header, sizeof(header), 0) != 0 ||
+              writeAt(fd, slots, slotCount * sizeof(StatsIndexSlot), sizeof(header)) != 0 ||
+              rename(dataPath(STATS_INDEX_FILE ".tmp"), dataPath(STATS_INDEX_FILE)) != 0);
+    free(slots);
+
+    if (failed) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        remove(dataPath(STATS_INDEX_FILE ".tmp"));
+        return 1;
+    }
+
+    index_unmap(store);
+    if (store->indexFd >= 0) {
+        close(store->indexFd);
+    }
+    store->indexFd = fd;
+    if (index_map(store) != 0) {
+        return 1;
+    }
+    index_note_stats(store);
+    return 0;
+}
+
+/* store_replace:
+*  Renames stats.txt.tmp over stats.txt and moves the lock to the new file,
+*  keeping it held across the swap. Returns 0 or 1 on error. */
+static int store_replace(StatsStore *store) {
+    int fd;
+
+    if (rename(dataPath(STATS_FILE ".tmp"), dataPath(STATS_FILE)) != 0 ||
+        (fd = open(dataPath(STATS_FILE), O_RDWR)) < 0) {
+        return 1;
+    }
+    flock(fd, LOCK_EX);
+    flock(store->statsFd, LOCK_UN);
+    close(store->statsFd);
+    store->statsFd = fd;
+    return 0;
+}
+
+/* index_rebuild:
+*  Reads stats.txt once, rewriting it in the padded layout if any line is
+*  not, and builds a new index. Only needed the first time, or after
+*  stats.txt was changed by something other than this module. If a name
+*  appears twice the first line wins, as it always has. Returns 0 or 1. */
+static int index_rebuild(StatsStore *store) {
+    FILE *in;
+    FILE *out = NULL;
+    char *line = NULL;
+    size_t lineSize = 0;
+    ssize_t length;
+    uint32_t *hashes = NULL;
+    uint64_t count = 0, capacity = 0, slotCount = STATS_INDEX_SLOTS;
+    int padded = 1;
+    int failed = 0;
+
+    in = fdopen(dup(store->statsFd), "r");
+    if (in == NULL) {
+        return 1;
+    }
+    rewind(in);
+
+    // First pass: is every line already a padded record?
+    while ((length = getline(&line, &lineSize, in)) > 0) {
+        if (length != STATS_RECORD_WIDTH || line[length - 1] != '\n') {
+            padded = 0;
+            break;
+        }
+    }
+    rewind(in);
+
+    if (!padded) {
+        out = fopen(dataPath(STATS_FILE ".tmp"), "w");
+        failed = (out == NULL);
+    }
+
+    // Second pass: collect each user's hash, converting lines if needed
+    while (!failed && (length = getline(&line, &lineSize, in)) > 0) {
+        Stats s;
+        char record[STATS_RECORD_WIDTH];
+
+        if (parse_record(line, (size_t) length, &s) != 0) {
+            continue;    // blank or damaged line
+        }
+        if (!padded && format_record(&s, record) != 0) {
+            continue;    // name too long for the padded layout
+        }
+
+        if (count == capacity) {
+            uint32_t *grown;
+
+            capacity = (capacity == 0) ? 1024 : capacity * 2;
+            grown = realloc(hashes, capacity * sizeof(uint32_t));
+            if (grown == NULL) {
+                failed = 1;
+                break;
+            }
+            hashes = grown;
+        }
+        hashes[count] = hashUsername(s.username);
+        count = count + 1;
+
+        if (!padded) {
+            failed = (fwrite(record, 1, STATS_RECORD_WIDTH, out) != STATS_RECORD_WIDTH);
+        }
+    }
+
+    free(line);
+    fclose(in);
+
+    // Swap the converted file in and reopen it
+    if (!padded && out != NULL) {
+        failed = (fflush(out) != 0 || fsync(fileno(out)) != 0 || failed);
+        failed = (fclose(out) != 0 || failed);
+        if (failed || store_replace(store) != 0) {
+            remove(dataPath(STATS_FILE ".tmp"));
+            free(hashes);
+            return 1;
+        }
+    }
+
+    if (failed) {
+        free(hashes);
+        return 1;
+    }
+
+    while (slotCount < count * 2) {
+        slotCount = slotCount * 2;
+    }
+    failed = index_create(store, slotCount, hashes, count);
+    free(hashes);
+    return failed;
+}
+
+/* index_matches: 1 if the mapped index describes stats.txt exactly as it is now */
+static int index_matches(const StatsStore *store) {
+    struct stat st;
+
+    if (store->header == NULL || fstat(store->statsFd, &st) != 0) {
+        return 0;
+    }
+    return store->header->statsDevice == (uint64_t) st.st_dev &&
+           store->header->statsInode == (uint64_t) st.st_ino &&
+           store->header->statsSize == (uint64_t) st.st_size &&
+           store->header->statsMtimeSec == (int64_t) st.st_mtim.tv_sec &&
+           store->header->statsMtimeNsec == (int64_t) st.st_mtim.tv_nsec &&
+           store->header->recordCount * STATS_RECORD_WIDTH == (uint64_t) st.st_size;
+}
+
+/* store_close: unmaps the index and releases the lock */
+static void store_close(StatsStore *store) {
+    index_unmap(store);
+    if (store->indexFd >= 0) {
+        close(store->indexFd);
+    }
+    if (store->statsFd >= 0) {
+        flock(store->statsFd, LOCK_UN);
+        close(store->statsFd);
+    }
+}
+
+/* store_open:
+*  Locks stats.txt, finishes any interrupted update, and makes sure the
+*  index is current. Returns 0 or 1 on error. */
+static int store_open(StatsStore *store) {
+    store->indexFd = -1;
+    store->header  = NULL;
+    store->slots   = NULL;
+
+    while (1) {
+        struct stat held, named;
+
+        store->statsFd = open(dataPath(STATS_FILE), O_RDWR | O_CREAT, 0644);
+        if (store->statsFd < 0) {
+            return 1;
+        }
+        if (flock(store->statsFd, LOCK_EX) != 0) {
+            close(store->statsFd);
+            store->statsFd = -1;
+            return 1;
+        }
+
+        // Another process may have replaced the file while we waited
+        if (fstat(store->statsFd, &held) == 0 && stat(dataPath(STATS_FILE), &named) == 0 &&
+            held.st_dev == named.st_dev && held.st_ino == named.st_ino) {
+            break;
+        }
+        flock(store->statsFd, LOCK_UN);
+        close(store->statsFd);
+    }
+
+    recover_journal(store->statsFd);
+
+    store->indexFd = open(dataPath(STATS_INDEX_FILE), O_RDWR);
+    if (store->indexFd >= 0 && index_map(store) != 0) {
+        close(store->indexFd);
+        store->indexFd = -1;
+    }
+
+    if (!index_matches(store) && index_rebuild(store) != 0) {
+        store_close(store);
+        return 1;
+    }
+    return 0;
+}
+
+/* store_find:
+*  Looks a user up through the index. Returns the record index and fills
+*  *s, or -1 if the user has no record. */
+static long store_find(StatsStore *store, const char *username, Stats *s) {
+    uint32_t hash = hashUsername(username);
+    uint64_t mask = store->header->slotCount - 1;
+    uint64_t i = hash & mask;
+    char line[STATS_RECORD_WIDTH];
+
+    while (store->slots[i].record != 0) {
+        if (store->slots[i].hash == hash) {
+            uint64_t record = store->slots[i].record - 1;
+
+            if (pread(store->statsFd, line, STATS_RECORD_WIDTH,
+                      (off_t) (record * STATS_RECORD_WIDTH)) == STATS_RECORD_WIDTH) {
+                if (parse_record(line, STATS_RECORD_WIDTH, s) == 0 && strcmp(s->username, username) == 0) {
+                    return (long) record;
+                }
+            }
+        }
+        i = (i + 1) & mask;
+    }
+    return -1;
+}
+
+/* store_write:
+*  Writes 'count' records (records[i] gets stats[i]; new ones just past the
+*  end) through the journal: every entry synced first, then the lines
+*  themselves, then the journal is emptied. Two syncs however many lines
+*  change. Returns 0 or 1 on error. */
+static int store_write(StatsStore *store, const uint64_t *records, const Stats *stats, int count) {
+    StatsJournal *entries = calloc((size_t) count, sizeof(StatsJournal));
+    int fd;
+    int failed = (entries == NULL);
+    int i;
+
+    for (i = 0; i < count && !failed; i++) {
+        StatsJournal *j = &entries[i];
+
+        failed = (format_record(&stats[i], j->record) != 0);
+        memcpy(j->magic, STATS_JOURNAL_MAGIC, 8);
+        j->offset   = records[i] * STATS_RECORD_WIDTH;
+        j->length   = STATS_RECORD_WIDTH;
+        j->checksum = checksum_bytes(j->record, j->length, j->offset);
+    }
+
+    fd = failed ? -1 : open(dataPath(STATS_JOURNAL_FILE), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        free(entries);
+        return 1;
+    }
+    failed = (writeAt(fd, entries, sizeof(StatsJournal) * (size_t) count, 0) != 0 || fsync(fd) != 0);
+
+    for (i = 0; i < count && !failed; i++) {
+        failed = writeAt(store->statsFd, entries[i].record, entries[i].length, (off_t) entries[i].offset);
+    }
+    if (!failed) {
+        failed = (fsync(store->statsFd) != 0);
+    }
+    if (!failed && ftruncate(fd, 0) != 0) {
+        failed = 1;
     }
+    close(fd);
+    free(entries);
+
+    index_note_stats(store);
+    return failed;
+}
+
+/* index_reserve:
+*  Doubles the index until 'extra' more users keep it at most half full.
+*  Returns 0 or 1 on error. */
+static int index_reserve(StatsStore *store, uint64_t extra) {
+    uint64_t records = store->header->recordCount;
+    uint64_t slotCount = store->header->slotCount;
+    uint32_t *hashes;
+    uint64_t i;
+    int failed;
+
+    if ((records + extra) * 2 <= slotCount) {
+        return 0;
+    }
+    while ((records + extra) * 2 > slotCount) {
+        slotCount = slotCount * 2;
+    }
+
+    hashes = malloc(sizeof(uint32_t) * (records + 1));
+    if (hashes == NULL) {
+        return 1;
+    }
+    for (i = 0; i < store->header->slotCount; i++) {
+        if (store->slots[i].record != 0) {
+            hashes[store->slots[i].record - 1] = store->slots[i].hash;
+        }
+    }
+    failed = index_create(store, slotCount, hashes, records);
+    free(hashes);
+    return failed;
+}
+
+/* store_append:
+*  Adds a record for a new user at the end of stats.txt and in the index,
+*  doubling the index first if it would be more than half full.
+*  Returns 0 or 1 on error. */
+static int store_append(StatsStore *store, const Stats *s) {
+    uint64_t record = store->header->recordCount;
+
+    if (index_reserve(store, 1) != 0 || store_write(store, &record, s, 1) != 0) {
+        return 1;
+    }
+    slot_insert(store->slots, store->header->slotCount, hashUsername(s->username), (uint32_t) record);
+    store->header->recordCount = record + 1;
+    index_note_stats(store);
+    return 0;
+}
+
+/* zero_stats: the record a new user starts with */
+static void zero_stats(const char *username, Stats *s) {
+    memset(s, 0, sizeof(*s));
+    strncpy(s->username, username, MAX_USERNAME - 1);
+    s->username[MAX_USERNAME - 1] = '\0';
+}
+
+/* defaultStats:
+* Creates default statistics for a new user and appends them to the stats file */
+int defaultStats(const char *username) {
+    StatsStore store;
+    Stats s;
+    int result = 0;
+
+    if (store_open(&store) != 0) {
+        return 1;
+    }
+
+    // print default stats (all zeros), unless the user already has a record
+    if (store_find(&store, username, &s) < 0) {
+        zero_stats(username, &s);
+        result = store_append(&store, &s);
+    }
+
+    store_close(&store);
+    return result;
+}
+
+
+/* loadStats:
+* Loads statistics for an existing user from the stats file into a stats struct. If user is not in the file, it returns are error */ 
+int loadStats(const char *username, Stats *s) {
+    PROFILE_SCOPE(PROFILE_LOAD_STATS);
+    StatsStore store;
+    long record;
+
+    if (store_open(&store) != 0) {
+        return 1;
+    }
+    record = store_find(&store, username, s);
+    store_close(&store);
+
+    if (record < 0) {
+        return 1; // user DNE
+    }
+    return 0;
+}
+
+/* apply_result: counts one finished game in a user's stats */
+static void apply_result(Stats *s, int won, int guessCount, long timePlayed) {
 
     // update user stats
-    s.gamesPlayed++;   
+    s->gamesPlayed++;   
 
     // if user won the game
     if (won) {
-        s.wins++;
-        s.totalGuesses += guessCount; //update guess count 
+        s->wins++;
+        s->totalGuesses += guessCount; //update guess count 
 
         if (guessCount >= 1 && guessCount <= 6) {
-            s.winsByGuess[guessCount - 1]++;     // update guess distribution
+            s->winsByGuess[guessCount - 1]++;     // update guess distribution
         }
 
         // streak = consecutive wins
-        s.currentStreak++;
-        if (s.currentStreak > s.maxStreak) {     // update max streak
-            s.maxStreak = s.currentStreak;
+        s->currentStreak++;
+        if (s->currentStreak > s->maxStreak) {     // update max streak
+            s->maxStreak = s->currentStreak;
         }
     
     // if user lost the game
     } else {
-        s.losses++;
-        s.currentStreak = 0;   // reset current streak on each loss 
-    }
-
-    s.lastPlayed = timePlayed; // record last played time
-
-    // rewrite entire stats file for all users with updated statistics
-    FILE *in = fopen(STATS_FILE, "r");   // open old file 
-    FILE *out = fopen("textFiles/new_stats.txt", "w");  // open new temporary file
-
-    // varibles for reading each stat in file
-    char name[MAX_USERNAME];
-    int wins, losses, gamesPlayed;
-    int currentStreak, maxStreak, totalGuesses;
-    long lastPlayed;
-    int w1, w2, w3, w4, w5, w6;
-
-    // read and copy each stat to the new file
-    while (fscanf(in, "%s %d %d %d %d %d %d %ld %d %d %d %d %d %d",
-                    name, &wins, &losses, &gamesPlayed, &currentStreak, 
-                    &maxStreak, &totalGuesses, &lastPlayed, &w1, &w2, &w3,
-                    &w4, &w5, &w6) == 14) {
-        
-        if (strcmp(name, username) == 0) {
-            // write updated stats for this user
-            fprintf(out, "%s %d %d %d %d %d %d %ld %d %d %d %d %d %d\n",
-                s.username,
-                s.wins, s.losses, s.gamesPlayed,
-                s.currentStreak, s.maxStreak,
-                s.totalGuesses, s.lastPlayed,
-                s.winsByGuess[0], s.winsByGuess[1], s.winsByGuess[2],
-                s.winsByGuess[3], s.winsByGuess[4], s.winsByGuess[5]);
-
-        }
-        else {
-            // copy unchnaged stats for other users
-            fprintf(out, "%s %d %d %d %d %d %d %ld %d %d %d %d %d %d\n", 
-                name,
-                wins, losses, gamesPlayed,
-                currentStreak, maxStreak,
-                totalGuesses, lastPlayed,
-                w1, w2, w3, w4, w5, w6);
+        s->losses++;
+        s->currentStreak = 0;   // reset current streak on each loss 
+    }
+
+    s->lastPlayed = timePlayed; // record last played time
+}
+
+/* updateStats:
+* updates a user's statistics after each completed game and rewrites only that user's
+* record in the stats file, so the cost does not depend on how many users there are. */
+int updateStats(const char *username, int won, int guessCount, long timePlayed) {
+    StatsUpdate update;
+
+    update.username   = username;
+    update.won        = won;
+    update.guessCount = guessCount;
+    update.timePlayed = timePlayed;
+    return updateStatsBatch(&update, 1);
+}
+
+/* updateStatsBatch:
+* counts 'count' finished games, in order, under one lock and one journal: every
+* changed record is rewritten once, and either all of the batch reaches the file
+* or (after a crash) none of it does. Returns 0, or 1 on error. */
+int updateStatsBatch(const StatsUpdate *updates, int count) {
+    PROFILE_SCOPE(PROFILE_UPDATE_STATS);
+
+    StatsStore store;
+    Stats *stats;         // each changed user's record, in first-seen order
+    uint64_t *records;    // where each of them goes
+    uint64_t firstNew;    // records from here on are new users
+    int changed = 0;
+    int added = 0;
+    int skipped = 0;
+    int result;
+    int i, j;
+
+    if (count <= 0) {
+        return 0;
+    }
+    stats = malloc(sizeof(Stats) * (size_t) count);
+    records = malloc(sizeof(uint64_t) * (size_t) count);
+    if (stats == NULL || records == NULL || store_open(&store) != 0) {
+        free(stats);
+        free(records);
+        return 1;
+    }
+    firstNew = store.header->recordCount;
+
+    for (i = 0; i < count; i++) {
+        const char *username = updates[i].username;
+
+        // a name too long for its record cannot be stored; the rest still is
+        if (strlen(username) >= MAX_USERNAME) {
+            skipped = 1;
+            continue;
+        }
+
+        // a user with several games in the batch is loaded once
+        j = changed - 1;
+        while (j >= 0 && strcmp(stats[j].username, username) != 0) {
+            j--;
         }
+
+        if (j < 0) {
+            long record = store_find(&store, username, &stats[changed]);
+
+            // if user DNE, start from a default record past the end
+            if (record < 0) {
+                zero_stats(username, &stats[changed]);
+                records[changed] = firstNew + (uint64_t) added;
+                added++;
+            } else {
+                records[changed] = (uint64_t) record;
+            }
+            j = changed++;
+        }
+        apply_result(&stats[j], updates[i].won, updates[i].guessCount, updates[i].timePlayed);
     }
 
-    fclose(in);
-    fclose(out);
+    result = index_reserve(&store, (uint64_t) added);
+    if (result == 0 && changed > 0) {
+        result = store_write(&store, records, stats, changed);
+    }
+    if (result == 0 && added > 0) {
+        for (j = 0; j < changed; j++) {
+            if (records[j] >= firstNew) {
+                slot_insert(store.slots, store.header->slotCount, hashUsername(stats[j].username),
+                            (uint32_t) records[j]);
+            }
+        }
+        store.header->recordCount = firstNew + (uint64_t) added;
+        index_note_stats(&store);
+    }
+
+    store_close(&store);
+    free(stats);
+    free(records);
+    return result || skipped;
+}
+
+
+/* tally_find:
+*  Finds a user's tally, adding an empty one if 'add' is set. Returns it,
+*  or NULL if the user has none (or memory ran out). */
+static StatsTally *tally_find(StatsTallyTable *table, const char *username, int add) {
+    uint32_t hash = hashUsername(username);
+    uint32_t i;
+
+    for (i = hash & table->mask; table->slots[i] != 0; i = (i + 1) & table->mask) {
+        StatsTally *tally = &table->tallies[table->slots[i] - 1];
+
+        if (strcmp(tally->s.username, username) == 0) {
+            return tally;
+        }
+    }
+    if (!add) {
+        return NULL;
+    }
+
+    // Keep the index at most half full
+    if ((table->count + 1) * 2 > table->mask + 1) {
+        uint32_t size = (table->mask + 1) * 2;
+        uint32_t *slots = calloc(size, sizeof(uint32_t));
+        uint32_t j;
+
+        if (slots == NULL) {
+            return NULL;
+        }
+        for (j = 0; j < table->count; j++) {
+            i = hashUsername(table->tallies[j].s.username) & (size - 1);
+            while (slots[i] != 0) {
+                i = (i + 1) & (size - 1);
+            }
+            slots[i] = j + 1;
+        }
+        free(table->slots);
+        table->slots = slots;
+        table->mask = size - 1;
+    }
+    if (table->count == table->capacity) {
+        StatsTally *grown = realloc(table->tallies, sizeof(StatsTally) * table->capacity * 2);
+
+        if (grown == NULL) {
+            return NULL;
+        }
+        table->tallies = grown;
+        table->capacity = table->capacity * 2;
+    }
+
+    i = hash & table->mask;
+    while (table->slots[i] != 0) {
+        i = (i + 1) & table->mask;
+    }
+    table->slots[i] = table->count + 1;
+    memset(&table->tallies[table->count], 0, sizeof(StatsTally));
+    zero_stats(username, &table->tallies[table->count].s);
+    table->count++;
+    return &table->tallies[table->count - 1];
+}
+
+/* tally_create / tally_add / tally_merge / tally_destroy: a StatsTallyTable as the history scanner's aggregate */
+static void *tally_create(void *arg) {
+    StatsTallyTable *table = calloc(1, sizeof(StatsTallyTable));
+
+    (void) arg;
+    if (table == NULL) {
+        return NULL;
+    }
+    table->capacity = 64;
+    table->mask = 2 * table->capacity - 1;
+    table->tallies = malloc(sizeof(StatsTally) * table->capacity);
+    table->slots = calloc(table->mask + 1, sizeof(uint32_t));
+    if (table->tallies == NULL || table->slots == NULL) {
+        free(table->tallies);
+        free(table->slots);
+        free(table);
+        return NULL;
+    }
+    return table;
+}
 
-    // Delete and replace old file with updated file
-    remove(STATS_FILE);
-    rename("textFiles/new_stats.txt", STATS_FILE);  // renames back to "stats.txt"
+static int tally_add(void *aggregate, const struct GameResult *r, void *arg) {
+    StatsTally *tally = tally_find(aggregate, r->username, 1);
+
+    (void) arg;
+    if (tally == NULL) {
+        return 1;
+    }
+    if (r->won && tally->s.losses == 0) {
+        tally->leadWins++;
+    }
+    apply_result(&tally->s, r->won, r->guesses, 0);
+    memcpy(tally->lastPlayed, r->timestamp, TIME_MAX_LEN);
+    return 0;
+}
+
+/* tally_merge: joins a user's stretch with the one just after it, including the streaks across the seam */
+static int tally_merge(void *into, void *later, void *arg) {
+    StatsTallyTable *next = later;
+    uint32_t i;
+    int g;
+
+    (void) arg;
+    for (i = 0; i < next->count; i++) {
+        const StatsTally *b = &next->tallies[i];
+        StatsTally *a = tally_find(into, b->s.username, 1);
+
+        if (a == NULL) {
+            return 1;
+        }
+        if (a->s.currentStreak + b->leadWins > a->s.maxStreak) {
+            a->s.maxStreak = a->s.currentStreak + b->leadWins;
+        }
+        if (b->s.maxStreak > a->s.maxStreak) {
+            a->s.maxStreak = b->s.maxStreak;
+        }
+        if (a->s.losses == 0) {
+            a->leadWins = a->leadWins + b->leadWins;
+        }
+        a->s.currentStreak = (b->s.losses == 0) ? a->s.currentStreak + b->s.currentStreak
+                                                : b->s.currentStreak;
+
+        a->s.wins         += b->s.wins;
+        a->s.losses       += b->s.losses;
+        a->s.gamesPlayed  += b->s.gamesPlayed;
+        a->s.totalGuesses += b->s.totalGuesses;
+        for (g = 0; g < 6; g++) {
+            a->s.winsByGuess[g] += b->s.winsByGuess[g];
+        }
+        memcpy(a->lastPlayed, b->lastPlayed, TIME_MAX_LEN);
+    }
+    return 0;
+}
 
+static void tally_destroy(void *aggregate, void *arg) {
+    StatsTallyTable *table = aggregate;
+
+    (void) arg;
+    free(table->tallies);
+    free(table->slots);
+    free(table);
+}
+
+static const HistoryScanOps tallyScan = {tally_create, tally_add, tally_merge, tally_destroy, NULL};
+
+/* tally_stats: a finished tally as a stats record; lastPlayed from the local-time "YYYY-MM-DD_HH:MM" */
+static void tally_stats(const StatsTally *tally, Stats *s) {
+    struct tm info;
+
+    *s = tally->s;
+    s->lastPlayed = 0;
+    memset(&info, 0, sizeof(info));
+    if (sscanf(tally->lastPlayed, "%d-%d-%d_%d:%d", &info.tm_year, &info.tm_mon, &info.tm_mday,
+               &info.tm_hour, &info.tm_min) == 5) {
+        info.tm_year = info.tm_year - 1900;
+        info.tm_mon = info.tm_mon - 1;
+        info.tm_isdst = -1;
+        s->lastPlayed = (long) mktime(&info);
+    }
+}
+
+/* write_tally: appends one user's record to the new stats file; returns 0 or 1 on error */
+static int write_tally(FILE *out, const Stats *s) {
+    char record[STATS_RECORD_WIDTH];
+
+    if (format_record(s, record) != 0) {
+        return 0;    // name too long for the padded layout
+    }
+    return fwrite(record, 1, STATS_RECORD_WIDTH, out) != STATS_RECORD_WIDTH;
+}
+
+/* rebuildStats:
+* Recomputes every user's stats from the game history and replaces stats.txt
+* in one rename, holding the stats lock throughout. Users keep their place
+* in the file, users with no games are reset to zero and players found only
+* in the history are added. Streaks follow history order and lastPlayed is
+* the minute of the last game. Run it while no games are being saved.
+* Returns 0, or 1 (with a message on stderr) on error. */
+int rebuildStats(void) {
+    StatsStore store;
+    StatsTallyTable *table;
+    void *scanned;
+    FILE *out;
+    uint64_t i;
+    long games = 0;
+    int players = 0;
+    int failed;
+
+    if (store_open(&store) != 0) {
+        fprintf(stderr, "Error: Cannot open %s\n", dataPath(STATS_FILE));
+        return 1;
+    }
+    if (historyScanAll(0, &tallyScan, &scanned) != 0) {
+        store_close(&store);
+        fprintf(stderr, "Error: Cannot read the game history\n");
+        return 1;
+    }
+    table = scanned;
+
+    out = fopen(dataPath(STATS_FILE ".tmp"), "w");
+    failed = (out == NULL);
+
+    // Existing users keep their record number...
+    for (i = 0; !failed && i < store.header->recordCount; i++) {
+        char line[STATS_RECORD_WIDTH];
+        StatsTally *tally;
+        Stats s;
+
+        if (pread(store.statsFd, line, STATS_RECORD_WIDTH,
+                  (off_t) (i * STATS_RECORD_WIDTH)) != STATS_RECORD_WIDTH) {
+            failed = 1;
+            break;
+        }
+        if (parse_record(line, STATS_RECORD_WIDTH, &s) != 0) {
+            continue;
+        }
+
+        tally = tally_find(table, s.username, 0);
+        if (tally != NULL && tally->saved) {
+            continue;    // a repeated name; the first line is the one in use
+        }
+        if (tally != NULL) {
+            tally_stats(tally, &s);
+            tally->saved = 1;
+        } else {
+            char name[MAX_USERNAME];
+
+            memcpy(name, s.username, MAX_USERNAME);
+            zero_stats(name, &s);
+        }
+        failed = write_tally(out, &s);
+        players++;
+    }
+
+    // ...and players who only appear in the history are added after them
+    for (i = 0; !failed && i < table->count; i++) {
+        Stats s;
+
+        if (!table->tallies[i].saved) {
+            tally_stats(&table->tallies[i], &s);
+            failed = write_tally(out, &s);
+            players++;
+        }
+        games = games + table->tallies[i].s.gamesPlayed;
+    }
+
+    if (out != NULL) {
+        failed = (fflush(out) != 0 || fsync(fileno(out)) != 0 || failed);
+        failed = (fclose(out) != 0 || failed);
+    }
+    if (failed || store_replace(&store) != 0 || index_rebuild(&store) != 0) {
+        remove(dataPath(STATS_FILE ".tmp"));
+        failed = 1;
+    }
+
+    store_close(&store);
+    tally_destroy(table, NULL);
+    if (failed) {
+        fprintf(stderr, "Error: %s was not rebuilt\n", dataPath(STATS_FILE));
+        return 1;
+    }
+    printf("Rebuilt statistics for %d players from %ld games in %s\n", players, games, dataPath(STATS_FILE));
     return 0;
 }
 
@@ -10,12 +10,6 @@
 
 #include "wordex.h"
 
-#ifdef TESTING
-    #define CLEAR_SCREEN()
-#else
-    #define CLEAR_SCREEN() system("clear")
-#endif
-
 /* printHelp: Displays the program usage and game menu information */
 void printHelp() {
     printf("\nWordex - A text-based Wordle style game\n\n");
@@ -23,6 +17,46 @@ void printHelp() {
     printf("Usage:\n");
     printf("  ./wordex           runs the wordex program\n\n");
     printf("  ./wordex --help    shows this help message and exits\n\n");
+    printf("  ./wordex --dict FILE [other options]\n");
+    printf("                     plays with the 5-letter words in FILE instead of the built-in word list;\n");
+    printf("                     works with every other option\n\n");
+    printf("  ./wordex --data-dir DIR [other options]\n");
+    printf("                     keeps accounts, history, statistics and the other game files in DIR\n");
+    printf("                     instead of textFiles; works with every other option\n\n");
+    printf("  ./wordex_profile --profile [other options]\n");
+    printf("                     times the hot paths (guess checks, drawing, history, statistics, leaderboard,\n");
+    printf("                     logins) and prints calls, p50/p90/p99 and max per function to stderr at exit;\n");
+    printf("                     needs the build from make profile\n\n");
+    printf("  ./wordex_profile --trace FILE [other options]\n");
+    printf("                     records a timeline of the session (startup, login, every turn and its phases,\n");
+    printf("                     saving results, statistics/leaderboard/history views) and writes it to FILE at\n");
+    printf("                     exit as Chrome trace-event JSON for chrome://tracing or ui.perfetto.dev\n\n");
+    printf("  ./wordex --simulate N [--threads T] [--strategy random|greedy|entropy] [--persist]\n");
+    printf("                     plays N games headlessly across T threads and reports games/sec,\n");
+    printf("                     the guess distribution and per-stage latency. --persist records\n");
+    printf("                     every game with the normal history and statistics files\n\n");
+    printf("  ./wordex --protocol jsonl\n");
+    printf("                     plays through stdin/stdout for bots: one JSON command per line (login, register,\n");
+    printf("                     new_game, guess, hint, stats, leaderboard, history, quit), one JSON response per\n");
+    printf("                     line with the pattern, keyboard and game status; see headerFiles/protocol.h\n\n");
+    printf("  ./wordex --leaderboard [N]\n");
+    printf("                     prints the leaderboard (only the top N players if N is given) and exits\n\n");
+    printf("  ./wordex --history [--limit N] [--offset K | --page P]\n");
+    printf("                     prints past games newest first: N games (20 with --page) after skipping\n");
+    printf("                     the K most recent, or page P of N games, and exits\n\n");
+    printf("  ./wordex --convert-history binary|text\n");
+    printf("                     converts the game history to the fixed-size binary log (textFiles/history.bin)\n");
+    printf("                     or back to textFiles/history.txt; the game uses history.bin while it exists\n\n");
+    printf("  ./wordex --rebuild-user-index\n");
+    printf("                     rebuilds the username index (textFiles/userprofiles.idx) from\n");
+    printf("                     textFiles/userprofiles.txt and exits\n\n");
+    printf("  ./wordex --rebuild-stats\n");
+    printf("                     recomputes the statistics of every player (textFiles/stats.txt) from the game history,\n");
+    printf("                     reading it on all CPUs, and exits\n\n");
+    printf("  ./wordex --calibrate-kdf [MS]\n");
+    printf("                     times the password hash (PBKDF2-HMAC-SHA256) on this machine and saves the\n");
+    printf("                     iteration count that takes about MS milliseconds (default 50) to textFiles/kdf.conf;\n");
+    printf("                     older password hashes are upgraded at their next login\n\n");
 
     printf("Description:\n");
     printf("  Wordex allows users to login / register, play a 5 letter wordle game, view their statistics,\n");
@@ -35,6 +69,7 @@ void printHelp() {
 
     printf("Game Menu Options:\n");
     printf("  1. Play Game            Start a new Wordex game round. You have 6 guesses to find the correct word\n");
+    printf("                          Type ? instead of a guess to get the best next guess as a hint\n");
 
     printf("  2. User Statistics      View your statistics (wins, losses, streaks, average guesses, and guess distribution)\n");
 
@@ -60,6 +95,163 @@ void printBanner() {
     printf("\n");
 }
 
+/* parseHistoryArgs:
+* Reads the --limit, --offset and --page options that follow --history.
+* Returns 0 on success, 1 and prints an error to stderr otherwise
+**/
+int parseHistoryArgs(int argc, char *argv[], long *offset, long *limit) {
+    long page = 0;
+    int i;
+
+    *offset = 0;
+    *limit = 0;
+
+    for (i = 2; i < argc; i++) {
+        long value;
+
+        if (i + 1 >= argc || sscanf(argv[i + 1], "%ld", &value) != 1 || value < 0) {
+            fprintf(stderr, "Error: %s expects a number\n", argv[i]);
+            return 1;
+        }
+
+        if (strcmp(argv[i], "--limit") == 0 && value > 0) {
+            *limit = value;
+        } else if (strcmp(argv[i], "--offset") == 0) {
+            *offset = value;
+        } else if (strcmp(argv[i], "--page") == 0 && value > 0) {
+            page = value;
+        } else {
+            fprintf(stderr, "Error: Invalid history option %s %s\n", argv[i], argv[i + 1]);
+            return 1;
+        }
+        i = i + 1;
+    }
+
+    // Pages are counted from 1 and are --limit games long
+    if (page > 0) {
+        if (*limit == 0) {
+            *limit = 20;
+        }
+        *offset = (page - 1) * *limit;
+    }
+    return 0;
+}
+
+/* findOption:
+* Returns the position of option 'name' in the arguments, or 0 if it is not there
+**/
+int findOption(int argc, char *argv[], const char *name) {
+    int i;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], name) == 0) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+/* removeArgs:
+* Takes 'count' arguments out at position 'at', shifting the rest down so every
+* other option is where it would have been without them
+**/
+void removeArgs(int *argc, char *argv[], int at, int count) {
+    memmove(&argv[at], &argv[at + count], sizeof(char *) * (size_t) (*argc - at - count + 1));
+    *argc = *argc - count;
+}
+
+/* parseDataDirArg:
+* Takes --data-dir DIR out of the arguments, wherever it is, and keeps the
+* game's files (accounts, history, statistics, ...) in DIR instead of textFiles.
+* Returns 0 on success, 1 and prints an error to stderr otherwise
+**/
+int parseDataDirArg(int *argc, char *argv[]) {
+    int i = findOption(*argc, argv, "--data-dir");
+
+    if (i == 0) {
+        return 0;
+    }
+    if (i + 1 >= *argc || setDataDir(argv[i + 1]) != 0) {
+        fprintf(stderr, "Error: --data-dir expects a directory\n");
+        return 1;
+    }
+
+    removeArgs(argc, argv, i, 2);
+    return 0;
+}
+
+/* parseDictionaryArg:
+* Takes --dict PATH out of the arguments, wherever it is, and makes the game
+* use that word list instead of the built-in one.
+* Returns 0 on success, 1 and prints an error to stderr otherwise
+**/
+int parseDictionaryArg(int *argc, char *argv[]) {
+    const Dictionary *dict;
+    int i = findOption(*argc, argv, "--dict");
+
+    if (i == 0) {
+        return 0;
+    }
+    if (i + 1 >= *argc) {
+        fprintf(stderr, "Error: --dict expects a word list file\n");
+        return 1;
+    }
+
+    setDictionaryPath(argv[i + 1]);
+    dict = getDictionary();
+    if (dict == NULL || dict->count == 0) {
+        fprintf(stderr, "Error: could not read word list %s\n", argv[i + 1]);
+        return 1;
+    }
+
+    removeArgs(argc, argv, i, 2);
+    return 0;
+}
+
+/* parseProfileArg:
+* Takes --profile out of the arguments, wherever it is, and starts the profiler,
+* which prints per-function latencies to stderr when the program exits.
+* Returns 0 on success, 1 and prints an error to stderr if the profiler is not built in
+**/
+int parseProfileArg(int *argc, char *argv[]) {
+    int i = findOption(*argc, argv, "--profile");
+
+    if (i == 0) {
+        return 0;
+    }
+    if (profileEnable() != 0) {
+        fprintf(stderr, "Error: --profile needs a build with the profiler (make profile)\n");
+        return 1;
+    }
+
+    removeArgs(argc, argv, i, 1);
+    return 0;
+}
+
+/* parseTraceArg:
+* Takes --trace FILE out of the arguments, wherever it is, and records a timeline
+* of the session that is written to FILE as Chrome trace-event JSON at exit.
+* Returns 0 on success, 1 and prints an error to stderr otherwise
+**/
+int parseTraceArg(int *argc, char *argv[]) {
+    int i = findOption(*argc, argv, "--trace");
+
+    if (i == 0) {
+        return 0;
+    }
+    if (i + 1 >= *argc) {
+        fprintf(stderr, "Error: --trace expects an output file\n");
+        return 1;
+    }
+    if (traceEnable(argv[i + 1], "wordex") != 0) {
+        fprintf(stderr, "Error: --trace needs a build with the profiler (make profile)\n");
+        return 1;
+    }
+
+    removeArgs(argc, argv, i, 2);
+    return 0;
+}
+
 /* main: 
 * Entry point of the game. Displays the login menu and provides access to the main game menu where user can play games, 
 view statistics, leaderboard, history, or quit the game.
@@ -67,12 +259,108 @@ view statistics, leaderboard, history, or quit the game.
 **/
 int main(int argc, char *argv[]) {
     
+    if (parseTraceArg(&argc, argv) != 0 || parseProfileArg(&argc, argv) != 0 ||
+        parseDataDirArg(&argc, argv) != 0 || parseDictionaryArg(&argc, argv) != 0) {
+        return 1;
+    }
+
+    // Everything up to the login prompt counts as startup
+    TRACE_BEGIN(startup);
+
     // Handles the help flag
     if (argc > 1) {
         if (strcmp(argv[1], "--help") == 0) {
             printHelp();
             return 0;
         }
+
+        // Headless capacity test: no login, no terminal
+        if (strcmp(argv[1], "--simulate") == 0) {
+            SimulationOptions options;
+
+            if (parseSimulationArgs(argc, argv, &options) != 0) {
+                return 1;
+            }
+            return runSimulation(&options);
+        }
+
+        // Machine-readable play for bots: JSON commands in, JSON responses out
+        if (strcmp(argv[1], "--protocol") == 0) {
+            if (argc < 3 || strcmp(argv[2], "jsonl") != 0) {
+                fprintf(stderr, "Error: --protocol expects jsonl\n");
+                return 1;
+            }
+            WxContext *ctx = wxOpen(NULL);
+
+            TRACE_END("startup", startup);
+            if (ctx == NULL) {
+                fprintf(stderr, "Error: could not open the game files\n");
+                return 1;
+            }
+            int failed = runProtocol(ctx, STDIN_FILENO, STDOUT_FILENO);
+
+            wxClose(ctx);
+            return failed;
+        }
+
+        // Print the rankings without logging in
+        if (strcmp(argv[1], "--leaderboard") == 0) {
+            int limit = 0;
+
+            if (argc > 2 && (sscanf(argv[2], "%d", &limit) != 1 || limit < 1)) {
+                fprintf(stderr, "Error: --leaderboard expects a positive number of players\n");
+                return 1;
+            }
+            replayResultLogs();   // games a stopped process had not applied yet
+            GetLeaderboardTop(limit);
+            return 0;
+        }
+
+        // Print the game history without logging in
+        if (strcmp(argv[1], "--history") == 0) {
+            long offset, limit;
+
+            if (parseHistoryArgs(argc, argv, &offset, &limit) != 0) {
+                return 1;
+            }
+            replayResultLogs();
+            CheckHistoryPage(offset, limit);
+            return 0;
+        }
+
+        // Switch the game history between history.txt and history.bin
+        if (strcmp(argv[1], "--convert-history") == 0) {
+            if (argc > 2 && strcmp(argv[2], "binary") == 0) {
+                return convertHistoryToBinary();
+            }
+            if (argc > 2 && strcmp(argv[2], "text") == 0) {
+                return convertHistoryToText();
+            }
+            fprintf(stderr, "Error: --convert-history expects binary or text\n");
+            return 1;
+        }
+
+        // Index accounts added to userprofiles.txt by hand or by older versions
+        if (strcmp(argv[1], "--rebuild-user-index") == 0) {
+            return rebuildAccountIndex();
+        }
+
+        // Recount stats.txt from history.txt / history.bin
+        if (strcmp(argv[1], "--rebuild-stats") == 0) {
+            replayResultLogs();
+            return rebuildStats();
+        }
+
+        // Pick the password hash work factor for this machine
+        if (strcmp(argv[1], "--calibrate-kdf") == 0) {
+            int targetMs = KDF_DEFAULT_TARGET_MS;
+
+            if (argc > 2 && (sscanf(argv[2], "%d", &targetMs) != 1 || targetMs < 1)) {
+                fprintf(stderr, "Error: --calibrate-kdf expects a positive number of milliseconds\n");
+                return 1;
+            }
+            return calibrateKdf(targetMs);
+        }
     }
 
     printBanner();
@@ -83,6 +371,7 @@ int main(int argc, char *argv[]) {
     printf("1. Login for Existing Users\n");
     printf("2. Register Account for New Users\n\n");
     printf("Please enter an option number: ");
+    TRACE_END("startup", startup);
 
     int menu;  // stores user option
 
@@ -92,14 +381,18 @@ int main(int argc, char *argv[]) {
         return 1;
     }
 
+    TRACE_BEGIN(login);
+
+    Session session;   // the signed-in player
+
     // Try to login user
     if (menu == 1) {
-        loginUser();
+        loginUser(&session);
     }
 
     // Try to register new user
     else if (menu == 2) {
-        if (registerUser() != 0) {
+        if (registerUser(&session) != 0) {
             fprintf(stderr, "\nRegistration failed\n");
             return 1;
         }
@@ -110,7 +403,18 @@ int main(int argc, char *argv[]) {
         return 1;
     }
 
-    char *user = getUsername();  // store username 
+    TRACE_END("login", login);
+
+    char *user = session.username;  // store username 
+
+    // The engine: starts the result log (games are written straight to the files if it cannot start)
+    WxContext *ctx = wxOpen(NULL);
+    uint64_t rng = wxSeed();
+
+    if (ctx == NULL) {
+        fprintf(stderr, "Error: could not open the game files\n");
+        return 1;
+    }
  
     int option;   
     int keepPlaying = 1;   // Track if loop should continue 
@@ -134,30 +438,39 @@ int main(int argc, char *argv[]) {
 
         // Option 1 - Play wordex game
         if (option == 1) {
-            char randomword[6];
-            int wordCount = 0;
+            TRACE_SCOPE("game");
             int counter = 0;
 
-            // track letter states and store user guesses
-            char lettersGreen[27] = "";
-            char lettersYellow[27] = "";
-            char lettersGray[27] = "";
-            char userGuesses[6][6] = {"", "", "", "", "", ""};
+            // the round's answer, guesses, patterns and keyboard state
+            GameState game;
 
-            setRandomWordAndCount(randomword, &wordCount);   // load a random word 
+            if (wxNewGame(ctx, &rng, &game) != WX_OK) {   // pick a random word
+                fprintf(stderr, "Error: no word list\n");
+                return 1;
+            }
 
             defaultInterface();
 
             int won = 0;   // track if user wins or loses
 
-            for (int i = 0; i < 6; i++) {
-                validateGuess(userGuesses[i], &counter);   // read and validate user's guess
+            while (!gameStateOver(&game)) {
+                TRACE_SCOPE("turn");
+                char guess[6];
+
+                TRACE_BEGIN(reading);
+                validateGuess(guess, &counter, &game);   // read and validate user's guess (or show a hint)
+                TRACE_END("readGuess", reading);
+
+                // score the guess once, then redraw board and keyboard
+                uint8_t pattern;
 
-                // update board and keyboard 
-                interface(userGuesses, &counter, randomword, lettersGreen, lettersYellow, lettersGray);
+                TRACE_BEGIN(scoring);
+                wxGuess(&game, guess, &pattern);
+                TRACE_END("scoreGuess", scoring);
+                interface(&game);
 
                 // check if guess matches the hidden word 
-                if (strcmp(userGuesses[i], randomword) == 0) {
+                if (game.won) {
                     won = 1;
                     printf("Congrats, You won in %d guesses!!\n\n", counter);
 #ifndef TESTING
@@ -169,46 +482,48 @@ int main(int argc, char *argv[]) {
 
             // If all guesses are wrong
             if (!won) {
-                printf("Game Over!, The correct word was %s\n\n", randomword);
+                printf("Game Over!, The correct word was %s\n\n", game.answerWord);
             }
 
-            // Record game results in history file 
-            logGame(user, randomword, counter, won);
-
-            // Update the user's statistics
-            time_t now = time(NULL);   // record time of played game
-
-            updateStats(user, won, counter, (long) now);
-
+            // Record game results in the history and the user's statistics
+            TRACE_BEGIN(saving);
+            wxSaveGame(ctx, user, &game, NULL, NULL);
+            TRACE_END("saveResult", saving);
 
 
             #ifndef TESTING 
                 sleep(5);
             #endif
             
-            // system("clear");
-            CLEAR_SCREEN();
+            clearScreen();
 
         }
         
         // Option 2 - View Statistics
         else if (option == 2) {
+            TRACE_SCOPE("statisticsView");
+            resultLogSync();
             printStats(user);
         }
 
         // Option 3 - View Leaderboard
         else if (option == 3) {
+            TRACE_SCOPE("leaderboardView");
+            resultLogSync();
             GetLeaderboard();
         }
 
         // Option 4 - View Game History
         else if (option == 4) {
+            TRACE_SCOPE("historyView");
+            resultLogSync();
             CheckHistory();
         }
 
         // Option 5 - Logout and Quit Game
         else if (option == 5) {
-            logoutUser();
+            logoutUser(&session);
+            wxClose(ctx);
             printf("Thanks for playing Wordex!\n\n");
             keepPlaying = 0;   // ends loop
         }
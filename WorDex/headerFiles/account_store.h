@@ -0,0 +1,80 @@
+/* account_store.h
+ *
+ * Header file for the Wordex account store.
+ * Declares the indexed lookup of user credentials in userprofiles.txt,
+ * appending new accounts, and rebuilding the index from the text file.
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#ifndef ACCOUNT_STORE_H
+#define ACCOUNT_STORE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#define ACCOUNTS_FILE       "userprofiles.txt"
+#define ACCOUNTS_INDEX_FILE "userprofiles.idx"
+
+/* Longest stored password hash, including the NUL */
+#define ACCOUNT_HASH_MAX    160
+
+/* AccountIndexHeader and AccountSlot: layout of userprofiles.idx
+ * (defined in account_store.c).
+ */
+typedef struct AccountIndexHeader AccountIndexHeader;
+typedef struct AccountSlot AccountSlot;
+
+/* AccountStore:
+ * userprofiles.txt plus its memory-mapped username index.
+ */
+typedef struct {
+    int                 fd;         // userprofiles.txt, read/append
+    int                 indexFd;
+    AccountIndexHeader *header;
+    AccountSlot        *slots;
+    size_t              mapSize;
+} AccountStore;
+
+/* accountStoreOpen:
+ * Opens the accounts file and maps its index, rebuilding the index if it
+ * is missing or does not match the file.
+ * Returns 0 on success, 1 on failure.
+ */
+int accountStoreOpen(AccountStore *store);
+
+/* accountStoreFind:
+ * Looks up 'username'; if 'hash' is not NULL the stored password hash is
+ * copied into it (ACCOUNT_HASH_MAX bytes).
+ * Returns 0 if the account exists, 1 if it does not.
+ */
+int accountStoreFind(AccountStore *store, const char *username, char *hash);
+
+/* accountStoreAdd:
+ * Appends an account to userprofiles.txt and adds it to the index.
+ * Returns 0 on success, 1 if it already exists or on failure.
+ */
+int accountStoreAdd(AccountStore *store, const char *username, const char *hash);
+
+/* accountStoreUpdate:
+ * Replaces the password hash of an existing account by appending a newer
+ * record for it, then overwrites the old record's hash on disk.
+ * Returns 0 on success, 1 if it does not exist or on failure.
+ */
+int accountStoreUpdate(AccountStore *store, const char *username, const char *hash);
+
+/* accountStoreClose:
+ * Releases the file and the index mapping.
+ */
+void accountStoreClose(AccountStore *store);
+
+/* rebuildAccountIndex:
+ * Rebuilds userprofiles.idx from userprofiles.txt and reports how many
+ * accounts it holds. Returns 0 on success, 1 on failure.
+ */
+int rebuildAccountIndex(void);
+
+#endif
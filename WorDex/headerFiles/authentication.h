@@ -15,6 +15,16 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include "kdf.h"
+
+/* Session:
+ * The signed-in player, filled in by loginUser or registerUser and
+ * cleared by logoutUser. Each front end keeps its own.
+ */
+typedef struct {
+    char username[50];
+    char hashedPassword[KDF_HASH_MAX];
+} Session;
 
 /* checkUserName:
  * Validates the format and uniqueness of a username.
@@ -23,10 +33,24 @@
 int checkUserName(char *username);
 
 /* hashPassword:
- * Applies a hashing algorithm to the plain-text password and stores
- * the result in the output buffer for secure storage.
+ * Hashes the plain-text password with PBKDF2-HMAC-SHA256 and a random
+ * salt, storing "pbkdf2$iterations$salt$key" in the output buffer
+ * (KDF_HASH_MAX bytes). Returns 0 on success, 1 on failure.
+ */
+int hashPassword(char *password, char *result);
+
+/* verifyPassword:
+ * Checks a password against a stored PBKDF2 or legacy hash.
+ * Returns 0 if it matches, 1 otherwise.
+ */
+int verifyPassword(const char *password, const char *storedHash);
+
+/* passwordProblem:
+ * Checks password strength requirements (length, character types).
+ * Returns NULL if the password is acceptable, otherwise a message
+ * describing the first requirement it misses.
  */
-void hashPassword(char *password, char *result);
+const char *passwordProblem(const char *password);
 
 /* passwordCheck:
  * Validates password strength requirements (length, character types).
@@ -36,33 +60,22 @@ int passwordCheck(char *password);
 
 /* registerUser:
  * Handles new user registration by prompting for credentials,
- * validating input, and storing the account securely.
- * Returns 1 on success, 0 on failure.
+ * validating input, and storing the account securely. On success the
+ * new account is signed in to 'session'.
+ * Returns 0 on success, 1 on failure.
  */
-int registerUser();
+int registerUser(Session *session);
 
 /* loginUser:
  * Authenticates an existing user by verifying credentials against
- * stored records.
- * Returns 1 on success, 0 on failure.
- */
-int loginUser();
-
-/* getUsername:
- * Retrieves the username of the currently logged-in user.
- * Returns pointer to username string, or NULL if not logged in.
- */
-char* getUsername();
-
-/* getPassword:
- * Retrieves the password of the currently logged-in user.
- * Returns pointer to password string, or NULL if not logged in.
+ * stored records, then signs them in to 'session'.
+ * Returns 0 on success, 1 on failure.
  */
-char* getPassword();
+int loginUser(Session *session);
 
 /* logoutUser:
- * Ends the current user session and clears session data.
+ * Ends the session and clears its data.
  */
-void logoutUser();
+void logoutUser(Session *session);
 
 #endif
\ No newline at end of file
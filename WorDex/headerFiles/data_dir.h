@@ -0,0 +1,44 @@
+/* data_dir.h
+ *
+ * Header file for the Wordex data directory.
+ * Every file the game keeps (accounts, history, statistics, the result
+ * logs, the leaderboard snapshot, kdf.conf, patterns.bin) lives in one
+ * directory, textFiles unless setDataDir names another. The modules name
+ * their files relative to it and open dataPath(name).
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#ifndef DATA_DIR_H
+#define DATA_DIR_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define DATA_DIR_DEFAULT "textFiles"
+
+/* Longest data directory accepted, without the NUL */
+#define DATA_DIR_MAX     3072
+
+/* setDataDir:
+ * Makes 'dir' the data directory. Must come before the first dataPath;
+ * naming the directory already in use again is allowed.
+ * Returns 0 if it took effect, 1 if another directory is already in use
+ * or 'dir' is too long.
+ */
+int setDataDir(const char *dir);
+
+/* dataDir:
+ * The data directory in use.
+ */
+const char *dataDir(void);
+
+/* dataPath:
+ * "<data directory>/<name>". The string is built once per name and stays
+ * valid for the life of the process, so callers may keep it. Safe to call
+ * from any thread.
+ */
+const char *dataPath(const char *name);
+
+#endif
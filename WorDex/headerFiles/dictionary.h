@@ -0,0 +1,119 @@
+/* dictionary.h
+ *
+ * Header file for the Wordex dictionary module.
+ * Declares the packed word encoding, the word list compiled into the program
+ * and the memory-mapped word store used when another list is given, shared
+ * by guess validation and answer selection.
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#ifndef DICTIONARY_H
+#define DICTIONARY_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <ctype.h>
+
+#define DICTIONARY_FILE "words.txt"
+
+#define WORD_LENGTH 5       // Letters in every playable word
+#define LETTER_BITS 5       // Bits used per letter in a packed word
+
+#define RECORD_STRIDE 6      // Bytes per word record: 5 letters + '\n'
+
+/* Slot of a packed word in a hash table of mask + 1 entries. The built-in
+ * table is generated with it, so it must not change without regenerating */
+#define DICTIONARY_SLOT(packed, mask) (((uint32_t) (packed) * 2654435761u) & (mask))
+
+/* Dictionary:
+ * A read-only word list plus an open-addressing hash table over the packed
+ * words for membership checks.
+ *
+ * The built-in list keeps its words packed in 'words' and needs no file.
+ * A list loaded from disk is mapped straight from the file instead: when it is made of fixed 6-byte records (5 letters and a newline,
+ * no blanks or repeats) offsets is NULL and word i starts at base + 6 * i.
+ * Otherwise offsets holds the start of every distinct word, built once
+ * when the file is indexed. Either way picking word i is O(1).
+ * Empty table slots hold 0, which is never a valid packed word.
+ */
+typedef struct {
+    const uint32_t *words;   // packed words in order, NULL for a mapped file
+    const char     *base;    // mapped word list
+    size_t          size;    // bytes mapped
+    uint32_t       *offsets; // per-word offsets, NULL for fixed-stride files
+    int             count;   // number of distinct words
+    const uint32_t *table;   // open-addressing table of packed words
+    uint32_t        mask;    // table size - 1 (table size is a power of two)
+} Dictionary;
+
+/* The built-in word list: DICTIONARY_FILE sorted, deduplicated and hashed
+ * into functionFiles/dictionary_data.c by tools/embed_dictionary at build
+ * time. embeddedTable has embeddedMask + 1 slots. */
+extern const int embeddedWordCount;
+extern const uint32_t embeddedWords[];
+extern const uint32_t embeddedMask;
+extern const uint32_t embeddedTable[];
+
+/* packWord:
+ * Packs a 5-letter word into 25 bits, 5 bits per letter with 'a' = 1,
+ * letter i stored at bit 5 * i. Letters are matched case-insensitively.
+ * Returns the packed value, or 0 if the word is not exactly 5 letters.
+ */
+uint32_t packWord(const char *word);
+
+/* unpackWord:
+ * Writes the lowercase, NUL-terminated word for a packed value into out,
+ * which must hold at least 6 characters.
+ */
+void unpackWord(uint32_t packed, char *out);
+
+/* getDictionary:
+ * Returns the shared dictionary: the built-in word list, or the file given
+ * to setDictionaryPath, loaded on first use.
+ * Returns NULL if that file could not be read.
+ */
+const Dictionary *getDictionary(void);
+
+/* setDictionaryPath:
+ * Makes getDictionary load the word list at 'path' instead of using the
+ * built-in one. Only has an effect before the first getDictionary call.
+ * Returns 0 if it took effect, 1 if the dictionary was already in use.
+ */
+int setDictionaryPath(const char *path);
+
+/* dictionaryContains:
+ * Returns 1 if the packed word is in the dictionary, 0 otherwise.
+ */
+int dictionaryContains(const Dictionary *dict, uint32_t packed);
+
+/* dictionaryWordAt:
+ * Copies word 'index' (0 <= index < count) into out as a lowercase,
+ * NUL-terminated string. out must hold at least 6 characters.
+ */
+void dictionaryWordAt(const Dictionary *dict, int index, char *out);
+
+/* dictionaryPackedAt:
+ * Returns the packed form of word 'index' without copying it out.
+ */
+uint32_t dictionaryPackedAt(const Dictionary *dict, int index);
+
+/* dictionaryHash:
+ * 64-bit FNV-1a hash of the packed words in dictionary order. Files derived
+ * from the word list (such as the pattern matrix) record it so they can
+ * tell when the list has changed.
+ */
+uint64_t dictionaryHash(const Dictionary *dict);
+
+/* loadDictionary / freeDictionary:
+ * Map and index, or unmap and release, an arbitrary word list file (the
+ * built-in list is never freed).
+ * loadDictionary returns 0 on success, 1 if the file could not be read.
+ */
+int loadDictionary(const char *path, Dictionary *dict);
+void freeDictionary(Dictionary *dict);
+
+#endif
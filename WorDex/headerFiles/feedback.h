@@ -0,0 +1,54 @@
+/* feedback.h
+ *
+ * Header file for the Wordex feedback scoring module.
+ * Declares the kernel that scores a packed guess against a packed answer
+ * and returns the whole green/yellow/gray row as one base-3 pattern code.
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#ifndef FEEDBACK_H
+#define FEEDBACK_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "dictionary.h"
+
+/* Pattern codes:
+ * Position i contributes digit * 3^i where the digit is 0 for gray,
+ * 1 for yellow and 2 for green, so every row fits in 0 - 242.
+ */
+#define PATTERN_COUNT 243
+#define PATTERN_WIN   242     // all five letters green
+
+#define DIGIT_GRAY   0
+#define DIGIT_YELLOW 1
+#define DIGIT_GREEN  2
+
+/* scoreGuess:
+ * Scores one packed guess against one packed answer. Duplicate letters are
+ * handled exactly like the two-pass board colouring: greens are claimed
+ * first, then yellows left to right while unclaimed copies remain.
+ * Returns the pattern code (0 - 242).
+ */
+uint8_t scoreGuess(uint32_t guess, uint32_t answer);
+
+/* scoreBatch:
+ * Scores one guess against n answers, writing one pattern code per answer.
+ * Uses AVX2 or SSE2 when the CPU supports them, the scalar kernel otherwise.
+ */
+void scoreBatch(uint32_t guess, const uint32_t *answers, size_t n, uint8_t *out);
+
+/* scoreBatchScalar:
+ * Portable reference version of scoreBatch.
+ */
+void scoreBatchScalar(uint32_t guess, const uint32_t *answers, size_t n, uint8_t *out);
+
+/* patternDigit:
+ * Returns the digit (DIGIT_GRAY / DIGIT_YELLOW / DIGIT_GREEN) for one position.
+ */
+int patternDigit(uint8_t pattern, int position);
+
+#endif
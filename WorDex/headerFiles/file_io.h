@@ -0,0 +1,68 @@
+/* file_io.h
+ *
+ * Header file for the Wordex write helpers.
+ * write and pwrite may put down fewer bytes than asked, or be interrupted
+ * by a signal; every module that writes a buffer in one call loops through
+ * these instead. They are defined here, inline, like random.h, so every
+ * program gets them without linking another file.
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#ifndef FILE_IO_H
+#define FILE_IO_H
+
+#include <stddef.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/types.h>
+
+/* writeAll:
+ * Writes all 'length' bytes at the file position, retrying short and
+ * interrupted writes.
+ * Returns 0 on success, 1 on error.
+ */
+static inline int writeAll(int fd, const void *data, size_t length) {
+    const char *bytes = data;
+
+    while (length > 0) {
+        ssize_t put = write(fd, bytes, length);
+
+        if (put < 0 && errno == EINTR) {
+            continue;
+        }
+        if (put <= 0) {
+            return 1;
+        }
+        bytes = bytes + put;
+        length = length - (size_t) put;
+    }
+    return 0;
+}
+
+/* writeAt:
+ * pwrite of all 'length' bytes at 'offset', retrying short and
+ * interrupted writes.
+ * Returns 0 on success, 1 on error.
+ */
+static inline int writeAt(int fd, const void *data, size_t length, off_t offset) {
+    const char *bytes = data;
+
+    while (length > 0) {
+        ssize_t put = pwrite(fd, bytes, length, offset);
+
+        if (put < 0 && errno == EINTR) {
+            continue;
+        }
+        if (put <= 0) {
+            return 1;
+        }
+        bytes = bytes + put;
+        length = length - (size_t) put;
+        offset = offset + put;
+    }
+    return 0;
+}
+
+#endif
@@ -17,6 +17,41 @@
 #include <time.h>
 #include <stdbool.h>
 #include <ctype.h>
+#include "dictionary.h"
+#include "feedback.h"
+
+#define MAX_GUESSES 6   // Guesses allowed per game
+#define HINT_KEY    "?" // Typed instead of a guess to ask for a hint
+
+/* checkGuess results */
+#define GUESS_OK         0
+#define GUESS_BAD_LENGTH 1   // not 5 characters
+#define GUESS_NOT_A_WORD 2   // not in the word list
+
+/* letterBit:
+ * Keyboard mask bit for a lowercase letter ('a' is bit 0).
+ */
+#define letterBit(c) ((uint32_t) 1 << ((c) - 'a'))
+
+/* GameState:
+ * Everything about one round. Each guess is scored once when it is
+ * submitted; the keyboard is kept as three 26-bit letter masks that are
+ * updated incrementally. Rendering only reads this struct, and the same
+ * struct can drive a game with no terminal at all.
+ */
+typedef struct {
+    char     answerWord[6];
+    uint32_t answer;                    // packed answer
+    uint32_t answerLetters;             // mask of letters in the answer
+    char     guessWords[MAX_GUESSES][6];
+    uint32_t guesses[MAX_GUESSES];      // packed guesses
+    uint8_t  patterns[MAX_GUESSES];     // pattern code of each guess
+    int      guessCount;
+    int      won;
+    uint32_t keysGreen;                 // letters found in the right place
+    uint32_t keysYellow;                // letters known to be in the word
+    uint32_t keysGray;                  // letters known not to be in the word
+} GameState;
 
 /* setRandomWordAndCount:
  * Selects a random 5-letter word from the word list and initializes
@@ -30,22 +65,47 @@ void setRandomWordAndCount(char *randomWord, int *count);
  */
 void convertToLower(char *str);
 
+/* defaultInterface:
+ * Displays the initial empty game board at the start of a new game.
+ */
+void defaultInterface();
+
+/* checkGuess:
+ * Checks a typed guess without reading or printing anything: it must be
+ * 5 letters and in the word list. On GUESS_OK the lowercased word is
+ * copied to 'word' (6 bytes).
+ * Returns GUESS_OK, GUESS_BAD_LENGTH or GUESS_NOT_A_WORD.
+ */
+int checkGuess(const char *typed, char *word);
+
 /* validateGuess:
  * Checks if the user's guess is valid (correct length, alphabetic characters)
- * and updates the guess counter accordingly.
+ * and updates the guess counter accordingly. Typing HINT_KEY prints a hint
+ * for 'game' instead of using up a guess.
  */
-void validateGuess(char *setWord, int *counter);
+void validateGuess(char *setWord, int *counter, const GameState *game);
 
-/* defaultInterface:
- * Displays the initial empty game board at the start of a new game.
+/* gameStateInit:
+ * Resets a GameState for a new round with the given answer.
  */
-void defaultInterface();
+void gameStateInit(GameState *game, const char *answer);
+
+/* gameStateSubmit:
+ * Scores a validated guess once, stores its pattern and updates the
+ * keyboard masks. Returns the pattern code.
+ */
+uint8_t gameStateSubmit(GameState *game, const char *guess);
+
+/* gameStateOver:
+ * Returns 1 once the game is won or out of guesses.
+ */
+int gameStateOver(const GameState *game);
 
 /* interface:
  * Renders the current game state including all previous guesses with
  * color-coded feedback (green for correct position, yellow for wrong position,
  * gray for not in word) and displays tracked letter states.
  */
-void interface(char userGuesses[][6], int *counter, char *randomWord, char *lettersGreen, char *lettersYellow, char *lettersGray);
+void interface(const GameState *game);
 
 #endif
\ No newline at end of file
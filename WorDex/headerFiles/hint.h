@@ -0,0 +1,53 @@
+/* hint.h
+ *
+ * Header file for the Wordex hint engine.
+ * Declares the functions that narrow the answer candidates from the feedback
+ * given so far and suggest the guess with the highest expected information.
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#ifndef HINT_H
+#define HINT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "dictionary.h"
+#include "feedback.h"
+#include "patterns.h"
+#include "game_logic.h"
+
+/* Hint:
+ * A suggested next guess and how much it is expected to reveal.
+ */
+typedef struct {
+    int    guessIndex;     // dictionary index of the suggested guess
+    char   word[6];        // the suggested guess
+    double entropy;        // expected information in bits
+    int    candidates;     // answers still consistent with the feedback
+} Hint;
+
+/* filterCandidates:
+ * Writes into 'out' the dictionary index of every word that would have
+ * produced exactly the patterns recorded in 'game'. 'out' must hold
+ * dict->count entries. Returns the number of candidates.
+ */
+int filterCandidates(const Dictionary *dict, const GameState *game, int *out);
+
+/* bestGuess:
+ * Scores every dictionary word by the entropy of the pattern distribution
+ * it would produce over the remaining candidates, spread over 'threads'
+ * worker threads (values < 1 mean one per online CPU).
+ * Returns 0 and fills 'hint' on success, 1 if there is nothing to suggest.
+ */
+int bestGuess(const Dictionary *dict, const GameState *game, int threads, Hint *hint);
+
+/* printHint:
+ * Computes and prints a hint for the game in progress.
+ * Returns what printf returned for the line (its length, newline included).
+ */
+int printHint(const GameState *game);
+
+#endif
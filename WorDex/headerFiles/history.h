@@ -38,10 +38,33 @@ struct GameResult {
 
 void logGame(const char *username, const char *word, int guesses, int won);
 
+/* logGames:
+ * Records 'count' finished games, game i having ended at times[i], with
+ * one write, and syncs the history before returning.
+ * Returns 0 on success, 1 on failure.
+ */
+
+int logGames(const struct GameResult *games, const time_t *times, int count);
+
 /* CheckHistory:
  * Prints the full game history table to terminal.
  */
 
 void CheckHistory(void);
 
+/* CheckHistoryPage:
+ * Prints up to 'limit' games (all when limit <= 0), newest first, after
+ * skipping the 'offset' most recent ones.
+ */
+
+void CheckHistoryPage(long offset, long limit);
+
+/* ReadHistoryPage:
+ * Fills 'out' with up to 'limit' games, newest first, after skipping the
+ * 'offset' most recent ones, for callers that format them themselves.
+ * Returns the number of games stored.
+ */
+
+long ReadHistoryPage(long offset, long limit, struct GameResult *out);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,104 @@
+/* history_binary.h
+ *
+ * Header file for the optional binary game history log.
+ * Declares the fixed-size record format, the functions to append to and
+ * read from textFiles/history.bin, and the converters to and from the
+ * text history.txt format.
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#ifndef HISTORY_BINARY_H
+#define HISTORY_BINARY_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include "history.h"
+
+#define HISTORY_BINARY_FILE    "history.bin"
+#define HISTORY_NAMES_FILE     "history.names"
+
+/* File layout: a HISTORY_HEADER_SIZE byte header (magic, version, record
+ * size, header size; little-endian) followed by HISTORY_RECORD_SIZE byte
+ * records, so record N starts at HISTORY_HEADER_SIZE + N * HISTORY_RECORD_SIZE.
+ */
+#define HISTORY_BINARY_MAGIC   "WXHIST1"
+#define HISTORY_BINARY_VERSION 1
+#define HISTORY_HEADER_SIZE    32
+#define HISTORY_RECORD_SIZE    24
+
+/* HistoryRecord:
+ * One finished game as stored in history.bin.
+ * Record bytes: userId (u32), word (u32), when (i64), guesses (u8),
+ * won (u8), 6 reserved zero bytes.
+ */
+typedef struct {
+    uint32_t userId;    // line number of the username in history.names
+    uint32_t word;      // 5 bits per letter like packWord (0 = no letter),
+                        // bits 25-29 mark letters that were upper case
+    int64_t  when;      // epoch seconds, on a whole minute
+    uint8_t  guesses;
+    uint8_t  won;
+} HistoryRecord;
+
+/* HistoryLog:
+ * An open history.bin for random access by record index.
+ */
+typedef struct {
+    int  fd;
+    long count;         // whole records in the file when it was opened
+} HistoryLog;
+
+/* historyBinaryEnabled:
+ * Returns 1 if the binary log is in use (history.bin exists), 0 otherwise.
+ */
+int historyBinaryEnabled(void);
+
+/* historyLogOpen:
+ * Opens and checks the header of a binary history file.
+ * Returns 0 on success, 1 if it is missing or not a valid log.
+ */
+int historyLogOpen(HistoryLog *log, const char *path);
+
+/* historyLogRead:
+ * Reads up to 'n' records starting at record index 'first' with one pread.
+ * Returns the number of records read.
+ */
+long historyLogRead(const HistoryLog *log, long first, long n, HistoryRecord *out);
+
+/* historyLogClose:
+ * Closes a log opened with historyLogOpen.
+ */
+void historyLogClose(HistoryLog *log);
+
+/* historyLogAppend:
+ * Appends one game to history.bin with a single O_APPEND write, adding the
+ * username to history.names if it is new.
+ * Returns 0 on success, 1 on failure.
+ */
+int historyLogAppend(const struct GameResult *r, time_t when);
+
+/* historyRecordToResult:
+ * Fills a GameResult (username, word, text timestamp) from a record.
+ * Returns 0 on success, 1 if the record's user id is unknown.
+ */
+int historyRecordToResult(const HistoryRecord *record, struct GameResult *r);
+
+/* convertHistoryToBinary:
+ * Writes history.txt as history.bin and history.names, checking that every
+ * record converts back to exactly the same text. history.txt is kept.
+ * Returns 0 on success, 1 (with a message on stderr) otherwise.
+ */
+int convertHistoryToBinary(void);
+
+/* convertHistoryToText:
+ * Writes history.bin back as history.txt and renames history.bin to
+ * history.bin.old, so the text history is used again.
+ * Returns 0 on success, 1 (with a message on stderr) otherwise.
+ */
+int convertHistoryToText(void);
+
+#endif
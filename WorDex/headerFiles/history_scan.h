@@ -0,0 +1,79 @@
+/* history_scan.h
+ *
+ * Header file for the parallel game history scanner.
+ * Folds every game in the history into a caller-defined aggregate (per
+ * player totals for the leaderboard, per user statistics, per word
+ * analytics) on many threads at once: the history is split into one chunk
+ * per worker, each worker adds its games to an aggregate of its own, and
+ * the aggregates are merged pairwise, in history order, until one is left.
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#ifndef HISTORY_SCAN_H
+#define HISTORY_SCAN_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "history.h"
+#include "history_binary.h"
+
+/* Most workers a scan uses */
+#define HISTORY_SCAN_MAX_THREADS 64
+
+/* Least history per worker; a smaller history is scanned on fewer threads,
+ * down to the calling thread alone */
+#define HISTORY_SCAN_MIN_CHUNK   (1 << 20)
+
+/* HistoryScanOps:
+ * The aggregate a scan builds. Each worker gets one from create, feeds it
+ * its chunk's games in order through add, and merge folds the aggregate of
+ * the chunk just after into it, so a merge always sees 'later' holding
+ * games played after those in 'into' (streaks and "last played" can be
+ * kept). 'later' is destroyed by the scan after merging. add and merge
+ * return 0, or 1 if memory ran out; create returns NULL then.
+ */
+typedef struct {
+    void *(*create)(void *arg);
+    int   (*add)(void *aggregate, const struct GameResult *r, void *arg);
+    int   (*merge)(void *into, void *later, void *arg);
+    void  (*destroy)(void *aggregate, void *arg);
+    void  *arg;
+} HistoryScanOps;
+
+/* historyScanThreads:
+ * The workers a scan uses by default: one per online CPU, at most
+ * HISTORY_SCAN_MAX_THREADS.
+ */
+int historyScanThreads(void);
+
+/* historyScanText:
+ * Scans the whole lines of history.txt (open as 'fd') from byte 'start',
+ * which must be the start of a line, on up to 'threads' workers (0 for
+ * historyScanThreads()). Lines that are not a full record are skipped.
+ * On success *result is the aggregate and *end the offset just past the
+ * last '\n'; an unterminated last line is left to the caller.
+ * Returns 0 on success, 1 if the file could not be mapped or memory ran out.
+ */
+int historyScanText(int fd, uint64_t start, int threads, const HistoryScanOps *ops,
+                    void **result, uint64_t *end);
+
+/* historyScanBinary:
+ * Same for records [first, log->count) of an open history.bin. Records of
+ * unknown users are skipped.
+ * Returns 0 on success, 1 if memory ran out.
+ */
+int historyScanBinary(const HistoryLog *log, long first, int threads, const HistoryScanOps *ops,
+                      void **result);
+
+/* historyScanAll:
+ * Scans every game in the history in use (history.bin when the binary
+ * log is enabled, history.txt otherwise, an unterminated last line
+ * included). A missing history gives an empty aggregate.
+ * Returns 0 on success, 1 on error.
+ */
+int historyScanAll(int threads, const HistoryScanOps *ops, void **result);
+
+#endif
@@ -0,0 +1,84 @@
+/* kdf.h
+ *
+ * Header file for the Wordex password key derivation.
+ * Declares SHA-256, HMAC-SHA256 and PBKDF2-HMAC-SHA256 (implemented in
+ * kdf.c, no external library), the stored password format, and the
+ * calibration of the iteration count for this machine.
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#ifndef KDF_H
+#define KDF_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#define KDF_CONFIG_FILE        "kdf.conf"
+
+/* Stored passwords look like "pbkdf2$<iterations>$<salt hex>$<key hex>" */
+#define KDF_PREFIX             "pbkdf2$"
+#define KDF_SALT_BYTES         16
+#define KDF_KEY_BYTES          32
+
+/* Used until --calibrate-kdf writes KDF_CONFIG_FILE, and the lowest
+ * iteration count a configuration may ask for.
+ */
+#define KDF_DEFAULT_ITERATIONS 100000
+#define KDF_MIN_ITERATIONS     10000
+
+/* Login latency --calibrate-kdf aims for when not given one */
+#define KDF_DEFAULT_TARGET_MS  50
+
+/* Longest stored password string, including the NUL */
+#define KDF_HASH_MAX           160
+
+/* sha256:
+ * SHA-256 digest of 'length' bytes of 'data' into 'digest'.
+ */
+void sha256(const uint8_t *data, size_t length, uint8_t digest[32]);
+
+/* pbkdf2HmacSha256:
+ * PBKDF2 (RFC 8018) with HMAC-SHA256; writes 'keyLength' bytes to 'key'.
+ */
+void pbkdf2HmacSha256(const uint8_t *password, size_t passwordLength,
+                      const uint8_t *salt, size_t saltLength,
+                      uint32_t iterations, uint8_t *key, size_t keyLength);
+
+/* kdfIterations:
+ * The iteration count new hashes use: KDF_CONFIG_FILE if it holds a valid
+ * one, KDF_DEFAULT_ITERATIONS otherwise. The file is read on the first
+ * call only.
+ */
+uint32_t kdfIterations(void);
+
+/* kdfHash:
+ * Hashes 'password' with a fresh random salt and kdfIterations() into
+ * 'out' (KDF_HASH_MAX bytes) in the stored format.
+ * Returns 0 on success, 1 if no random salt could be read.
+ */
+int kdfHash(const char *password, char *out);
+
+/* kdfVerify:
+ * Checks 'password' against a stored "pbkdf2$..." string.
+ * Returns 0 if it matches, 1 if it does not or the string is malformed.
+ */
+int kdfVerify(const char *password, const char *stored);
+
+/* kdfNeedsUpgrade:
+ * Returns 1 if 'stored' is not a PBKDF2 hash or uses fewer iterations
+ * than kdfIterations(), 0 otherwise.
+ */
+int kdfNeedsUpgrade(const char *stored);
+
+/* calibrateKdf:
+ * Times PBKDF2 on this machine, picks the iteration count that takes about
+ * 'targetMs' milliseconds per login and saves it to KDF_CONFIG_FILE.
+ * Returns 0 on success, 1 on failure.
+ */
+int calibrateKdf(int targetMs);
+
+#endif
@@ -16,11 +16,6 @@
 #include <string.h>
 #include "history.h"
 
-/* Maximum number of distinct players that can appear
- * on the leaderboard at once.
- */
-#define MAX_USERS 100       
-
 /* LeaderboardEntry:
  * Stores aggregate statistics for a single player.
 */
@@ -40,4 +35,17 @@ struct LeaderboardEntry {
  */
 void GetLeaderboard(void);
 
+/* GetLeaderboardTop:
+ * Same as GetLeaderboard, but prints only the best 'limit' players
+ * (all of them when limit <= 0).
+ */
+void GetLeaderboardTop(int limit);
+
+/* ReadLeaderboardTop:
+ * Ranks the best 'limit' players (all of them when limit <= 0) into a
+ * malloc'd array for callers that format it themselves; the caller frees
+ * *entries. Returns the number of players, or -1 if memory ran out.
+ */
+int ReadLeaderboardTop(int limit, struct LeaderboardEntry **entries);
+
 #endif 
\ No newline at end of file
@@ -0,0 +1,161 @@
+/* libwordex.h
+ *
+ * Header file for libwordex, the Wordex engine as a library (make
+ * libwordex builds libwordex.a and libwordex.so).
+ * Everything goes through an explicit context or game instead of globals
+ * and the terminal: nothing here reads stdin or prints. Games are plain
+ * GameState structs owned by the caller, so any number can be played at
+ * once on any threads. Accounts, saving results and the stats,
+ * leaderboard and history queries are safe to call from any thread.
+ *
+ * The files behind a context live in one data directory, and the word
+ * list is shared, so every context in a process must agree on both.
+ *
+ *   WxConfig config = {"/srv/wordex", NULL};
+ *   WxContext *ctx = wxOpen(&config);
+ *   uint64_t rng = wxSeed();
+ *   GameState game;
+ *   uint8_t pattern;
+ *
+ *   wxNewGame(ctx, &rng, &game);
+ *   while (wxGuess(&game, next_word(), &pattern) == WX_OK && !gameStateOver(&game)) ...
+ *   wxSaveGame(ctx, "amy", &game, NULL, NULL);
+ *   wxClose(ctx);
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#ifndef LIBWORDEX_H
+#define LIBWORDEX_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "game_logic.h"
+#include "hint.h"
+#include "statistics.h"
+#include "leaderboard.h"
+#include "history.h"
+#include "result_log.h"
+
+/* WxStatus: what a call did; wxStatusMessage describes each */
+typedef enum {
+    WX_OK = 0,
+    WX_ERROR,               // out of memory, or the files could not be used
+    WX_BAD_WORD,            // a guess that is not 5 letters
+    WX_NOT_IN_LIST,         // a guess that is not in the word list
+    WX_GAME_OVER,           // a guess after the game was won or lost
+    WX_GAME_NOT_OVER,       // saving a game still in progress
+    WX_UNKNOWN_USER,
+    WX_WRONG_PASSWORD,
+    WX_BAD_USERNAME,
+    WX_WEAK_PASSWORD,       // see passwordProblem for the exact rule missed
+    WX_USERNAME_TAKEN
+} WxStatus;
+
+/* WxConfig:
+ * How to open a context. A NULL field keeps what the process already
+ * uses: DATA_DIR_DEFAULT and the built-in word list unless setDataDir or
+ * setDictionaryPath (or an earlier context) chose others.
+ */
+typedef struct {
+    const char *dataDir;    // directory holding the game's files
+    const char *dictPath;   // word list file
+} WxConfig;
+
+/* WxContext: an open engine (defined in libwordex.c) */
+typedef struct WxContext WxContext;
+
+/* wxOpen:
+ * Opens the engine on the configured data directory and word list and
+ * starts the result log the first time. 'config' may be NULL. If the log
+ * cannot be started (a message goes to stderr) the context still opens
+ * and saved games are written straight to the files.
+ * Returns the context, or NULL if the word list cannot be loaded or the
+ * configuration differs from that of a context already open.
+ */
+WxContext *wxOpen(const WxConfig *config);
+
+/* wxClose:
+ * Waits until every saved game is in the history and statistics files
+ * and frees the context.
+ */
+void wxClose(WxContext *ctx);
+
+/* wxStatusMessage:
+ * A short lowercase description of 'status'.
+ */
+const char *wxStatusMessage(WxStatus status);
+
+/* wxSeed:
+ * A seed for the random state wxNewGame advances, different per call.
+ */
+uint64_t wxSeed(void);
+
+/* wxLogin:
+ * Checks a password, upgrading a hash stored with an older work factor.
+ * Returns WX_OK, WX_UNKNOWN_USER, WX_WRONG_PASSWORD or WX_ERROR.
+ */
+WxStatus wxLogin(WxContext *ctx, const char *username, const char *password);
+
+/* wxRegister:
+ * Creates an account. Usernames are 1 to 31 letters, digits, '_', '-'
+ * or '.'; passwords follow passwordProblem.
+ * Returns WX_OK, WX_BAD_USERNAME, WX_WEAK_PASSWORD, WX_USERNAME_TAKEN or
+ * WX_ERROR.
+ */
+WxStatus wxRegister(WxContext *ctx, const char *username, const char *password);
+
+/* wxNewGame:
+ * Starts 'game' with an answer drawn using '*rng' (xorshift state, never
+ * 0; see wxSeed), which it advances. Builds with -DTESTING always pick
+ * "banes".
+ * Returns WX_OK, or WX_ERROR if there is no word list.
+ */
+WxStatus wxNewGame(WxContext *ctx, uint64_t *rng, GameState *game);
+
+/* wxGuess:
+ * Scores a guess (any case) and stores its pattern code in '*pattern';
+ * gameStateOver(game) and game->won tell whether the game ended.
+ * Returns WX_OK, WX_BAD_WORD, WX_NOT_IN_LIST or WX_GAME_OVER.
+ */
+WxStatus wxGuess(GameState *game, const char *word, uint8_t *pattern);
+
+/* wxHint:
+ * The highest-information next guess for 'game'.
+ * Returns WX_OK, WX_GAME_OVER or WX_ERROR.
+ */
+WxStatus wxHint(const GameState *game, Hint *hint);
+
+/* wxSaveGame:
+ * Records a finished game for 'username' through the result log. With
+ * done == NULL it returns once the game is on disk; otherwise it returns
+ * at once and done(context, status) follows (see result_log.h).
+ * Returns WX_OK, WX_GAME_NOT_OVER or WX_ERROR; with a 'done' a failure
+ * to save is only reported through it.
+ */
+WxStatus wxSaveGame(WxContext *ctx, const char *username, const GameState *game,
+                    ResultLogDone done, void *context);
+
+/* wxStats:
+ * The statistics of 'username', all zero for a player with no games.
+ * Returns WX_OK.
+ */
+WxStatus wxStats(WxContext *ctx, const char *username, Stats *stats);
+
+/* wxLeaderboard:
+ * The best 'limit' players (every player if limit <= 0) in a malloc'd
+ * array the caller frees.
+ * Returns how many there are, or -1 on error.
+ */
+int wxLeaderboard(WxContext *ctx, int limit, struct LeaderboardEntry **entries);
+
+/* wxHistory:
+ * Up to 'limit' games, newest first, after skipping the 'offset' most
+ * recent, into 'out'.
+ * Returns how many were written.
+ */
+long wxHistory(WxContext *ctx, long offset, long limit, struct GameResult *out);
+
+#endif
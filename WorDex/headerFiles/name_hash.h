@@ -0,0 +1,31 @@
+/* name_hash.h
+ *
+ * Header file for the Wordex username hash.
+ * The account index, the statistics index, the leaderboard and the
+ * history's name cache all find players by the FNV-1a hash of their
+ * username. userprofiles.idx and stats.idx store slots placed by it, so
+ * it must not change without rebuilding them.
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#ifndef NAME_HASH_H
+#define NAME_HASH_H
+
+#include <stdint.h>
+
+/* hashUsername:
+ * FNV-1a hash of a NUL-terminated username.
+ */
+static inline uint32_t hashUsername(const char *username) {
+    uint32_t h = 2166136261u;
+
+    while (*username != '\0') {
+        h = (h ^ (unsigned char) *username) * 16777619u;
+        username++;
+    }
+    return h;
+}
+
+#endif
@@ -0,0 +1,77 @@
+/* patterns.h
+ *
+ * Header file for the Wordex pattern matrix module.
+ * Declares the precomputed guess x answer pattern table that is built by
+ * `make patterns` and memory-mapped read-only at runtime.
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#ifndef PATTERNS_H
+#define PATTERNS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "dictionary.h"
+#include "feedback.h"
+
+#define PATTERNS_FILE    "patterns.bin"
+#define PATTERNS_MAGIC   "WXPATTN"    // 7 characters + NUL
+#define PATTERNS_VERSION 1
+#define PATTERNS_HEADER  64           // bytes before the first cell
+
+/* PatternFileHeader:
+ * First bytes of patterns.bin. The matrix follows at offset PATTERNS_HEADER
+ * as wordCount * wordCount bytes, row = guess index, column = answer index.
+ */
+typedef struct {
+    char     magic[8];
+    uint32_t version;
+    uint32_t wordCount;
+    uint64_t dictHash;       // dictionaryHash() of the list it was built from
+} PatternFileHeader;
+
+/* PatternMatrix:
+ * A mapped pattern file. cells[g * count + a] is the pattern for guess g
+ * against answer a, using dictionary word indices.
+ */
+typedef struct {
+    const uint8_t *cells;
+    int            count;
+    void          *map;
+    size_t         mapSize;
+} PatternMatrix;
+
+/* buildPatternMatrix:
+ * Scores every (guess, answer) pair of dict across 'threads' worker threads
+ * and writes the result to 'path'. Returns 0 on success, 1 on failure.
+ */
+int buildPatternMatrix(const Dictionary *dict, const char *path, int threads);
+
+/* openPatternMatrix:
+ * Maps 'path' read-only and checks it was built from dict.
+ * Returns 0 on success, 1 if the file is missing or unreadable,
+ * 2 if it belongs to a different word list.
+ */
+int openPatternMatrix(const char *path, const Dictionary *dict, PatternMatrix *pm);
+
+/* closePatternMatrix:
+ * Unmaps a matrix opened with openPatternMatrix.
+ */
+void closePatternMatrix(PatternMatrix *pm);
+
+/* getPatternMatrix:
+ * Returns the shared matrix for the shared dictionary, mapping PATTERNS_FILE
+ * on first use. Returns NULL if it is missing or stale.
+ */
+const PatternMatrix *getPatternMatrix(void);
+
+/* patternAt:
+ * Pattern for dictionary words 'guess' and 'answer': a single load from the
+ * mapped matrix when it is available, otherwise computed with scoreGuess.
+ */
+uint8_t patternAt(const Dictionary *dict, int guess, int answer);
+
+#endif
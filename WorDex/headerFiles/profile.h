@@ -0,0 +1,172 @@
+/* profile.h
+ *
+ * Header file for the hot-path profiler and the trace recorder.
+ * Marks the functions worth timing with PROFILE_SCOPE, which records how
+ * long each call took into per-thread latency histograms, and the phases of
+ * a session (startup, login, turns) with TRACE_SCOPE. With --trace every
+ * mark also becomes a span in a Chrome trace-event file. The marks only
+ * exist in builds made with -DWORDEX_PROFILE (make profile); everywhere
+ * else they compile to nothing.
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+/* ProfilePoint: the timed functions; profilePointNames has their names */
+typedef enum {
+    PROFILE_RANDOM_WORD,      // wxNewGame / setRandomWordAndCount
+    PROFILE_VALIDATE_GUESS,   // validateGuess, after the guess was read
+    PROFILE_HINT,             // printHint
+    PROFILE_INTERFACE,        // interface / defaultInterface
+    PROFILE_LOG_GAME,         // logGame / logGames
+    PROFILE_UPDATE_STATS,     // updateStats / updateStatsBatch
+    PROFILE_LOAD_STATS,       // loadStats
+    PROFILE_RESULT_COMMIT,    // one result log write + fdatasync
+    PROFILE_LEADERBOARD,      // ReadLeaderboardTop
+    PROFILE_HISTORY,          // CheckHistoryPage / ReadHistoryPage
+    PROFILE_ACCOUNT_FIND,     // accountStoreFind
+    PROFILE_PASSWORD,         // hashPassword / verifyPassword
+    PROFILE_POINTS
+} ProfilePoint;
+
+/* Histogram buckets: exact below 16 ns, then 16 per power of two, so any
+ * recorded value is within about 6% of its bucket */
+#define PROFILE_SUB_BITS  4
+#define PROFILE_BUCKETS   ((64 - PROFILE_SUB_BITS + 1) << PROFILE_SUB_BITS)
+
+/* ProfileHistogram: call latencies of one point on one thread, in nanoseconds */
+typedef struct {
+    uint64_t count;
+    uint64_t total;
+    uint64_t max;
+    uint64_t buckets[PROFILE_BUCKETS];
+} ProfileHistogram;
+
+extern const char *const profilePointNames[PROFILE_POINTS];
+
+/* Spans kept per thread for --trace; once a thread has recorded more, its
+ * oldest spans are overwritten */
+#define TRACE_RING_EVENTS (1 << 16)
+
+/* TraceEvent: one finished span; name is a string literal */
+typedef struct {
+    const char *name;
+    uint64_t    start;      // ns, CLOCK_MONOTONIC
+    uint64_t    duration;   // ns
+} TraceEvent;
+
+#ifdef WORDEX_PROFILE
+
+/* ProfileScope: a running PROFILE_SCOPE (start is 0 while nothing records) */
+typedef struct {
+    ProfilePoint point;
+    uint64_t     start;
+} ProfileScope;
+
+/* TraceScope: a running TRACE_SCOPE */
+typedef struct {
+    const char *name;
+    uint64_t    start;
+} TraceScope;
+
+#define PROFILE_JOIN2(a, b) a##b
+#define PROFILE_JOIN(a, b)  PROFILE_JOIN2(a, b)
+
+/* PROFILE_SCOPE:
+ * Times the rest of the enclosing block, however it is left, as one call
+ * of 'point'. Costs a flag test while neither --profile nor --trace is given.
+ */
+#define PROFILE_SCOPE(point) \
+    ProfileScope profileScope_##point __attribute__((cleanup(profileScopeEnd))) = \
+        {point, profileStart()}
+
+/* TRACE_SCOPE:
+ * Records the rest of the enclosing block as a span called 'name' (a
+ * string literal) while --trace is given.
+ */
+#define TRACE_SCOPE(name) \
+    TraceScope PROFILE_JOIN(traceScope_, __LINE__) __attribute__((cleanup(traceScopeEnd))) = \
+        {name, traceStart()}
+
+/* TRACE_BEGIN / TRACE_END:
+ * A span that does not fit a block: TRACE_BEGIN(var) notes the time in a
+ * new variable and TRACE_END(name, var) records the span up to now.
+ */
+#define TRACE_BEGIN(var)      uint64_t var = traceStart()
+#define TRACE_END(name, var)  traceSpan(name, var)
+
+uint64_t profileStart(void);
+void profileScopeEnd(ProfileScope *scope);
+uint64_t traceStart(void);
+void traceScopeEnd(TraceScope *scope);
+void traceSpan(const char *name, uint64_t start);
+
+#else
+
+#define PROFILE_SCOPE(point)  ((void) 0)
+#define TRACE_SCOPE(name)     ((void) 0)
+#define TRACE_BEGIN(var)      ((void) 0)
+#define TRACE_END(name, var)  ((void) 0)
+
+#endif
+
+/* profileEnable:
+ * Starts recording and prints the report to stderr at exit.
+ * Returns 0, or 1 if the program was built without WORDEX_PROFILE.
+ */
+int profileEnable(void);
+
+/* traceEnable:
+ * Starts recording spans and writes them to 'path' at exit as Chrome
+ * trace-event JSON (chrome://tracing, ui.perfetto.dev). 'process' names
+ * the process in the timeline.
+ * Returns 0, or 1 if the program was built without WORDEX_PROFILE.
+ */
+int traceEnable(const char *path, const char *process);
+
+/* traceWrite:
+ * Writes every thread's recorded spans to 'path'.
+ * Returns 0 on success, 1 if the file could not be written.
+ */
+int traceWrite(const char *path);
+
+/* profileHistogramAdd:
+ * Adds one value to a histogram the caller owns (and keeps to one thread),
+ * for code that keeps latencies of its own; see profilePercentile.
+ */
+void profileHistogramAdd(ProfileHistogram *histogram, uint64_t nanoseconds);
+
+/* profileHistogramMerge:
+ * Adds every value recorded in 'from' to 'into'.
+ */
+void profileHistogramMerge(ProfileHistogram *into, const ProfileHistogram *from);
+
+/* profileRecord:
+ * Adds one call of 'point' that took 'nanoseconds' to this thread's
+ * histogram.
+ */
+void profileRecord(ProfilePoint point, uint64_t nanoseconds);
+
+/* profileMerge:
+ * Sums every thread's histogram for 'point' into 'out'.
+ */
+void profileMerge(ProfilePoint point, ProfileHistogram *out);
+
+/* profilePercentile:
+ * The latency (ns) below which 'percent' of the recorded calls fell.
+ */
+uint64_t profilePercentile(const ProfileHistogram *histogram, double percent);
+
+/* profileReport:
+ * Prints calls, p50, p90, p99, max and total time for every point that
+ * was called.
+ */
+void profileReport(FILE *out);
+
+#endif
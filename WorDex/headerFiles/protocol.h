@@ -0,0 +1,72 @@
+/* protocol.h
+ *
+ * Header file for the Wordex JSON-lines protocol (./wordex --protocol jsonl).
+ * Lets bots and scripted clients play through stdin and stdout without
+ * reading the boards and menus drawn for people.
+ *
+ * One JSON object per line in, one per line out, in order. Every command
+ * has a "cmd" and may have an "id", which is echoed back unchanged.
+ *
+ *   {"cmd":"login","user":U,"password":P}     {"ok":true,"cmd":"login","user":U}
+ *   {"cmd":"register","user":U,"password":P}  {"ok":true,"cmd":"register","user":U}
+ *   {"cmd":"new_game"}                        {"ok":true,"cmd":"new_game","guesses_left":6}
+ *   {"cmd":"guess","word":W}                  {"ok":true,"cmd":"guess","word":W,"pattern":"G.Y..",
+ *                                              "code":N,"guesses":K,"guesses_left":6-K,
+ *                                              "status":"playing"|"won"|"lost"[,"answer":A],
+ *                                              "keyboard":{"green":..,"yellow":..,"gray":..}}
+ *   {"cmd":"hint"}                            {"ok":true,"cmd":"hint","word":W,"candidates":N}
+ *   {"cmd":"stats"}                           {"ok":true,"cmd":"stats","games":..,"wins":..,
+ *                                              "losses":..,"streak":..,"best_streak":..,
+ *                                              "guesses":..,"distribution":[6 numbers]}
+ *   {"cmd":"leaderboard"[,"limit":N]}         {"ok":true,"cmd":"leaderboard","players":[{"rank":..,
+ *                                              "user":..,"games":..,"wins":..,"losses":..,
+ *                                              "win_rate":..,"avg_guesses":..},...]}
+ *   {"cmd":"history"[,"limit":N][,"offset":K]} {"ok":true,"cmd":"history","games":[{"user":..,
+ *                                              "word":..,"guesses":..,"won":..,"time":..},...]}
+ *   {"cmd":"quit"}                            {"ok":true,"cmd":"quit"}, then the program exits
+ *
+ * Anything that fails gets {"ok":false,"cmd":..,"error":"..."}. Patterns
+ * use G for green, Y for yellow and . for gray; "code" is the same pattern
+ * as a base-3 number (see feedback.h). The keyboard lists the letters of
+ * each colour in alphabetical order.
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "libwordex.h"
+
+/* Longest accepted command line, including the '\n' */
+#define PROTOCOL_LINE_MAX     1024
+
+/* Most fields a command may have */
+#define PROTOCOL_FIELDS       8
+
+/* Input read at once; every complete command in it is answered before
+ * any output is written */
+#define PROTOCOL_READ_BYTES   65536
+
+/* Responses are written once input runs dry, or once this many bytes of
+ * them are waiting */
+#define PROTOCOL_FLUSH_BYTES  65536
+
+/* Most rows leaderboard and history return, and their defaults */
+#define PROTOCOL_ROWS_MAX     100
+#define PROTOCOL_LEADERS      10
+#define PROTOCOL_HISTORY_ROWS 20
+
+/* runProtocol:
+ * Answers commands read from inFd on outFd until "quit" or end of input,
+ * playing through 'ctx'.
+ * Finished games go to the result log; a game's last response is written
+ * once the game is on disk.
+ * Returns 0, or 1 if output could not be written.
+ */
+int runProtocol(WxContext *ctx, int inFd, int outFd);
+
+#endif
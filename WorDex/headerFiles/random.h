@@ -0,0 +1,28 @@
+/* random.h
+ *
+ * Header file for the Wordex random number generator.
+ * Answers, simulated guesses, load generator requests and the benchmarks'
+ * synthetic data all come from xorshift64*, each caller keeping its own
+ * state so threads never share one. It is defined here, inline, so every
+ * program gets it without linking another file.
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <stdint.h>
+
+/* nextRandom:
+ * Advances 'state' (which must not be 0) and returns the next number.
+ */
+static inline uint64_t nextRandom(uint64_t *state) {
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 2685821657736338717ull;
+}
+
+#endif
@@ -0,0 +1,86 @@
+/* record_parser.h
+ *
+ * Header file for the shared record tokenizer.
+ * The history (history.txt) and statistics (stats.txt) files are lines of
+ * whitespace-separated fields. A RecordCursor walks one line of a buffer
+ * the caller already holds (read, mapped or NUL-terminated) and hands out
+ * each field as a view into that buffer, without copying or allocating;
+ * numbers are converted straight from the view.
+ *
+ *   RecordCursor line;
+ *   RecordField name;
+ *   int wins;
+ *
+ *   recordCursorInit(&line, text, length);
+ *   if (recordNextField(&line, &name) && recordNextInt(&line, &wins)) ...
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#ifndef RECORD_PARSER_H
+#define RECORD_PARSER_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "history.h"
+
+/* RecordField: one field, 'length' bytes at 'text' (not NUL-terminated) */
+typedef struct {
+    const char *text;
+    size_t      length;
+} RecordField;
+
+/* RecordCursor: the rest of a line, [next, end) */
+typedef struct {
+    const char *next;
+    const char *end;
+} RecordCursor;
+
+/* recordCursorInit:
+ * Starts a cursor over the 'length' bytes at 'text'. The bytes stay the
+ * caller's and must outlive every field taken from them.
+ */
+void recordCursorInit(RecordCursor *cursor, const char *text, size_t length);
+
+/* recordNextField:
+ * Skips blanks and takes the next field.
+ * Returns 1, or 0 if the line has no more fields.
+ */
+int recordNextField(RecordCursor *cursor, RecordField *field);
+
+/* recordFieldLong / recordFieldInt:
+ * Converts a whole field of decimal digits, with an optional sign.
+ * Returns 0, or 1 if the field is not a number or out of range.
+ */
+int recordFieldLong(RecordField field, long *out);
+int recordFieldInt(RecordField field, int *out);
+
+/* recordFieldCopy:
+ * Copies a field into 'out' (of 'size' bytes) as a string.
+ * Returns 0, or 1 if it does not fit.
+ */
+int recordFieldCopy(RecordField field, char *out, size_t size);
+
+/* recordNextInt / recordNextLong / recordNextString:
+ * recordNextField followed by the conversion or copy.
+ * Return 1 on success, 0 if the field is missing or does not convert.
+ */
+int recordNextInt(RecordCursor *cursor, int *out);
+int recordNextLong(RecordCursor *cursor, long *out);
+int recordNextString(RecordCursor *cursor, char *out, size_t size);
+
+/* recordReadGame:
+ * Reads a history.txt game, "username word guesses won timestamp", from
+ * the cursor and leaves it after the timestamp.
+ * Returns 1 if all five fields were read, 0 for a blank or bad line.
+ */
+int recordReadGame(RecordCursor *cursor, struct GameResult *r);
+
+/* recordParseGame:
+ * recordReadGame over the 'length' bytes at 'text'; anything after the
+ * timestamp is ignored.
+ */
+int recordParseGame(const char *text, size_t length, struct GameResult *r);
+
+#endif
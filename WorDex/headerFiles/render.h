@@ -0,0 +1,104 @@
+/* render.h
+ *
+ * Header file for the Wordex frame renderer.
+ * Draws the game board and keyboard into a preallocated frame buffer and
+ * sends each frame to the terminal with a single write, redrawing only the
+ * cells that changed since the previous frame.
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#ifndef RENDER_H
+#define RENDER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "game_logic.h"
+
+/* A frame: the board and keyboard boxes with their blank lines, each line
+ * at most FRAME_COLS cells wide */
+#define FRAME_ROWS         21
+#define FRAME_COLS         49
+
+/* Output buffer per frame; a full redraw of every cell fits comfortably */
+#define FRAME_BYTES        32768
+
+/* Lines the terminal needs below a frame for prompts and messages. A
+ * shorter terminal scrolls the frame away, so it always gets full frames */
+#define RENDER_SPARE_ROWS  8
+
+/* Render modes */
+enum {
+    RENDER_PLAIN,   // every frame in full, no control codes (pipes, tests)
+    RENDER_ANSI     // clear with ANSI codes, then redraw only what changed
+};
+
+/* FrameCell: one character cell, its UTF-8 bytes and colour (SGR code, 0 for none) */
+typedef struct {
+    char    glyph[3];
+    uint8_t length;
+    uint8_t color;
+} FrameCell;
+
+/* Frame: the cells of every line; width[row] cells are in use */
+typedef struct {
+    FrameCell cells[FRAME_ROWS][FRAME_COLS];
+    uint8_t   width[FRAME_ROWS];
+} Frame;
+
+/* Renderer:
+ * Where frames go, what the terminal shows now and the buffer the next
+ * frame is built in.
+ */
+typedef struct {
+    int   fd;
+    int   mode;
+    int   shownValid;     // 'shown' is on screen at the top left
+    int   linesBelow;     // terminal lines printed under it since it was drawn
+    Frame shown;
+    Frame next;
+    char  out[FRAME_BYTES];
+    long  frames;         // frames drawn
+    long  bytes;          // bytes written for them
+} Renderer;
+
+/* rendererInit:
+ * Prepares a renderer writing to 'fd' in the given mode.
+ */
+void rendererInit(Renderer *r, int fd, int mode);
+
+/* rendererInvalidate:
+ * Makes the next frame clear the screen and draw everything.
+ */
+void rendererInvalidate(Renderer *r);
+
+/* rendererNoteLine:
+ * Tells the renderer a line 'width' characters wide (without the newline)
+ * was printed under the frame. Once the lines would have scrolled the
+ * frame up, the next frame is drawn in full.
+ */
+void rendererNoteLine(Renderer *r, int width);
+
+/* rendererDraw:
+ * Draws 'game' (NULL for an empty board) with one write.
+ * Returns the number of bytes written.
+ */
+size_t rendererDraw(Renderer *r, const GameState *game);
+
+/* rendererClear:
+ * Clears the terminal (nothing in RENDER_PLAIN mode).
+ */
+void rendererClear(Renderer *r);
+
+/* renderScreen / renderScreenReset / renderScreenNoteLine / clearScreen:
+ * The game's renderer on stdout: ANSI on a terminal, plain otherwise and
+ * in TESTING builds. renderScreenReset makes the next frame a full one;
+ * everything printed between frames goes through renderScreenNoteLine.
+ */
+void renderScreen(const GameState *game);
+void renderScreenReset(void);
+void renderScreenNoteLine(int width);
+void clearScreen(void);
+
+#endif
@@ -0,0 +1,84 @@
+/* result_log.h
+ *
+ * Header file for the game result log: a write-ahead log that makes
+ * finished games durable in batches, one sync per batch, and applies them
+ * to the history and statistics files in the background.
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#ifndef RESULT_LOG_H
+#define RESULT_LOG_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "history.h"
+#include "statistics.h"
+
+/* Every process writes its own log, results.<pid>.wal in the data
+ * directory (see data_dir.h), and removes it once everything in it has
+ * been applied */
+#define RESULT_LOG_PREFIX    "results."
+#define RESULT_LOG_SUFFIX    ".wal"
+
+#define RESULT_LOG_MAGIC     "WXRSLOG"
+#define RESULT_LOG_VERSION   1
+
+/* Games applied to the history and statistics files per batch */
+#define RESULT_LOG_APPLY_MAX 512
+
+/* A fully applied log is emptied once it is at least this big */
+#define RESULT_LOG_COMPACT_BYTES (1L << 20)
+
+/* ResultLogDone:
+ * Called once a game passed to resultLogAppend is on disk (status 0) or
+ * could not be written (status 1). It runs on the log's commit thread,
+ * so it must only hand the news on.
+ */
+typedef void (*ResultLogDone)(void *context, int status);
+
+/* resultLogOpen:
+ * Replays the logs of processes that stopped before applying them, then
+ * starts this process's log and its commit and apply threads. The log is
+ * closed automatically at exit.
+ * Returns 0 on success, 1 (with a message on stderr) otherwise; games are
+ * then written straight to the files as before.
+ */
+int resultLogOpen(void);
+
+/* resultLogAppend:
+ * Adds a finished game to the log. With done == NULL it returns once the
+ * game is on disk (0) or could not be written (1); otherwise it returns 0
+ * at once and done(context, status) is called later. Without an open log
+ * the game is written to the history and statistics files directly.
+ */
+int resultLogAppend(const char *username, const char *word, int guesses, int won, time_t when,
+                    ResultLogDone done, void *context);
+
+/* resultLogSync:
+ * Waits until every game appended so far is in the history and
+ * statistics files, so a reader sees them.
+ */
+void resultLogSync(void);
+
+/* resultLogClose:
+ * Commits and applies everything still queued, stops the threads and
+ * removes the log.
+ */
+void resultLogClose(void);
+
+/* replayResultLogs:
+ * Applies whatever the logs of stopped processes still hold and removes
+ * them. Logs of running processes are left alone.
+ * Returns the number of games replayed.
+ */
+long replayResultLogs(void);
+
+/* resultLogCounters:
+ * Games committed by this process's log and the syncs it took.
+ */
+void resultLogCounters(long *games, long *commits);
+
+#endif
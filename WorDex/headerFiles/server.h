@@ -0,0 +1,73 @@
+/* server.h
+ *
+ * Header file for the Wordex game server (wordexd).
+ * Declares the server options and the entry point that hosts many players'
+ * sessions in non-blocking epoll event loops, speaking a line protocol.
+ *
+ * Protocol: one command per line, one reply per command, in order.
+ *   LOGIN user password      OK welcome user | ERR ...
+ *   REGISTER user password   OK registered user | ERR ...
+ *   NEW                      OK new 6
+ *   GUESS word               OK <pattern> <guesses left> [WIN | LOSS answer]
+ *                            pattern: G green, Y yellow, . gray
+ *   HINT                     OK hint <word> <candidates left>
+ *   STATS                    OK games=.. wins=.. losses=.. streak=.. best=.. guesses=.. dist=a,b,c,d,e,f
+ *   LEADERBOARD [N]          OK <n>, then n lines: rank user games wins losses winrate avgguesses
+ *   HISTORY [N [OFFSET]]     OK <n>, then n lines: user word guesses WIN|LOSS time
+ *   PING                     OK pong
+ *   QUIT                     OK bye, then the server closes the connection
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define SERVER_DEFAULT_HOST  "127.0.0.1"
+#define SERVER_DEFAULT_PORT  7777
+
+/* Longest accepted command line, including the '\n' */
+#define SERVER_LINE_MAX      512
+
+/* Most rows LEADERBOARD and HISTORY return, and their defaults */
+#define SERVER_ROWS_MAX      100
+#define SERVER_LEADERS       10
+#define SERVER_HISTORY_ROWS  20
+
+/* Most threads --loops and --workers accept */
+#define SERVER_THREADS_MAX   1024
+
+/* ServerOptions:
+ * Parsed from wordexd's command line.
+ */
+typedef struct {
+    const char *socketPath;   // Unix socket to listen on, NULL for TCP
+    const char *host;         // TCP address to bind
+    int         port;
+    int         loops;        // event loop threads (< 1 means one per CPU)
+    int         workers;      // threads for password hashing and hints (< 1: one per CPU)
+    int         maxSessions;  // connections held at once, 0 for no limit
+    const char *dataDir;      // directory holding the game files, NULL for textFiles
+    const char *dictPath;     // word list file, NULL for the built-in one
+    int         profile;      // print per-function latencies at exit
+    const char *tracePath;    // write a trace-event timeline here at exit, NULL for none
+} ServerOptions;
+
+/* parseServerArgs:
+ * Reads --socket PATH | --port N [--host ADDR], --loops N, --workers N,
+ * --max-sessions N, --data-dir DIR, --dict FILE, --profile and --trace FILE.
+ * Returns 0 on success, 1 and prints an error to stderr otherwise.
+ */
+int parseServerArgs(int argc, char *argv[], ServerOptions *options);
+
+/* runServer:
+ * Listens and serves sessions until SIGINT or SIGTERM.
+ * Returns 0 after a clean shutdown, 1 if the server could not start.
+ */
+int runServer(const ServerOptions *options);
+
+#endif
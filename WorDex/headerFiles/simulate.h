@@ -0,0 +1,51 @@
+/* simulate.h
+ *
+ * Header file for the Wordex headless simulation module.
+ * Declares the options and entry point for playing many games in parallel
+ * with the real game logic and no terminal, for capacity testing.
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#ifndef SIMULATE_H
+#define SIMULATE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+/* Most threads --threads accepts */
+#define SIMULATION_THREADS_MAX 1024
+
+/* Strategies a simulated player can use to pick its next guess */
+typedef enum {
+    STRATEGY_RANDOM,     // any word still consistent with the feedback
+    STRATEGY_GREEDY,     // the consistent word with the most common letters
+    STRATEGY_ENTROPY     // the hint engine's highest-information guess
+} Strategy;
+
+/* SimulationOptions:
+ * Parsed from --simulate N --threads T --strategy S [--persist].
+ */
+typedef struct {
+    long     games;      // total games to play
+    int      threads;    // worker threads (< 1 means one per CPU, capped at games)
+    Strategy strategy;
+    int      persist;    // 1: logGame + updateStats, 0: in-memory sink only
+} SimulationOptions;
+
+/* parseSimulationArgs:
+ * Reads the simulation flags from argv (argv[1] must be --simulate).
+ * Returns 0 on success, 1 and prints an error to stderr otherwise.
+ */
+int parseSimulationArgs(int argc, char *argv[], SimulationOptions *options);
+
+/* runSimulation:
+ * Plays options->games games across the worker threads, then prints
+ * games/sec, the guess distribution and per-stage latency.
+ * Returns 0 on success, 1 if the dictionary could not be loaded.
+ */
+int runSimulation(const SimulationOptions *options);
+
+#endif
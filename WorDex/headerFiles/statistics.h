@@ -31,9 +31,19 @@ typedef struct {
     int winsByGuess[6];   // guess distribution for wins
 } Stats;
 
+/* StatsUpdate - one finished game, as passed to updateStatsBatch */
+typedef struct {
+    const char *username;
+    int won;
+    int guessCount;
+    long timePlayed;
+} StatsUpdate;
+
 int defaultStats(const char *username);
 int loadStats(const char *username, Stats *s);
 int updateStats(const char *username, int won, int guessCount, long timePlayed);
+int updateStatsBatch(const StatsUpdate *updates, int count);   // all or nothing, one journal
+int rebuildStats(void);                                        // every user's stats from the game history
 int printStats(const char *username);
 
 #endif
\ No newline at end of file
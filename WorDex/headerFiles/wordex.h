@@ -18,10 +18,20 @@
 #include <unistd.h>
 
 // Module header files
+#include "headerFiles/data_dir.h"
+#include "headerFiles/libwordex.h"
 #include "headerFiles/authentication.h"
+#include "headerFiles/account_store.h"
+#include "headerFiles/kdf.h"
 #include "headerFiles/statistics.h"
 #include "headerFiles/history.h"
+#include "headerFiles/history_binary.h"
+#include "headerFiles/result_log.h"
 #include "headerFiles/leaderboard.h"
 #include "headerFiles/game_logic.h"
+#include "headerFiles/render.h"
+#include "headerFiles/simulate.h"
+#include "headerFiles/profile.h"
+#include "headerFiles/protocol.h"
 
 #endif 
\ No newline at end of file
@@ -0,0 +1,478 @@
+/* loadgen.c
+ *
+ * Load generator for the Wordex game server (wordexd).
+ *
+ * Opens many sessions from one non-blocking epoll loop. Each session
+ * registers (or logs in to) its own account, then plays games back to back
+ * with random guesses from the word list, one request in flight at a time.
+ * Once every session is logged in, guesses are counted and timed for the
+ * chosen duration. The report gives the sessions held, guesses/sec and the
+ * guess latency percentiles.
+ *
+ * Usage:
+ *   ./loadgen [--port N] [--host ADDR] [--socket PATH] [--sessions N]
+ *             [--duration S] [--prefix NAME] [--words PATH]
+ *
+ *   --sessions   concurrent sessions to open (default 100)
+ *   --duration   seconds to measure once all sessions are logged in (default 10)
+ *   --prefix     account names are <prefix><n> (default "load")
+ *   --words      word list to guess from (default textFiles/words.txt)
+ *
+ * Logging in costs one PBKDF2 per session on the server, so large runs
+ * are quicker against a scratch data directory whose kdf.conf asks for
+ * few iterations (wordexd --data-dir).
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#define _GNU_SOURCE     // SOCK_NONBLOCK, SOCK_CLOEXEC
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include "../headerFiles/random.h"
+
+#define LINE_MAX_BYTES 512
+#define MAX_EVENTS     256
+
+/* What a session is waiting for */
+enum {
+    STEP_CONNECT,
+    STEP_REGISTER,
+    STEP_LOGIN,
+    STEP_NEW,
+    STEP_GUESS,
+    STEP_DEAD
+};
+
+/* Client:
+ *   One session: its socket, the request in flight and unread reply bytes.
+ */
+struct Client {
+    int      fd;
+    int      index;
+    int      step;
+    uint64_t sentAt;           // ns, when the request in flight was sent
+    char     in[LINE_MAX_BYTES];
+    size_t   inLength;
+};
+
+/* Options */
+static const char *host = "127.0.0.1";
+static int port = 7777;
+static const char *socketPath = NULL;
+static int sessions = 100;
+static double duration = 10.0;
+static const char *prefix = "load";
+static const char *wordsPath = "textFiles/words.txt";
+
+/* Word list */
+static char (*words)[6] = NULL;
+static int wordCount = 0;
+
+/* Results */
+static uint32_t *latencies = NULL;     // guess round trips, microseconds
+static long latencyCount = 0;
+static long latencyCapacity = 0;
+static long gamesFinished = 0;
+static long errors = 0;
+static int loggedIn = 0;
+static int measuring = 0;
+static uint64_t rng = 88172645463325252ull;
+
+/* now_ns: monotonic clock in nanoseconds */
+static uint64_t now_ns(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ull + (uint64_t) ts.tv_nsec;
+}
+
+/* compare_u32: qsort comparator */
+static int compare_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *) a;
+    uint32_t y = *(const uint32_t *) b;
+
+    return (x > y) - (x < y);
+}
+
+/*
+ * load_words:
+ *   Reads the 5-letter words of the word list.
+ *
+ * RETURNS:
+ *   0 on success, 1 if the list is missing or empty.
+ */
+
+static int load_words(void) {
+    FILE *fp = fopen(wordsPath, "r");
+    char line[64];
+    int capacity = 0;
+
+    if (fp == NULL) {
+        return 1;
+    }
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (strlen(line) != 5) {
+            continue;
+        }
+        if (wordCount == capacity) {
+            capacity = capacity > 0 ? capacity * 2 : 4096;
+            words = realloc(words, sizeof(*words) * (size_t) capacity);
+            if (words == NULL) {
+                fclose(fp);
+                return 1;
+            }
+        }
+        memcpy(words[wordCount], line, 6);
+        wordCount = wordCount + 1;
+    }
+    fclose(fp);
+    return wordCount == 0;
+}
+
+/* record_latency: one guess round trip */
+static void record_latency(uint64_t ns) {
+    if (latencyCount == latencyCapacity) {
+        uint32_t *grown;
+
+        latencyCapacity = latencyCapacity > 0 ? latencyCapacity * 2 : 65536;
+        grown = realloc(latencies, sizeof(uint32_t) * (size_t) latencyCapacity);
+        if (grown == NULL) {
+            return;
+        }
+        latencies = grown;
+    }
+    latencies[latencyCount] = (uint32_t) (ns / 1000);
+    latencyCount = latencyCount + 1;
+}
+
+/*
+ * send_request:
+ *   Sends one command line; requests are small, so one send is enough.
+ */
+
+static void send_request(struct Client *c, int step, const char *format, const char *argument) {
+    char line[LINE_MAX_BYTES];
+    int length;
+
+    if (step == STEP_REGISTER || step == STEP_LOGIN) {
+        length = snprintf(line, sizeof(line), format, prefix, c->index, c->index);
+    } else {
+        length = snprintf(line, sizeof(line), format, argument);
+    }
+
+    c->step = step;
+    c->sentAt = now_ns();
+    if (send(c->fd, line, (size_t) length, MSG_NOSIGNAL) != length) {
+        c->step = STEP_DEAD;
+    }
+}
+
+/* send_guess: a random word from the list */
+static void send_guess(struct Client *c) {
+    send_request(c, STEP_GUESS, "GUESS %s\n", words[nextRandom(&rng) % (uint64_t) wordCount]);
+}
+
+/*
+ * on_reply:
+ *   Moves a session to its next request after a reply line.
+ */
+
+static void on_reply(struct Client *c, const char *line) {
+    uint64_t elapsed = now_ns() - c->sentAt;
+    int ok = (strncmp(line, "OK", 2) == 0);
+
+    switch (c->step) {
+    case STEP_REGISTER:
+    case STEP_LOGIN:
+        if (ok) {
+            loggedIn = loggedIn + 1;
+            send_request(c, STEP_NEW, "NEW\n", NULL);
+        } else if (c->step == STEP_REGISTER && strstr(line, "taken") != NULL) {
+            send_request(c, STEP_LOGIN, "LOGIN %s%d Loadgen@%d!\n", NULL);
+        } else {
+            fprintf(stderr, "session %d: %s\n", c->index, line);
+            c->step = STEP_DEAD;
+        }
+        break;
+
+    case STEP_NEW:
+        if (!ok) {
+            errors = errors + 1;
+        }
+        send_guess(c);
+        break;
+
+    case STEP_GUESS:
+        if (measuring) {
+            record_latency(elapsed);
+        }
+        if (!ok) {
+            errors = errors + 1;
+            send_guess(c);
+        } else if (strstr(line, "WIN") != NULL || strstr(line, "LOSS") != NULL) {
+            if (measuring) {
+                gamesFinished = gamesFinished + 1;
+            }
+            send_request(c, STEP_NEW, "NEW\n", NULL);
+        } else {
+            send_guess(c);
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+/*
+ * on_readable:
+ *   Reads reply bytes and handles every complete line.
+ */
+
+static void on_readable(struct Client *c) {
+    for (;;) {
+        ssize_t n = read(c->fd, c->in + c->inLength, sizeof(c->in) - c->inLength);
+        size_t start = 0;
+
+        if (n == 0 || (n < 0 && errno != EAGAIN && errno != EINTR)) {
+            c->step = STEP_DEAD;
+            return;
+        }
+        if (n < 0) {
+            return;
+        }
+        c->inLength = c->inLength + (size_t) n;
+
+        for (;;) {
+            char *newline = memchr(c->in + start, '\n', c->inLength - start);
+
+            if (newline == NULL || c->step == STEP_DEAD) {
+                break;
+            }
+            *newline = '\0';
+            on_reply(c, c->in + start);
+            start = (size_t) (newline - c->in) + 1;
+        }
+        memmove(c->in, c->in + start, c->inLength - start);
+        c->inLength = c->inLength - start;
+        if (c->inLength == sizeof(c->in)) {
+            c->step = STEP_DEAD;
+            return;
+        }
+    }
+}
+
+/*
+ * open_client:
+ *   Starts a non-blocking connect for one session.
+ *
+ * RETURNS:
+ *   0 on success, 1 on failure.
+ */
+
+static int open_client(int epollFd, struct Client *c) {
+    struct epoll_event ev;
+    int one = 1;
+    int result;
+
+    if (socketPath != NULL) {
+        struct sockaddr_un addr;
+
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", socketPath);
+        c->fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        result = (c->fd < 0) ? -1 : connect(c->fd, (struct sockaddr *) &addr, sizeof(addr));
+    } else {
+        struct sockaddr_in addr;
+
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons((uint16_t) port);
+        inet_pton(AF_INET, host, &addr.sin_addr);
+        c->fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (c->fd >= 0) {
+            setsockopt(c->fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        }
+        result = (c->fd < 0) ? -1 : connect(c->fd, (struct sockaddr *) &addr, sizeof(addr));
+    }
+
+    if (c->fd < 0 || (result != 0 && errno != EINPROGRESS && errno != EAGAIN)) {
+        return 1;
+    }
+
+    c->step = STEP_CONNECT;
+    ev.events = EPOLLIN | EPOLLOUT;
+    ev.data.ptr = c;
+    return epoll_ctl(epollFd, EPOLL_CTL_ADD, c->fd, &ev) != 0;
+}
+
+int main(int argc, char *argv[]) {
+    struct epoll_event events[MAX_EVENTS];
+    struct Client *clients;
+    uint64_t startedAt, measureStart = 0, measureEnd = 0, rampNs = 0;
+    int epollFd;
+    int held = 0;
+    int i;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--host") == 0 && i + 1 < argc) {
+            host = argv[++i];
+        } else if (strcmp(argv[i], "--port") == 0 && i + 1 < argc) {
+            port = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--socket") == 0 && i + 1 < argc) {
+            socketPath = argv[++i];
+        } else if (strcmp(argv[i], "--sessions") == 0 && i + 1 < argc) {
+            sessions = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--duration") == 0 && i + 1 < argc) {
+            duration = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--prefix") == 0 && i + 1 < argc) {
+            prefix = argv[++i];
+        } else if (strcmp(argv[i], "--words") == 0 && i + 1 < argc) {
+            wordsPath = argv[++i];
+        } else {
+            fprintf(stderr, "Usage: %s [--port N] [--host ADDR] [--socket PATH] [--sessions N] "
+                            "[--duration S] [--prefix NAME] [--words PATH]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (sessions < 1 || duration <= 0) {
+        fprintf(stderr, "Error: --sessions and --duration must be positive\n");
+        return 1;
+    }
+    if (load_words() != 0) {
+        fprintf(stderr, "Error: could not read the word list %s\n", wordsPath);
+        return 1;
+    }
+
+    rng ^= now_ns() | 1;
+    signal(SIGPIPE, SIG_IGN);
+
+    clients = calloc((size_t) sessions, sizeof(struct Client));
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (clients == NULL || epollFd < 0) {
+        return 1;
+    }
+
+    startedAt = now_ns();
+    for (i = 0; i < sessions; i++) {
+        clients[i].index = i;
+        if (open_client(epollFd, &clients[i]) != 0) {
+            fprintf(stderr, "Error: could not connect session %d: %s\n", i, strerror(errno));
+            clients[i].step = STEP_DEAD;
+        }
+    }
+
+    printf("Opening %d sessions to %s", sessions, socketPath != NULL ? socketPath : host);
+    if (socketPath == NULL) {
+        printf(":%d", port);
+    }
+    printf(" ...\n");
+    fflush(stdout);
+
+    for (;;) {
+        uint64_t now = now_ns();
+        int n, alive = 0;
+
+        // Measurement starts once every live session has logged in
+        if (!measuring && measureEnd == 0) {
+            for (i = 0; i < sessions; i++) {
+                alive = alive + (clients[i].step != STEP_DEAD);
+            }
+            if (alive == 0) {
+                break;
+            }
+            if (loggedIn >= alive) {
+                measuring = 1;
+                measureStart = now;
+                rampNs = now - startedAt;
+            }
+        }
+        if (measuring && now - measureStart >= (uint64_t) (duration * 1e9)) {
+            measuring = 0;
+            measureEnd = now;
+            break;
+        }
+
+        n = epoll_wait(epollFd, events, MAX_EVENTS, 100);
+        for (i = 0; i < n; i++) {
+            struct Client *c = events[i].data.ptr;
+
+            if (c->step == STEP_DEAD) {
+                continue;
+            }
+            if (c->step == STEP_CONNECT && (events[i].events & EPOLLOUT)) {
+                struct epoll_event ev;
+                int error = 0;
+                socklen_t length = sizeof(error);
+
+                getsockopt(c->fd, SOL_SOCKET, SO_ERROR, &error, &length);
+                if (error != 0) {
+                    c->step = STEP_DEAD;
+                    continue;
+                }
+                ev.events = EPOLLIN;
+                ev.data.ptr = c;
+                epoll_ctl(epollFd, EPOLL_CTL_MOD, c->fd, &ev);
+                send_request(c, STEP_REGISTER, "REGISTER %s%d Loadgen@%d!\n", NULL);
+                continue;
+            }
+            if (events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP)) {
+                on_readable(c);
+            }
+            if (c->step == STEP_DEAD) {
+                epoll_ctl(epollFd, EPOLL_CTL_DEL, c->fd, NULL);
+            }
+        }
+    }
+
+    for (i = 0; i < sessions; i++) {
+        held = held + (clients[i].step != STEP_DEAD);
+        if (clients[i].fd > 0) {
+            close(clients[i].fd);
+        }
+    }
+
+    if (measureEnd == 0) {
+        printf("No session could log in\n");
+        return 1;
+    }
+
+    {
+        double seconds = (double) (measureEnd - measureStart) / 1e9;
+
+        printf("Sessions held:  %d of %d (all logged in after %.2f s)\n", held, sessions, (double) rampNs / 1e9);
+        printf("Guesses:        %ld in %.2f s = %.0f guesses/sec\n", latencyCount, seconds,
+               seconds > 0 ? latencyCount / seconds : 0.0);
+        printf("Games finished: %ld (%.0f games/sec), error replies: %ld\n", gamesFinished,
+               seconds > 0 ? gamesFinished / seconds : 0.0, errors);
+    }
+
+    if (latencyCount > 0) {
+        qsort(latencies, (size_t) latencyCount, sizeof(uint32_t), compare_u32);
+        printf("Guess latency:  p50 %u us, p90 %u us, p99 %u us, max %u us\n",
+               latencies[latencyCount / 2], latencies[latencyCount * 90 / 100],
+               latencies[latencyCount * 99 / 100], latencies[latencyCount - 1]);
+    }
+
+    free(latencies);
+    free(words);
+    free(clients);
+    close(epollFd);
+    return 0;
+}
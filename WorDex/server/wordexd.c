@@ -0,0 +1,36 @@
+/* wordexd.c
+ *
+ * The Wordex game server: hosts many players' sessions in one process.
+ * See headerFiles/server.h for the line protocol.
+ *
+ * Usage:
+ *   ./wordexd [--port N] [--host ADDR] [--socket PATH] [--loops N]
+ *             [--workers N] [--max-sessions N] [--data-dir DIR] [--dict FILE]
+ *             [--profile] [--trace FILE]
+ *
+ *   --port / --host   TCP address to listen on (default 127.0.0.1:7777)
+ *   --socket          listen on a Unix socket instead of TCP
+ *   --loops           event loop threads (default one per CPU)
+ *   --workers         threads for password hashing and hints (default one per CPU)
+ *   --max-sessions    refuse connections beyond this many
+ *   --data-dir        directory holding the game files (default textFiles),
+ *                     as for ./wordex --data-dir
+ *   --dict            word list to play with instead of the built-in one
+ *   --profile         print per-function latencies at exit (make profile)
+ *   --trace           write a Chrome trace-event timeline to FILE at exit
+ *                     (make profile)
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#include "../headerFiles/server.h"
+
+int main(int argc, char *argv[]) {
+    ServerOptions options;
+
+    if (parseServerArgs(argc, argv, &options) != 0) {
+        return 1;
+    }
+    return runServer(&options);
+}
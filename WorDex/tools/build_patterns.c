@@ -0,0 +1,54 @@
+/* build_patterns.c
+ *
+ * Builds textFiles/patterns.bin, the guess x answer pattern matrix for the
+ * current word list. Used by `make patterns`.
+ *
+ * Usage:
+ *   ./build_patterns [words file] [output file] [threads]
+ *
+ * The words file defaults to the built-in word list, which is also what
+ * "-" means; the game uses that list unless started with --dict. Threads
+ * defaults to one per online CPU.
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../headerFiles/patterns.h"
+#include "../headerFiles/data_dir.h"
+
+int main(int argc, char *argv[]) {
+    const char *wordsPath = (argc > 1 && strcmp(argv[1], "-") != 0) ? argv[1] : NULL;
+    const char *outPath = (argc > 2) ? argv[2] : dataPath(PATTERNS_FILE);
+    int threads = (argc > 3) ? atoi(argv[3]) : 0;
+    struct timespec start, end;
+    Dictionary dict;
+    double seconds;
+
+    if (wordsPath == NULL) {
+        dict = *getDictionary();
+    } else if (loadDictionary(wordsPath, &dict) != 0) {
+        fprintf(stderr, "Error: could not read word list %s\n", wordsPath);
+        return 1;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if (buildPatternMatrix(&dict, outPath, threads) != 0) {
+        fprintf(stderr, "Error: could not write pattern matrix %s\n", outPath);
+        freeDictionary(&dict);
+        return 1;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    printf("Wrote %s: %d x %d patterns (%.1f MB) in %.2f s\n",
+           outPath, dict.count, dict.count,
+           (double) dict.count * dict.count / (1024.0 * 1024.0), seconds);
+
+    freeDictionary(&dict);
+    return 0;
+}
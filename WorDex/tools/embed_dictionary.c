@@ -0,0 +1,133 @@
+/* embed_dictionary.c
+ *
+ * Generates functionFiles/dictionary_data.c, the word list compiled into
+ * the game: every valid word of the list, lowercased, deduplicated and
+ * sorted, stored packed, plus the open-addressing hash table getDictionary
+ * would otherwise build at run time. Used by the makefile whenever
+ * textFiles/words.txt changes.
+ *
+ * Usage:
+ *   ./embed_dictionary [words file] [output file]
+ *
+ * AUTHOR:  Wordex Team
+ * DATE:    18th October, 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../headerFiles/dictionary.h"
+#include "../headerFiles/data_dir.h"
+
+#define DATA_FILE "functionFiles/dictionary_data.c"
+
+/* sort_key: a packed word with its first letter in the high bits, so keys sort alphabetically */
+static uint32_t sort_key(uint32_t packed) {
+    uint32_t key = 0;
+    int i;
+
+    for (i = 0; i < WORD_LENGTH; i++) {
+        key = (key << LETTER_BITS) | ((packed >> (LETTER_BITS * i)) & 31);
+    }
+    return key;
+}
+
+/* compare_words: qsort comparator putting packed words in alphabetical order */
+static int compare_words(const void *a, const void *b) {
+    uint32_t x = sort_key(*(const uint32_t *) a);
+    uint32_t y = sort_key(*(const uint32_t *) b);
+
+    return (x > y) - (x < y);
+}
+
+/*
+ * write_array:
+ *   Prints a uint32_t array definition, eight values per line.
+ *
+ * RETURNS:
+ *   0 on success, 1 on a write error.
+ */
+
+static int write_array(FILE *out, const char *name, const uint32_t *values, uint32_t count) {
+    uint32_t i;
+
+    fprintf(out, "const uint32_t %s[%u] = {\n", name, count);
+    for (i = 0; i < count; i++) {
+        fprintf(out, "%s0x%07x,%s", (i % 8 == 0) ? "    " : "", values[i],
+                (i % 8 == 7 || i + 1 == count) ? "\n" : " ");
+    }
+    fprintf(out, "};\n");
+    return ferror(out) ? 1 : 0;
+}
+
+int main(int argc, char *argv[]) {
+    const char *wordsPath = (argc > 1) ? argv[1] : dataPath(DICTIONARY_FILE);
+    const char *outPath = (argc > 2) ? argv[2] : DATA_FILE;
+    char tmpPath[4096];
+    Dictionary dict;
+    uint32_t *words, *table;
+    uint32_t size = 16;
+    FILE *out;
+    int i, failed;
+
+    if (loadDictionary(wordsPath, &dict) != 0 || dict.count == 0) {
+        fprintf(stderr, "Error: could not read word list %s\n", wordsPath);
+        return 1;
+    }
+
+    // loadDictionary already lowercased and dropped repeats; sort what is left
+    words = malloc(sizeof(uint32_t) * (size_t) dict.count);
+    while (size < (uint32_t) dict.count * 2) {
+        size = size * 2;
+    }
+    table = calloc(size, sizeof(uint32_t));
+    if (words == NULL || table == NULL) {
+        fprintf(stderr, "Error: out of memory\n");
+        return 1;
+    }
+    for (i = 0; i < dict.count; i++) {
+        words[i] = dictionaryPackedAt(&dict, i);
+    }
+    qsort(words, (size_t) dict.count, sizeof(uint32_t), compare_words);
+
+    // Same probing as dictionaryContains: linear from DICTIONARY_SLOT
+    for (i = 0; i < dict.count; i++) {
+        uint32_t slot = DICTIONARY_SLOT(words[i], size - 1);
+
+        while (table[slot] != 0) {
+            slot = (slot + 1) & (size - 1);
+        }
+        table[slot] = words[i];
+    }
+
+    snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", outPath);
+    out = fopen(tmpPath, "w");
+    if (out == NULL) {
+        fprintf(stderr, "Error: cannot write %s\n", tmpPath);
+        return 1;
+    }
+
+    fprintf(out, "/* dictionary_data.c\n *\n"
+                 " * GENERATED by tools/embed_dictionary from %s - do not edit.\n"
+                 " * The built-in word list: %d words, packed and sorted, and their\n"
+                 " * %u-slot hash table. See headerFiles/dictionary.h.\n */\n\n",
+            wordsPath, dict.count, size);
+    fprintf(out, "#include \"../headerFiles/dictionary.h\"\n\n");
+    fprintf(out, "const int embeddedWordCount = %d;\n", dict.count);
+    fprintf(out, "const uint32_t embeddedMask = %u;\n\n", size - 1);
+    failed = write_array(out, "embeddedWords", words, (uint32_t) dict.count);
+    fprintf(out, "\n");
+    failed |= write_array(out, "embeddedTable", table, size);
+
+    if (fclose(out) != 0 || failed || rename(tmpPath, outPath) != 0) {
+        fprintf(stderr, "Error: cannot write %s\n", outPath);
+        remove(tmpPath);
+        return 1;
+    }
+
+    printf("Wrote %s: %d words, %u table slots\n", outPath, dict.count, size);
+    free(words);
+    free(table);
+    freeDictionary(&dict);
+    return 0;
+}